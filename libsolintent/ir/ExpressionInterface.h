@@ -18,6 +18,7 @@
 #include <libsolidity/ast/ASTVisitor.h>
 #include <libsolidity/ast/Types.h>
 #include <libsolintent/ir/IRSummary.h>
+#include <libsolintent/util/FixedInt.h>
 #include <algorithm>
 #include <list>
 #include <optional>
@@ -89,6 +90,13 @@ public:
      */
     virtual std::optional<solidity::rational> exact() const = 0;
 
+    /**
+     * Produces the exact value of this expression as a fixed-width integer, if
+     * possible. This is nullopt if the value is unknown, fractional, or beyond
+     * the range of FixedInt. In such cases, exact() should be consulted.
+     */
+    virtual std::optional<FixedInt> exactInt() const = 0;
+
 protected:
     /**
      * Declares that this summary wraps the given expression.
@@ -32,9 +32,32 @@ TrendingNumeric::~TrendingNumeric() = default;
 
 // -------------------------------------------------------------------------- //
 
+namespace
+{
+
+/**
+ * Selects the narrowest representation for a numeric constant.
+ */
+variant<FixedInt, solidity::rational> narrow(solidity::rational _num)
+{
+    if (auto fixed = FixedInt::fromRational(_num))
+    {
+        return *fixed;
+    }
+    return move(_num);
+}
+
+}
+
 NumericConstant::NumericConstant(
     solidity::Expression const& _expr, solidity::rational _num
 )
+    : NumericSummary(_expr)
+    , m_exact(narrow(move(_num)))
+{
+}
+
+NumericConstant::NumericConstant(solidity::Expression const& _expr, FixedInt _num)
     : NumericSummary(_expr)
     , m_exact(_num)
 {
@@ -42,7 +65,20 @@ NumericConstant::NumericConstant(
 
 optional<solidity::rational> NumericConstant::exact() const
 {
-    return make_optional<solidity::rational>(m_exact);
+    if (auto const* fixed = get_if<FixedInt>(&m_exact))
+    {
+        return fixed->toRational();
+    }
+    return get<solidity::rational>(m_exact);
+}
+
+optional<FixedInt> NumericConstant::exactInt() const
+{
+    if (auto const* fixed = get_if<FixedInt>(&m_exact))
+    {
+        return *fixed;
+    }
+    return nullopt;
 }
 
 optional<set<ExpressionSummary::Source>> NumericConstant::tags() const
@@ -87,6 +123,11 @@ optional<solidity::rational> NumericVariable::exact() const
     return nullopt;
 }
 
+optional<FixedInt> NumericVariable::exactInt() const
+{
+    return nullopt;
+}
+
 optional<set<ExpressionSummary::Source>> NumericVariable::tags() const
 {
     return make_optional<set<ExpressionSummary::Source>>(symbolTags());
@@ -139,6 +180,11 @@ optional<solidity::rational> PushCall::exact() const
     return nullopt;
 }
 
+optional<FixedInt> PushCall::exactInt() const
+{
+    return nullopt;
+}
+
 optional<set<ExpressionSummary::Source>> PushCall::tags() const
 {
     // TODO
@@ -208,11 +254,13 @@ set<reference_wrapper<ExpressionSummary const>> BooleanVariable::free() const
 Comparison::Comparison(
     solidity::Expression const& _expr,
     Comparison::Condition _cond,
+    bool _strict,
     SummaryPointer<NumericSummary> _lhs,
     SummaryPointer<NumericSummary> _rhs
 )
     : BooleanSummary(_expr)
     , m_cond(_cond)
+    , m_strict(_strict)
     , m_lhs(move(_lhs))
     , m_rhs(move(_rhs))
 {
@@ -233,6 +281,11 @@ Comparison::Condition Comparison::cond() const
     return m_cond;
 }
 
+bool Comparison::strict() const
+{
+    return m_strict;
+}
+
 optional<bool> Comparison::exact() const
 {
     // TODO: if desired, some cases can be heuristically resolved.
@@ -12,6 +12,7 @@
 
 #include <libsolintent/ir/ExpressionInterface.h>
 #include <functional>
+#include <variant>
 #include <vector>
 
 namespace dev
@@ -66,7 +67,9 @@ protected:
 };
 
 /**
- * Represents a numeric constant.
+ * Represents a numeric constant. Integral constants within the range of an EVM
+ * word are stored inline as a FixedInt. Only fractional (or oversized) values
+ * fall back to a rational representation.
  */
 class NumericConstant final: public NumericSummary
 {
@@ -80,11 +83,20 @@ public:
      */
     NumericConstant(solidity::Expression const& _expr, solidity::rational _num);
 
+    /**
+     * Creates an integral numeric constant.
+     * 
+     * _expr: the expression from which _num was derived.
+     * _num: the fixed-width representation of this constant.
+     */
+    NumericConstant(solidity::Expression const& _expr, FixedInt _num);
+
     ~NumericConstant() = default;
 
     void acceptIR(IRVisitor & _visitor) const override;
 
     std::optional<solidity::rational> exact() const override;
+    std::optional<FixedInt> exactInt() const override;
     std::optional<std::set<Source>> tags() const override;
     std::set<std::reference_wrapper<ExpressionSummary const>> free(
         /* ... */
@@ -92,7 +104,7 @@ public:
 
 protected:
     // In ths context, the exact value is not optional.
-    solidity::rational const m_exact;
+    std::variant<FixedInt, solidity::rational> const m_exact;
 };
 
 /**
@@ -125,6 +137,7 @@ public:
     void acceptIR(IRVisitor & _visitor) const override;
 
     std::optional<solidity::rational> exact() const override;
+    std::optional<FixedInt> exactInt() const override;
     std::optional<std::set<Source>> tags() const override;
     std::set<std::reference_wrapper<ExpressionSummary const>> free(
         /* ... */
@@ -186,6 +199,7 @@ public:
     void acceptIR(IRVisitor & _visitor) const override;
 
     std::optional<solidity::rational> exact() const override;
+    std::optional<FixedInt> exactInt() const override;
     std::optional<std::set<Source>> tags() const override;
     std::set<std::reference_wrapper<ExpressionSummary const>> free(
         /* ... */
@@ -268,11 +282,13 @@ public:
     enum class Condition { GreaterThan, LessThan, Equal, Distinct };
 
     /**
-     * Creates a comparison between two numeric expressions.
+     * Creates a comparison between two numeric expressions. A comparison is
+     * strict if it excludes equality (ie `<`, `>` and `!=`).
      */
     Comparison(
         solidity::Expression const& _expr,
         Condition _cond,
+        bool _strict,
         SummaryPointer<NumericSummary> _lhs,
         SummaryPointer<NumericSummary> _rhs
     );
@@ -292,6 +308,11 @@ public:
      */
     Condition cond() const;
 
+    /**
+     * Returns true if equality falsifies this comparison.
+     */
+    bool strict() const;
+
     void acceptIR(IRVisitor & _visitor) const override;
 
     std::optional<bool> exact() const override;
@@ -303,6 +324,8 @@ public:
 private:
     // Abstraction of the comparison between the lhs and rhs.
     Condition const m_cond;
+    // True if the comparison excludes equality.
+    bool const m_strict;
     // The left-hand side expression, which may or may not be constant.
     SummaryPointer<NumericSummary> const m_lhs;
     // The right-hand side expression, which may or may not be constant.
@@ -57,6 +57,9 @@ class StatementSummary;
 // Statement Expressions.
 class TreeBlockSummary;
 class LoopSummary;
+class BranchSummary;
+class JumpSummary;
+class PlaceholderSummary;
 class FreshVarSummary;
 namespace detail
 {
@@ -70,6 +73,7 @@ using BooleanExprStatement = detail::ExpressionStatementSummary<BooleanSummary>;
 
 // Structural Expressions.
 class FunctionSummary;
+class ModifierSummary;
 class ContractSummary;
 
 // -------------------------------------------------------------------------- //
@@ -58,6 +58,21 @@ void LoopSummary::acceptIR(IRVisitor & _visitor) const
     _visitor.acceptIR(*this);
 }
 
+void BranchSummary::acceptIR(IRVisitor & _visitor) const
+{
+    _visitor.acceptIR(*this);
+}
+
+void JumpSummary::acceptIR(IRVisitor & _visitor) const
+{
+    _visitor.acceptIR(*this);
+}
+
+void PlaceholderSummary::acceptIR(IRVisitor & _visitor) const
+{
+    _visitor.acceptIR(*this);
+}
+
 template <>
 void NumericExprStatement::acceptIR(IRVisitor & _visitor) const
 {
@@ -47,9 +47,13 @@ public:
 
     virtual void acceptIR(ContractSummary const& _ir) = 0;
     virtual void acceptIR(FunctionSummary const& _ir) = 0;
+    virtual void acceptIR(ModifierSummary const& _ir) = 0;
 
     virtual void acceptIR(TreeBlockSummary const& _ir) = 0;
     virtual void acceptIR(LoopSummary const& _ir) = 0;
+    virtual void acceptIR(BranchSummary const& _ir) = 0;
+    virtual void acceptIR(JumpSummary const& _ir) = 0;
+    virtual void acceptIR(PlaceholderSummary const& _ir) = 0;
     virtual void acceptIR(NumericExprStatement const& _ir) = 0;
     virtual void acceptIR(BooleanExprStatement const& _ir) = 0;
     virtual void acceptIR(FreshVarSummary const& _ir) = 0;
@@ -0,0 +1,279 @@
+/**
+ * Patterns often ask how a state variable is modified, for example, "which
+ * statements grow this array?" Answering this by walking the IR of a contract
+ * costs a full traversal per query. This module indexes every write to a state
+ * variable once per contract, so that such queries are answered in time
+ * proportional to the number of writes.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * An index of the writes to each state variable of a contract.
+ */
+
+#include <libsolintent/ir/StateWriteIndex.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
+#include <set>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+namespace
+{
+
+/**
+ * Records the writes of a single function, and of the modifiers it invokes,
+ * while tracking loop nesting.
+ */
+class WriteScanner: public solidity::ASTConstVisitor
+{
+public:
+    using Site = StateWriteIndex::Site;
+    using Kind = StateWriteIndex::Kind;
+
+    /**
+     * _function: the index of the function being scanned.
+     * _sites: the map to populate, keyed by variable id.
+     */
+    WriteScanner(size_t _function, map<SummaryKey, vector<Site>> & _sites)
+        : m_function(_function), m_sites(_sites)
+    {
+    }
+
+protected:
+    bool visitNode(solidity::ASTNode const& _node) override
+    {
+        // TODO: remove cast.
+        if (auto const* STMT = dynamic_cast<solidity::Statement const*>(&_node))
+        {
+            m_statements.push_back(STMT);
+        }
+        return true;
+    }
+
+    void endVisitNode(solidity::ASTNode const& _node) override
+    {
+        if (dynamic_cast<solidity::Statement const*>(&_node))
+        {
+            m_statements.pop_back();
+        }
+    }
+
+    bool visit(solidity::ForStatement const& _node) override
+    {
+        m_loops.push_back(&_node);
+        return visitNode(_node);
+    }
+
+    void endVisit(solidity::ForStatement const& _node) override
+    {
+        m_loops.pop_back();
+        endVisitNode(_node);
+    }
+
+    bool visit(solidity::WhileStatement const& _node) override
+    {
+        m_loops.push_back(&_node);
+        return visitNode(_node);
+    }
+
+    void endVisit(solidity::WhileStatement const& _node) override
+    {
+        m_loops.pop_back();
+        endVisitNode(_node);
+    }
+
+    bool visit(solidity::Assignment const& _node) override
+    {
+        record(_node, _node.leftHandSide(), Kind::Assign);
+        return true;
+    }
+
+    bool visit(solidity::UnaryOperation const& _node) override
+    {
+        switch (_node.getOperator())
+        {
+        case solidity::Token::Inc:
+        case solidity::Token::Dec:
+            record(_node, _node.subExpression(), Kind::Increment);
+            break;
+        case solidity::Token::Delete:
+            record(_node, _node.subExpression(), Kind::Delete);
+            break;
+        default:
+            break;
+        }
+        return true;
+    }
+
+    bool visit(solidity::FunctionCall const& _node) override
+    {
+        // TODO: remove cast.
+        auto const* CALLEE = dynamic_cast<solidity::MemberAccess const*>(
+            &_node.expression()
+        );
+        if (CALLEE)
+        {
+            auto const& NAME = CALLEE->memberName();
+            if (NAME == "push")
+            {
+                record(_node, CALLEE->expression(), Kind::Push);
+            }
+            else if (NAME == "pop")
+            {
+                record(_node, CALLEE->expression(), Kind::Pop);
+            }
+        }
+        return true;
+    }
+
+private:
+    /**
+     * Resolves the variable at the root of _target, and records the write if
+     * it is a state variable. Members and elements are stripped, so writing to
+     * a.b[i] is a write to a.
+     *
+     * _expr: the expression performing the write.
+     * _target: the expression being written to.
+     * _kind: the way in which _target is written.
+     */
+    void record(
+        solidity::Expression const& _expr,
+        solidity::Expression const& _target,
+        Kind _kind
+    )
+    {
+        // TODO: remove casts.
+        using solidity::IndexAccess;
+        using solidity::MemberAccess;
+
+        // Writing to a length resizes the array which owns it.
+        solidity::Expression const* target = &_target;
+        if (_kind == Kind::Assign || _kind == Kind::Increment)
+        {
+            auto const* MEM = dynamic_cast<MemberAccess const*>(target);
+            if (MEM && MEM->memberName() == "length")
+            {
+                _kind = Kind::Length;
+                target = &MEM->expression();
+            }
+        }
+
+        solidity::Expression const* root = target;
+        while (true)
+        {
+            if (auto const* IDX = dynamic_cast<IndexAccess const*>(root))
+            {
+                root = &IDX->baseExpression();
+            }
+            else if (auto const* MEM = dynamic_cast<MemberAccess const*>(root))
+            {
+                root = &MEM->expression();
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        auto const* ID = dynamic_cast<solidity::Identifier const*>(root);
+        if (!ID) return;
+
+        auto const* DECL = dynamic_cast<solidity::VariableDeclaration const*>(
+            ID->annotation().referencedDeclaration
+        );
+        if (DECL && DECL->isStateVariable())
+        {
+            m_sites[DECL->id()].push_back(
+                { _kind, &_expr, target, m_function, m_loops, m_statements }
+            );
+        }
+    }
+
+    // The index of the function being scanned.
+    size_t const m_function;
+    // The map being populated.
+    map<SummaryKey, vector<Site>> & m_sites;
+    // The loops enclosing the current node, outermost first.
+    vector<solidity::Statement const*> m_loops;
+    // The statements enclosing the current node, outermost first.
+    vector<solidity::Statement const*> m_statements;
+};
+
+}
+
+// -------------------------------------------------------------------------- //
+
+StateWriteIndex::StateWriteIndex(solidity::ContractDefinition const& _contract)
+    : StateWriteIndex(_contract.definedFunctions())
+{
+}
+
+StateWriteIndex::StateWriteIndex(
+    vector<solidity::FunctionDefinition const*> const& _funcs
+)
+{
+    for (size_t i = 0; i < _funcs.size(); ++i)
+    {
+        WriteScanner scanner(i, m_sites);
+        _funcs[i]->accept(scanner);
+
+        // A modifier runs as part of each function which invokes it, so its
+        // writes are recorded once per invoking function. Base constructor
+        // calls are also invocations, but name a contract.
+        set<solidity::ModifierDefinition const*> scanned;
+        for (auto const& invocation : _funcs[i]->modifiers())
+        {
+            // TODO: remove cast.
+            auto const* MOD = dynamic_cast<solidity::ModifierDefinition const*>(
+                invocation->name()->annotation().referencedDeclaration
+            );
+            if (MOD && scanned.insert(MOD).second) MOD->accept(scanner);
+        }
+    }
+
+    // Sites are recorded by function index, so duplicates are adjacent.
+    for (auto const& [ID, SITES] : m_sites)
+    {
+        auto & writers = m_writers[ID];
+        for (auto const& site : SITES)
+        {
+            if (writers.empty() || writers.back() != site.function)
+            {
+                writers.push_back(site.function);
+            }
+        }
+    }
+}
+
+vector<StateWriteIndex::Site> const& StateWriteIndex::sitesOf(
+    solidity::VariableDeclaration const& _var
+) const
+{
+    static vector<Site> const NONE;
+    auto const RESULT = m_sites.find(_var.id());
+    return (RESULT == m_sites.end()) ? NONE : RESULT->second;
+}
+
+vector<size_t> const& StateWriteIndex::writersOf(
+    solidity::VariableDeclaration const& _var
+) const
+{
+    static vector<size_t> const NONE;
+    auto const RESULT = m_writers.find(_var.id());
+    return (RESULT == m_writers.end()) ? NONE : RESULT->second;
+}
+
+// -------------------------------------------------------------------------- //
+
+}
+}
@@ -0,0 +1,127 @@
+/**
+ * Patterns often ask how a state variable is modified, for example, "which
+ * statements grow this array?" Answering this by walking the IR of a contract
+ * costs a full traversal per query. This module indexes every write to a state
+ * variable once per contract, so that such queries are answered in time
+ * proportional to the number of writes.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * An index of the writes to each state variable of a contract.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/ASTForward.h>
+#include <libsolintent/ir/ForwardIR.h>
+#include <map>
+#include <vector>
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * Maps each state variable of a contract to the sites at which it is written.
+ * The index is syntactic, so it never requires a summary of any function. The
+ * writes of a modifier are indexed under each function which invokes it.
+ */
+class StateWriteIndex
+{
+public:
+    /**
+     * The ways in which a site may modify a variable.
+     */
+    enum class Kind
+    {
+        // An assignment, or compound assignment, such as a[i] = x.
+        Assign,
+        // An increment or decrement, such as n++.
+        Increment,
+        // A delete, such as delete a.
+        Delete,
+        // A call to push, such as a.push(x).
+        Push,
+        // A call to pop, such as a.pop().
+        Pop,
+        // An assignment, increment or decrement of a length, such as a.length--.
+        Length
+    };
+
+    /**
+     * A single write to a state variable.
+     */
+    struct Site
+    {
+        // The way in which the variable is modified.
+        Kind kind;
+        // The expression which performs the write.
+        solidity::Expression const* expr;
+        // The part of the variable which is written. For example, this is a[i]
+        // for a[i] = x, and is a for a.push(x).
+        solidity::Expression const* target;
+        // The index of the enclosing function, among those indexed. For a write
+        // within a modifier, this is the function which invokes the modifier.
+        size_t function;
+        // The loops enclosing the write within its function or modifier,
+        // outermost first.
+        std::vector<solidity::Statement const*> loops;
+        // The statements enclosing the write within its function or modifier,
+        // outermost first. This includes the loops, and the enclosing body.
+        std::vector<solidity::Statement const*> statements;
+    };
+
+    /**
+     * Indexes all writes within the functions defined by _contract, and within
+     * the modifiers they invoke.
+     *
+     * _contract: the contract to index.
+     */
+    explicit StateWriteIndex(solidity::ContractDefinition const& _contract);
+
+    /**
+     * Indexes all writes within _funcs, and within the modifiers they invoke.
+     * The i-th function has index i.
+     *
+     * _funcs: the functions to index, such as the locality of a contract.
+     */
+    explicit StateWriteIndex(
+        std::vector<solidity::FunctionDefinition const*> const& _funcs
+    );
+
+    /**
+     * Returns all writes to _var, ordered by function index. Within a function,
+     * the writes of its body precede those of its modifiers.
+     *
+     * _var: the state variable of interest.
+     */
+    std::vector<Site> const& sitesOf(
+        solidity::VariableDeclaration const& _var
+    ) const;
+
+    /**
+     * Returns the indices of all functions which write to _var, in ascending
+     * order, and without duplicates.
+     *
+     * _var: the state variable of interest.
+     */
+    std::vector<size_t> const& writersOf(
+        solidity::VariableDeclaration const& _var
+    ) const;
+
+private:
+    // Maps the id of each written variable to its writes.
+    std::map<SummaryKey, std::vector<Site>> m_sites;
+    // Maps the id of each written variable to the functions which write to it.
+    std::map<SummaryKey, std::vector<size_t>> m_writers;
+};
+
+// -------------------------------------------------------------------------- //
+
+}
+}
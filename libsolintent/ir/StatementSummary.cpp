@@ -40,16 +40,84 @@ SummaryPointer<StatementSummary> TreeBlockSummary::get(size_t i) const
 
 // -------------------------------------------------------------------------- //
 
+TripCount::TripCount()
+    : m_kind(Kind::Unknown)
+    , m_limit(nullptr)
+{
+}
+
+TripCount TripCount::exact(solidity::rational _count)
+{
+    TripCount trips;
+    trips.m_kind = Kind::Exact;
+    trips.m_count = move(_count);
+    return trips;
+}
+
+TripCount TripCount::bounded(
+    NumericVariable const& _limit,
+    solidity::rational _origin,
+    solidity::rational _step
+)
+{
+    TripCount trips;
+    trips.m_kind = Kind::Bounded;
+    trips.m_limit = &_limit;
+    trips.m_origin = move(_origin);
+    trips.m_step = move(_step);
+    return trips;
+}
+
+TripCount TripCount::upperBound() const
+{
+    TripCount trips(*this);
+    if (m_kind != Kind::Unknown) trips.m_kind = Kind::AtMost;
+    return trips;
+}
+
+TripCount::Kind TripCount::kind() const
+{
+    return m_kind;
+}
+
+optional<solidity::rational> const& TripCount::count() const
+{
+    return m_count;
+}
+
+NumericVariable const* TripCount::limit() const
+{
+    return m_limit;
+}
+
+solidity::rational const& TripCount::origin() const
+{
+    return m_origin;
+}
+
+solidity::rational const& TripCount::step() const
+{
+    return m_step;
+}
+
+// -------------------------------------------------------------------------- //
+
 LoopSummary::LoopSummary(
     solidity::Statement const& _stmt,
     SummaryPointer<BooleanSummary> _termination,
     SummaryPointer<TreeBlockSummary> _body,
-    vector<reference_wrapper<TrendingNumeric const>> _delta
+    SummaryPointer<StatementSummary> _init,
+    SummaryPointer<StatementSummary> _update,
+    vector<reference_wrapper<TrendingNumeric const>> _delta,
+    TripCount _trips
 )
     : StatementSummary(_stmt)
     , m_termination(_termination)
     , m_body(_body)
+    , m_init(move(_init))
+    , m_update(move(_update))
     , m_delta(move(_delta))
+    , m_trips(move(_trips))
 {
 }
 
@@ -63,6 +131,16 @@ TreeBlockSummary const& LoopSummary::body() const
     return (*m_body);
 }
 
+StatementSummary const* LoopSummary::initializer() const
+{
+    return m_init.get();
+}
+
+StatementSummary const* LoopSummary::update() const
+{
+    return m_update.get();
+}
+
 vector<reference_wrapper<TrendingNumeric const>> const& LoopSummary::deltas(
     /* ... */
 ) const
@@ -70,6 +148,61 @@ vector<reference_wrapper<TrendingNumeric const>> const& LoopSummary::deltas(
     return m_delta;
 }
 
+TripCount const& LoopSummary::tripCount() const
+{
+    return m_trips;
+}
+
+// -------------------------------------------------------------------------- //
+
+BranchSummary::BranchSummary(
+    solidity::Statement const& _stmt,
+    SummaryPointer<BooleanSummary> _cond,
+    SummaryPointer<StatementSummary> _true,
+    SummaryPointer<StatementSummary> _false
+)
+    : StatementSummary(_stmt)
+    , m_cond(move(_cond))
+    , m_true(move(_true))
+    , m_false(move(_false))
+{
+}
+
+BooleanSummary const& BranchSummary::condition() const
+{
+    return (*m_cond);
+}
+
+StatementSummary const& BranchSummary::trueBranch() const
+{
+    return (*m_true);
+}
+
+StatementSummary const* BranchSummary::falseBranch() const
+{
+    return m_false.get();
+}
+
+// -------------------------------------------------------------------------- //
+
+JumpSummary::JumpSummary(solidity::Statement const& _stmt, Kind _kind)
+    : StatementSummary(_stmt)
+    , m_kind(_kind)
+{
+}
+
+JumpSummary::Kind JumpSummary::kind() const
+{
+    return m_kind;
+}
+
+// -------------------------------------------------------------------------- //
+
+PlaceholderSummary::PlaceholderSummary(solidity::Statement const& _stmt)
+    : StatementSummary(_stmt)
+{
+}
+
 // -------------------------------------------------------------------------- //
 
 FreshVarSummary::FreshVarSummary(solidity::Statement const& _stmt)
@@ -14,6 +14,7 @@
 #include <libsolintent/ir/StatementInterface.h>
 #include <libsolintent/ir/ExpressionSummary.h>
 #include <memory>
+#include <optional>
 #include <type_traits>
 
 namespace dev
@@ -131,6 +132,94 @@ using BooleanExprStatement = detail::ExpressionStatementSummary<BooleanSummary>;
 
 // -------------------------------------------------------------------------- //
 
+/**
+ * A closed-form count of the iterations of a loop. The count may be exact, it
+ * may be bounded by an expression (ie `a.length`), or it may be unknown. If the
+ * loop may exit early, then either form is only an upper bound.
+ */
+class TripCount
+{
+public:
+    /**
+     * Describes how precisely the iterations are known. An upper bound is given
+     * by count() if it is set, and otherwise as for a bounded count.
+     */
+    enum class Kind { Exact, Bounded, AtMost, Unknown };
+
+    /**
+     * Produces an unknown trip count.
+     */
+    TripCount();
+
+    /**
+     * Produces an exact trip count.
+     *
+     * _count: the number of iterations.
+     */
+    static TripCount exact(solidity::rational _count);
+
+    /**
+     * Produces a trip count of max(0, ceil((_limit - _origin) / _step)).
+     *
+     * _limit: the variable which bounds the counter.
+     * _origin: the initial distance of the counter from _limit, after moving
+     *          all constants to the counter.
+     * _step: the positive change to the counter on each iteration.
+     */
+    static TripCount bounded(
+        NumericVariable const& _limit,
+        solidity::rational _origin,
+        solidity::rational _step
+    );
+
+    /**
+     * Returns this count as an upper bound, as for a loop which may exit early.
+     * An unknown count stays unknown.
+     */
+    TripCount upperBound() const;
+
+    /**
+     * Returns how precisely the iterations are known.
+     */
+    Kind kind() const;
+
+    /**
+     * Returns the number of iterations, if the count is exact, or the most
+     * iterations, if the count is an upper bound on a constant.
+     */
+    std::optional<solidity::rational> const& count() const;
+
+    /**
+     * Returns the bounding variable, if the count is bounded, or is an upper
+     * bound on a bounded count.
+     */
+    NumericVariable const* limit() const;
+
+    /**
+     * Returns the origin of a bounded count.
+     */
+    solidity::rational const& origin() const;
+
+    /**
+     * Returns the step of a bounded count.
+     */
+    solidity::rational const& step() const;
+
+private:
+    // How precisely the iterations are known.
+    Kind m_kind;
+    // The exact or greatest number of iterations, if known.
+    std::optional<solidity::rational> m_count;
+    // The bounding variable. It is owned by the termination condition.
+    NumericVariable const* m_limit;
+    // The origin of a bounded count.
+    solidity::rational m_origin;
+    // The step of a bounded count.
+    solidity::rational m_step;
+};
+
+// -------------------------------------------------------------------------- //
+
 /**
  * In Solidity, there are for loops and while loops. For loops are endowed with
  * an initialization statement, and a loop statement. Both loops have a
@@ -148,8 +237,11 @@ public:
         solidity::Statement const& _stmt,
         SummaryPointer<BooleanSummary> _termination,
         SummaryPointer<TreeBlockSummary> _body,
+        SummaryPointer<StatementSummary> _init,
+        SummaryPointer<StatementSummary> _update,
         // TODO: I could define a delta set which lifts the expression...
-        std::vector<std::reference_wrapper<TrendingNumeric const>> _delta
+        std::vector<std::reference_wrapper<TrendingNumeric const>> _delta,
+        TripCount _trips
     );
 
     ~LoopSummary() = default;
@@ -165,6 +257,18 @@ public:
      */
     TreeBlockSummary const& body() const;
 
+    /**
+     * Returns the statement run before the loop (ie `uint i = 0` in a for
+     * loop), or nullptr if there is no such statement.
+     */
+    StatementSummary const* initializer() const;
+
+    /**
+     * Returns the statement run after each iteration (ie `++i` in a for loop),
+     * or nullptr if there is no such statement.
+     */
+    StatementSummary const* update() const;
+
     /**
      * Reterns the trends of the condition variables in this loop.
      * TODO: take into account internal mutation... this is neither sound nor
@@ -174,12 +278,129 @@ public:
         /* ... */
     ) const;
 
+    /**
+     * Returns the number of iterations of this loop, as computed from its
+     * initializer, deltas and termination condition.
+     */
+    TripCount const& tripCount() const;
+
     void acceptIR(IRVisitor & _visitor) const override;
 
 private:
     SummaryPointer<BooleanSummary> m_termination;
     SummaryPointer<TreeBlockSummary> m_body;
+    // The statement run before the loop, if any.
+    SummaryPointer<StatementSummary> m_init;
+    // The statement run after each iteration, if any.
+    SummaryPointer<StatementSummary> m_update;
     std::vector<std::reference_wrapper<TrendingNumeric const>> m_delta;
+    // The closed-form iteration count.
+    TripCount m_trips;
+};
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * Captures a conditional branch (ie `if (c) { ... } else { ... }`). The false
+ * branch is absent if the statement has no else clause.
+ */
+class BranchSummary: public StatementSummary
+{
+public:
+    /**
+     * _stmt: the branching statement.
+     * _cond: the summary of the branch condition.
+     * _true: the statement run when _cond holds.
+     * _false: the statement run otherwise, or nullptr.
+     */
+    BranchSummary(
+        solidity::Statement const& _stmt,
+        SummaryPointer<BooleanSummary> _cond,
+        SummaryPointer<StatementSummary> _true,
+        SummaryPointer<StatementSummary> _false
+    );
+
+    ~BranchSummary() = default;
+
+    /**
+     * Returns the branch condition.
+     */
+    BooleanSummary const& condition() const;
+
+    /**
+     * Returns the statement run when the condition holds.
+     */
+    StatementSummary const& trueBranch() const;
+
+    /**
+     * Returns the statement run when the condition fails, or nullptr if there
+     * is no else clause.
+     */
+    StatementSummary const* falseBranch() const;
+
+    void acceptIR(IRVisitor & _visitor) const override;
+
+private:
+    // The branch condition.
+    SummaryPointer<BooleanSummary> m_cond;
+    // The statement run when the condition holds.
+    SummaryPointer<StatementSummary> m_true;
+    // The statement run otherwise, if any.
+    SummaryPointer<StatementSummary> m_false;
+};
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * Captures an unconditional transfer of control out of the current block.
+ */
+class JumpSummary: public StatementSummary
+{
+public:
+    /**
+     * Describes where control is transferred to.
+     */
+    enum class Kind { Break, Continue, Return };
+
+    /**
+     * _stmt: the jumping statement.
+     * _kind: where control is transferred to.
+     */
+    JumpSummary(solidity::Statement const& _stmt, Kind _kind);
+
+    ~JumpSummary() = default;
+
+    /**
+     * Returns where control is transferred to.
+     */
+    Kind kind() const;
+
+    void acceptIR(IRVisitor & _visitor) const override;
+
+private:
+    // Where control is transferred to.
+    Kind const m_kind;
+};
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * Marks the point at which a modifier runs the function it modifies. The
+ * placeholder does not hold the body of the function. Instead, each function
+ * refers to the modifiers it invokes, so that a modifier is summarized once and
+ * shared by all of them.
+ */
+class PlaceholderSummary: public StatementSummary
+{
+public:
+    /**
+     * _stmt: the placeholder statement.
+     */
+    explicit PlaceholderSummary(solidity::Statement const& _stmt);
+
+    ~PlaceholderSummary() = default;
+
+    void acceptIR(IRVisitor & _visitor) const override;
 };
 
 // -------------------------------------------------------------------------- //
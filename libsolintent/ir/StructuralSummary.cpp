@@ -0,0 +1,112 @@
+/**
+ * Contract and function summaries have a very shallow hierarchy. This file
+ * defines both such types.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Summaries of contracts and functions.
+ */
+
+#include <libsolintent/ir/StructuralSummary.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/Types.h>
+#include <set>
+#include <string>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+string ContractSummary::overrideKeyOf(solidity::FunctionDefinition const& _func)
+{
+    // The receive and fallback functions are both unnamed.
+    string key = (_func.isReceive() ? "receive:" : "") + _func.name() + "(";
+    for (auto const& param : _func.parameters())
+    {
+        key += param->type()->richIdentifier() + ",";
+    }
+    return key + ")";
+}
+
+vector<solidity::FunctionDefinition const*> ContractSummary::localityOf(
+    solidity::ContractDefinition const& _contract
+)
+{
+    // The linearization starts with _contract, and ends with its least derived
+    // base, so the first function seen with a given key is never overridden.
+    vector<solidity::FunctionDefinition const*> funcs;
+    set<string> seen;
+    for (auto const* BASE : _contract.annotation().linearizedBaseContracts)
+    {
+        for (auto const* FUNC : BASE->definedFunctions())
+        {
+            // Constructors are never overridden, and are unnamed, so they are
+            // kept apart from the keys of the fallback function.
+            if (FUNC->isConstructor())
+            {
+                funcs.push_back(FUNC);
+            }
+            else if (seen.insert(overrideKeyOf(*FUNC)).second)
+            {
+                funcs.push_back(FUNC);
+            }
+        }
+    }
+    return funcs;
+}
+
+ContractSummary::ContractSummary(
+    solidity::ContractDefinition const& _contract, FunctionLoader _loader
+)
+    : IRSummary(_contract)
+    , m_funcs(localityOf(_contract))
+    , m_loader(move(_loader))
+    , m_slots(make_unique<Slot[]>(m_funcs.size()))
+{
+}
+
+size_t ContractSummary::summaryLength() const
+{
+    return m_funcs.size();
+}
+
+vector<solidity::FunctionDefinition const*> const&
+    ContractSummary::locality() const
+{
+    return m_funcs;
+}
+
+FunctionSummary const& ContractSummary::get(size_t _i) const
+{
+    auto & slot = m_slots[_i];
+    call_once(slot.once, [&] { slot.summary = m_loader(*m_funcs[_i]); });
+    return (*slot.summary);
+}
+
+vector<size_t> const& ContractSummary::writersOf(
+    solidity::VariableDeclaration const& _var
+) const
+{
+    return writes().writersOf(_var);
+}
+
+StateWriteIndex const& ContractSummary::writes() const
+{
+    call_once(m_writes_once, [this] {
+        m_writes = make_unique<StateWriteIndex>(m_funcs);
+    });
+    return (*m_writes);
+}
+
+// -------------------------------------------------------------------------- //
+
+}
+}
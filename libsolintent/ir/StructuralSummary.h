@@ -6,11 +6,22 @@
  *       They merely allow a Contract -> Func -> Body resolution.
  */
 
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Summaries of contracts and functions.
+ */
+
 #pragma once
 
 #include <libsolidity/ast/ASTForward.h>
 #include <libsolintent/ir/ForwardIR.h>
 #include <libsolintent/ir/IRSummary.h>
+#include <libsolintent/ir/StateWriteIndex.h>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <vector>
 
 namespace dev
@@ -19,42 +30,159 @@ namespace solintent
 {
 
 /**
- * TODO
+ * Summarizes a contract as the summaries of its functions. A suspect often
+ * depends on only a few functions, so function summaries are materialized on
+ * first access, rather than up front. The summary may be read by many threads
+ * at once, so materialization is synchronized.
+ *
+ * The functions of a contract include those it inherits. These are resolved
+ * against the linearized bases of the contract, such that each function which
+ * is overridden by a more derived contract is excluded.
  */
 class ContractSummary: public IRSummary
 {
 public:
-    // TODO
+    /**
+     * Produces the summary of a single function, on demand.
+     */
+    using FunctionLoader = std::function<
+        SummaryPointer<FunctionSummary>(solidity::FunctionDefinition const&)
+    >;
+
+    /**
+     * _contract: the contract to summarize.
+     * _loader: summarizes each function. It must be safe to call from any
+     *          thread, and must outlive all calls to get.
+     */
     ContractSummary(
-        solidity::ContractDefinition const& _contract,
-        std::vector<SummaryPointer<FunctionSummary>> _funcs
-    )
-        : IRSummary(_contract)
-        , m_funcs(std::move(_funcs))
-    {
-    }
-    
-    // TODO
+        solidity::ContractDefinition const& _contract, FunctionLoader _loader
+    );
+
     void acceptIR(IRVisitor & _visitor) const override
     {
         _visitor.acceptIR(*this);
     }
 
-    // TODO
-    size_t summaryLength() const
+    /**
+     * Returns the functions of _contract, starting with those it defines, in
+     * definition order. These are followed by the functions it inherits, from
+     * the most derived base to the least derived base. A function is inherited
+     * unless a more derived contract defines a function of the same name and
+     * parameter types. Constructors are never overridden.
+     *
+     * _contract: the contract of interest.
+     */
+    static std::vector<solidity::FunctionDefinition const*> localityOf(
+        solidity::ContractDefinition const& _contract
+    );
+
+    /**
+     * Returns a key which is shared by _func and every function it overrides.
+     * Constructors are unnamed, so their keys are not meaningful.
+     *
+     * _func: the function of interest.
+     */
+    static std::string overrideKeyOf(solidity::FunctionDefinition const& _func);
+
+    /**
+     * Returns the number of functions of this contract, including those it
+     * inherits. This does not materialize any function summaries.
+     */
+    size_t summaryLength() const;
+
+    /**
+     * Returns the functions of this contract, in the order given by localityOf.
+     * This does not materialize any function summaries.
+     */
+    std::vector<solidity::FunctionDefinition const*> const& locality() const;
+
+    /**
+     * Returns the summary of the i-th function, materializing it if this is
+     * the first access.
+     *
+     * _i: the index of the function, in the order given by localityOf.
+     */
+    FunctionSummary const& get(size_t _i) const;
+
+    /**
+     * Returns the indices of all functions which may write to _var, in
+     * ascending order. A function writes to _var if it assigns to, deletes,
+     * increments, pushes to, or pops from _var, or from any member or element
+     * of _var. This does not materialize any function summaries.
+     *
+     * _var: the state variable of interest.
+     */
+    std::vector<size_t> const& writersOf(
+        solidity::VariableDeclaration const& _var
+    ) const;
+
+    /**
+     * Returns the index of all writes to the state variables of this contract.
+     * The index is built on first access. This does not materialize any
+     * function summaries.
+     */
+    StateWriteIndex const& writes() const;
+
+private:
+    /**
+     * The lazily computed summary of a single function.
+     */
+    struct Slot
+    {
+        std::once_flag once;
+        SummaryPointer<FunctionSummary> summary;
+    };
+
+    // The functions of the contract, in the order given by localityOf.
+    std::vector<solidity::FunctionDefinition const*> m_funcs;
+    // Summarizes functions on demand.
+    FunctionLoader m_loader;
+    // One slot per function in m_funcs.
+    std::unique_ptr<Slot[]> m_slots;
+
+    // Guards the first computation of m_writes.
+    mutable std::once_flag m_writes_once;
+    // The writes to each state variable, once computed.
+    mutable std::unique_ptr<StateWriteIndex> m_writes;
+};
+
+/**
+ * Summarizes a modifier definition. A modifier is summarized once, and is then
+ * shared by every function which invokes it. Each PlaceholderSummary within
+ * the body marks the point at which the modified function resumes.
+ */
+class ModifierSummary: public IRSummary
+{
+public:
+    /**
+     * _modifier: the modifier being summarized.
+     * _body: the summary of the modifier body.
+     */
+    ModifierSummary(
+        solidity::ModifierDefinition const& _modifier,
+        SummaryPointer<StatementSummary const> _body
+    )
+        : IRSummary(_modifier)
+        , m_body(std::move(_body))
     {
-        return m_funcs.size();
     }
 
-    // TODO
-    FunctionSummary const& get(size_t i) const
+    void acceptIR(IRVisitor & _visitor) const override
     {
-        return (*m_funcs[i]);
+        _visitor.acceptIR(*this);
+    }
+
+    /**
+     * Returns the summary of the modifier body.
+     */
+    StatementSummary const& body() const
+    {
+        return (*m_body);
     }
 
 private:
-    // TODO: temporary
-    std::vector<SummaryPointer<FunctionSummary>> m_funcs;
+    // The summary of the modifier body.
+    SummaryPointer<StatementSummary const> m_body;
 };
 
 /**
@@ -66,10 +194,12 @@ public:
     // TODO
     FunctionSummary(
         solidity::FunctionDefinition const& _contract,
-        SummaryPointer<StatementSummary const> _body
+        SummaryPointer<StatementSummary const> _body,
+        std::vector<SummaryPointer<ModifierSummary const>> _modifiers
     )
         : IRSummary(_contract)
         , m_body(std::move(_body))
+        , m_modifiers(std::move(_modifiers))
     {
     }
     
@@ -85,9 +215,22 @@ public:
         return (*m_body);
     }
 
+    /**
+     * Returns the modifiers invoked by the function, outermost first. The body
+     * of the function runs at the placeholder of the innermost modifier, and
+     * each other modifier resumes at the placeholder of the modifier before it.
+     */
+    std::vector<SummaryPointer<ModifierSummary const>> const& modifiers() const
+    {
+        return m_modifiers;
+    }
+
 private:
     // TODO: temporary
     SummaryPointer<StatementSummary const> m_body;
+    // The modifiers invoked by the function, outermost first. These are shared
+    // with all other functions which invoke the same modifiers.
+    std::vector<SummaryPointer<ModifierSummary const>> m_modifiers;
 };
 
 }
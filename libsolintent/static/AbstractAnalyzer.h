@@ -78,6 +78,20 @@ protected:
         m_cache[std::move(ID)] = std::move(_summary);
     }
 
+    /**
+     * Allows an analyzer to reuse an existing summary as the result for _node.
+     * The summary need not wrap _node, so its id may differ from _node's id.
+     * 
+     * _node: the node whose result is being recorded.
+     * _summary: the shared summary to record.
+     */
+    void alias_in_cache(
+        solidity::ASTNode const& _node, SummaryPointer<SummaryType> _summary
+    )
+    {
+        m_cache[_node.id()] = std::move(_summary);
+    }
+
 private:
     // A cache which is computed on-the-fly for bound estimations.
     std::map<SummaryKey, SummaryPointer<SummaryType>> m_cache;
@@ -6,6 +6,8 @@
 
 #include <libsolintent/static/AbstractExpressionAnalyzer.h>
 
+#include <libsolintent/static/ConstantTable.h>
+#include <libsolintent/static/ExpressionTable.h>
 #include <stdexcept>
 
 using namespace std;
@@ -57,5 +59,41 @@ detail::NumericAnalyzer & NumericAnalysisClient::getNumericAnalyzer()
 
 // -------------------------------------------------------------------------- //
 
+ConstantTableClient::~ConstantTableClient() = default;
+
+void ConstantTableClient::setConstantTable(shared_ptr<ConstantTable> _table)
+{
+    m_constant_table = move(_table);
+}
+
+ConstantTable & ConstantTableClient::getConstantTable()
+{
+    if (!m_constant_table)
+    {
+        m_constant_table = make_shared<ConstantTable>();
+    }
+    return (*m_constant_table);
+}
+
+// -------------------------------------------------------------------------- //
+
+ExpressionTableClient::~ExpressionTableClient() = default;
+
+void ExpressionTableClient::setExpressionTable(shared_ptr<ExpressionTable> _table)
+{
+    m_expression_table = move(_table);
+}
+
+ExpressionTable & ExpressionTableClient::getExpressionTable()
+{
+    if (!m_expression_table)
+    {
+        m_expression_table = make_shared<ExpressionTable>();
+    }
+    return (*m_expression_table);
+}
+
+// -------------------------------------------------------------------------- //
+
 }
 }
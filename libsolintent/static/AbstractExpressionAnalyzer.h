@@ -21,6 +21,16 @@ namespace solintent
 
 // -------------------------------------------------------------------------- //
 
+/**
+ * Raised by an analyzer when an expression falls outside of its model. Any
+ * other error raised by an analyzer indicates a bug.
+ */
+class UnsupportedExpression: public std::runtime_error
+{
+public:
+    using std::runtime_error::runtime_error;
+};
+
 /**
  * An extension of the AbstractAnalyzer with type-checking, restricted IRSummary
  * types, and the ability to interop ExpressionSummary analyses in a mutually
@@ -154,12 +164,76 @@ private:
 
 // -------------------------------------------------------------------------- //
 
+// Forward declaration.
+class ConstantTable;
+
+/**
+ * Defines an interface for classes which depend on the ConstantTable.
+ */
+class ConstantTableClient
+{
+public:
+    virtual ~ConstantTableClient() = 0;
+
+    /**
+     * Allows several analyzers to share a single table of folded constants.
+     * 
+     * _table: the ConstantTable used to resolve constant declarations.
+     */
+    void setConstantTable(std::shared_ptr<ConstantTable> _table);
+
+protected:
+    /**
+     * Returns the current ConstantTable. If a table has not been set, then a
+     * private table is created.
+     */
+    ConstantTable & getConstantTable();
+
+private:
+    std::shared_ptr<ConstantTable> m_constant_table;
+};
+
+// -------------------------------------------------------------------------- //
+
+// Forward declaration.
+class ExpressionTable;
+
+/**
+ * Defines an interface for classes which depend on the ExpressionTable.
+ */
+class ExpressionTableClient
+{
+public:
+    virtual ~ExpressionTableClient() = 0;
+
+    /**
+     * Allows several analyzers to share a single table of canonical summaries.
+     * 
+     * _table: the ExpressionTable used to hash-cons summaries.
+     */
+    void setExpressionTable(std::shared_ptr<ExpressionTable> _table);
+
+protected:
+    /**
+     * Returns the current ExpressionTable. If a table has not been set, then a
+     * private table is created.
+     */
+    ExpressionTable & getExpressionTable();
+
+private:
+    std::shared_ptr<ExpressionTable> m_expression_table;
+};
+
+// -------------------------------------------------------------------------- //
+
 /**
  * Speicalizes the AbstractAnalyzer for any numeric case.
  */
 class NumericAnalyzer
     : public detail::NumericAnalyzer
     , public BooleanAnalysisClient
+    , public ConstantTableClient
+    , public ExpressionTableClient
 {
 public:
     ~NumericAnalyzer() = default;
@@ -173,6 +247,8 @@ public:
 class BooleanAnalyzer
     : public detail::BooleanAnalyzer
     , public NumericAnalysisClient
+    , public ConstantTableClient
+    , public ExpressionTableClient
 {
 public:
     virtual ~BooleanAnalyzer() = default;
@@ -16,8 +16,11 @@
 
 #include <libsolintent/static/AbstractExpressionAnalyzer.h>
 #include <libsolintent/static/AbstractStatementAnalyzer.h>
+#include <libsolintent/static/ConstantTable.h>
+#include <libsolintent/static/ExpressionTable.h>
 #include <memory>
 #include <type_traits>
+#include <vector>
 
 namespace dev
 {
@@ -73,6 +76,16 @@ public:
     virtual SummaryPointer<BooleanSummary> checkBoolean(
         solidity::Expression const& _expr
     ) = 0;
+
+    /**
+     * Folds all constant declarations within the given source units. The
+     * resulting table is shared by the numeric and boolean analyzers.
+     *
+     * _units: the source units to scan for constants.
+     */
+    virtual ConstantTable const& foldConstants(
+        std::vector<solidity::SourceUnit const*> const& _units
+    ) = 0;
 };
 
 template <
@@ -111,6 +124,8 @@ public:
         , m_numeric_engine(std::make_shared<NAnalyzer>())
         , m_boolean_engine(std::make_shared<BAnalyzer>())
         , m_statement_engine(std::make_shared<SAnalyzer>())
+        , m_constants(std::make_shared<ConstantTable>())
+        , m_expressions(std::make_shared<ExpressionTable>())
     {
         m_contract_engine->setFunctionAnalyzer(m_function_engine);
         m_contract_engine->setStatementAnalyzer(m_statement_engine);
@@ -126,6 +141,12 @@ public:
 
         m_numeric_engine->setBooleanAnalyzer(m_boolean_engine);
         m_boolean_engine->setNumericAnalyzer(m_numeric_engine);
+
+        m_numeric_engine->setConstantTable(m_constants);
+        m_boolean_engine->setConstantTable(m_constants);
+
+        m_numeric_engine->setExpressionTable(m_expressions);
+        m_boolean_engine->setExpressionTable(m_expressions);
     }
 
     SummaryPointer<ContractSummary> checkContract(
@@ -163,12 +184,22 @@ public:
         return m_boolean_engine->check(_expr);
     }
 
+    ConstantTable const& foldConstants(
+        std::vector<solidity::SourceUnit const*> const& _units
+    ) override
+    {
+        m_constants->populate(_units, *m_numeric_engine, *m_boolean_engine);
+        return (*m_constants);
+    }
+
 private:
     std::shared_ptr<CAnalyzer> m_contract_engine;
     std::shared_ptr<FAnalyzer> m_function_engine;
     std::shared_ptr<SAnalyzer> m_statement_engine;
     std::shared_ptr<NAnalyzer> m_numeric_engine;
     std::shared_ptr<BAnalyzer> m_boolean_engine;
+    std::shared_ptr<ConstantTable> m_constants;
+    std::shared_ptr<ExpressionTable> m_expressions;
 };
 
 }
@@ -14,6 +14,8 @@
 
 #include <libsolidity/ast/AST.h>
 #include <libsolintent/ir/ExpressionSummary.h>
+#include <libsolintent/static/ConstantTable.h>
+#include <libsolintent/static/ExpressionTable.h>
 #include <libsolintent/util/SourceLocation.h>
 #include <memory>
 #include <stdexcept>
@@ -28,28 +30,119 @@ namespace solintent
 
 // -------------------------------------------------------------------------- //
 
+namespace
+{
+
+/**
+ * Computes _base ** _exp by repeated squaring. If the result leaves the range
+ * of FixedInt, or the exponent is negative, then nullopt is returned.
+ */
+optional<FixedInt> power(FixedInt _base, FixedInt const& _exp)
+{
+    auto exp = _exp.toInt64();
+    if (!exp.has_value() || (*exp) < 0) return nullopt;
+
+    optional<FixedInt> res = FixedInt(1);
+    for (int64_t bits = (*exp); bits > 0; bits >>= 1)
+    {
+        if (bits & 1)
+        {
+            res = res->mul(_base);
+            if (!res.has_value()) return nullopt;
+        }
+        if (bits > 1)
+        {
+            auto next = _base.mul(_base);
+            if (!next.has_value()) return nullopt;
+            _base = *next;
+        }
+    }
+    return res;
+}
+
+/**
+ * Computes _base ** _exp over the rationals. The exponent must be a
+ * non-negative integer, and as in solc, the result may not exceed 4096 bits.
+ * Otherwise, nullopt is returned.
+ */
+optional<solidity::rational> power(
+    solidity::rational const& _base, solidity::rational const& _exp
+)
+{
+    size_t const MAX_BITS = 4096;
+
+    if (_exp.denominator() != 1 || _exp.numerator() < 0) return nullopt;
+    if (_exp.numerator() == 0) return solidity::rational(1);
+
+    bigint const NUM = abs(_base.numerator());
+    bigint const DEN = _base.denominator();
+    if (NUM == 0 || (NUM == 1 && DEN == 1))
+    {
+        // Only the sign of +/-1 depends on the exponent.
+        bool const ODD = ((_exp.numerator() % 2) != 0);
+        return (ODD ? _base : abs(_base));
+    }
+
+    // The result needs at least exp * log2(max(num, den)) bits.
+    size_t const BITS = boost::multiprecision::msb(max(NUM, DEN)) + 1;
+    if (_exp.numerator() > MAX_BITS / BITS) return nullopt;
+
+    auto const EXP = _exp.numerator().convert_to<unsigned>();
+    return solidity::rational(
+        boost::multiprecision::pow(_base.numerator(), EXP),
+        boost::multiprecision::pow(DEN, EXP)
+    );
+}
+
+/**
+ * Reduces _val into the range of _type. Typed arithmetic wraps on overflow and
+ * underflow, so the result is _val modulo 2^N, where N is the width of _type.
+ */
+solidity::rational wrap(
+    solidity::rational const& _val, solidity::IntegerType const& _type
+)
+{
+    bigint const MODULUS = bigint(1) << _type.numBits();
+    bigint val = _val.numerator() % MODULUS;
+    if (val < 0) val += MODULUS;
+    if (val > _type.maxValue()) val -= MODULUS;
+    return solidity::rational(val);
+}
+
+}
+
+// -------------------------------------------------------------------------- //
+
 bool BoundChecker::visit(solidity::ParameterList const& _node)
 {
-    (void) _node;
-    throw;
+    string const SRC = srclocToStr(_node.location());
+    throw UnsupportedExpression("Unsupported numeric expression: " + SRC);
 }
 
 bool BoundChecker::visit(solidity::InlineAssembly const& _node)
 {
-    (void) _node;
-    throw;
+    string const SRC = srclocToStr(_node.location());
+    throw UnsupportedExpression("Unsupported numeric expression: " + SRC);
 }
 
 bool BoundChecker::visit(solidity::Conditional const& _node)
 {
-    (void) _node;
-    throw;
+    string const SRC = srclocToStr(_node.location());
+    throw UnsupportedExpression("Unsupported numeric expression: " + SRC);
 }
 
 bool BoundChecker::visit(solidity::TupleExpression const& _node)
 {
-    (void) _node;
-    throw;
+    // Parenthesized expressions are transparent.
+    auto const& COMPONENTS = _node.components();
+    if (_node.isInlineArray() || COMPONENTS.size() != 1 || !COMPONENTS[0])
+    {
+        string const SRC = srclocToStr(_node.location());
+        throw UnsupportedExpression("Unsupported numeric expression: " + SRC);
+    }
+
+    alias_in_cache(_node, check(*COMPONENTS[0]));
+    return false;
 }
 
 bool BoundChecker::visit(solidity::UnaryOperation const& _node)
@@ -63,7 +156,10 @@ bool BoundChecker::visit(solidity::UnaryOperation const& _node)
     switch (_node.getOperator())
     {
     case solidity::Token::BitNot:
-        throw runtime_error("Binary negation is not captured by this model.");
+    {
+        auto const ERR = "Binary negation is not captured by this model.";
+        throw UnsupportedExpression(ERR);
+    }
     case solidity::Token::Inc:
         result = dynamic_pointer_cast<TrendingNumeric const>(
             child
@@ -74,18 +170,174 @@ bool BoundChecker::visit(solidity::UnaryOperation const& _node)
             child
         )->decrement(_node);
         break;
+    case solidity::Token::Sub:
+        if (auto fixed = child->exactInt())
+        {
+            result = make_shared<NumericConstant>(_node, fixed->negate());
+        }
+        else if (auto rat = child->exact())
+        {
+            result = make_shared<NumericConstant>(_node, -(*rat));
+        }
+        else
+        {
+            auto const ERR = "Negation is only captured for constants.";
+            throw UnsupportedExpression(ERR);
+        }
+        break;
     default:
         throw runtime_error("Unexpected unary numeric operation: " + TOKSTR);
     }
 
-    write_to_cache(move(result));
+    alias_in_cache(_node, getExpressionTable().intern(move(result)));
     return false;
 }
 
 bool BoundChecker::visit(solidity::BinaryOperation const& _node)
 {
-    (void) _node;
-    throw;
+    auto const OP = _node.getOperator();
+    string const TOKSTR = solidity::TokenTraits::friendlyName(OP);
+
+    auto lhs = check(_node.leftExpression());
+    auto rhs = check(_node.rightExpression());
+
+    // Solidity evaluates literal expressions over the rationals, whereas typed
+    // expressions truncate on division.
+    auto const CATEGORY = _node.annotation().type->category();
+    bool const IS_LITERAL = (CATEGORY == solidity::Type::Category::RationalNumber);
+
+    // TODO: remove cast.
+    auto const* INT_TYPE = dynamic_cast<solidity::IntegerType const*>(
+        _node.annotation().type
+    );
+
+    // Most constants are integral, and may be folded without allocation.
+    auto const LHS_INT = lhs->exactInt();
+    auto const RHS_INT = rhs->exactInt();
+    if (LHS_INT.has_value() && RHS_INT.has_value())
+    {
+        optional<FixedInt> res;
+        switch (OP)
+        {
+        case solidity::Token::Add:
+            res = LHS_INT->add(*RHS_INT);
+            break;
+        case solidity::Token::Sub:
+            res = LHS_INT->sub(*RHS_INT);
+            break;
+        case solidity::Token::Mul:
+            res = LHS_INT->mul(*RHS_INT);
+            break;
+        case solidity::Token::Div:
+            // An inexact literal division is fractional.
+            if (!IS_LITERAL || (LHS_INT->mod(*RHS_INT) == FixedInt()))
+            {
+                res = LHS_INT->div(*RHS_INT);
+            }
+            break;
+        case solidity::Token::Mod:
+            res = LHS_INT->mod(*RHS_INT);
+            break;
+        case solidity::Token::Exp:
+            res = power(*LHS_INT, *RHS_INT);
+            break;
+        default:
+            throw runtime_error("Unexpected binary numeric operation: " + TOKSTR);
+        }
+
+        // A uint256 leaves its range only by going negative, so the common case
+        // skips the round trip through the rationals.
+        if (res.has_value() && INT_TYPE)
+        {
+            bool const SIGNED = INT_TYPE->isSigned();
+            bool const WIDE = (!SIGNED && INT_TYPE->numBits() == 256);
+            if (!WIDE || res->isNegative())
+            {
+                auto const VAL = res->toRational();
+                auto const WRAPPED = wrap(VAL, *INT_TYPE);
+                if (WRAPPED != VAL) res = FixedInt::fromRational(WRAPPED);
+            }
+        }
+
+        if (res.has_value())
+        {
+            auto summary = make_shared<NumericConstant>(_node, *res);
+            alias_in_cache(_node, getExpressionTable().intern(move(summary)));
+            return false;
+        }
+    }
+
+    // Otherwise, falls back to rational arithmetic.
+    auto const LHS_RAT = lhs->exact();
+    auto const RHS_RAT = rhs->exact();
+    if (!LHS_RAT.has_value() || !RHS_RAT.has_value())
+    {
+        auto const ERR = "Binary operations only captured for constants.";
+        throw UnsupportedExpression(ERR);
+    }
+
+    solidity::rational res;
+    switch (OP)
+    {
+    case solidity::Token::Add:
+        res = (*LHS_RAT) + (*RHS_RAT);
+        break;
+    case solidity::Token::Sub:
+        res = (*LHS_RAT) - (*RHS_RAT);
+        break;
+    case solidity::Token::Mul:
+        res = (*LHS_RAT) * (*RHS_RAT);
+        break;
+    case solidity::Token::Div:
+        if (RHS_RAT->numerator() == 0)
+        {
+            string const SRC = srclocToStr(_node.location());
+            throw UnsupportedExpression("Division by zero: " + SRC);
+        }
+        res = (*LHS_RAT) / (*RHS_RAT);
+        if (!IS_LITERAL)
+        {
+            res = solidity::rational(res.numerator() / res.denominator());
+        }
+        break;
+    case solidity::Token::Mod:
+        if (RHS_RAT->numerator() == 0)
+        {
+            string const SRC = srclocToStr(_node.location());
+            throw UnsupportedExpression("Modulo by zero: " + SRC);
+        }
+        else if (LHS_RAT->denominator() != 1 || RHS_RAT->denominator() != 1)
+        {
+            auto const ERR = "Fractional remainders are not captured.";
+            throw UnsupportedExpression(ERR);
+        }
+        // The remainder takes the sign of the dividend, as in Solidity.
+        res = solidity::rational(LHS_RAT->numerator() % RHS_RAT->numerator());
+        break;
+    case solidity::Token::Exp:
+    {
+        auto const POW = power(*LHS_RAT, *RHS_RAT);
+        if (!POW.has_value())
+        {
+            string const SRC = srclocToStr(_node.location());
+            throw UnsupportedExpression("Exponent not captured: " + SRC);
+        }
+        res = *POW;
+        break;
+    }
+    default:
+        auto const ERR = "Operation not captured over rationals: " + TOKSTR;
+        throw UnsupportedExpression(ERR);
+    }
+
+    if (INT_TYPE)
+    {
+        res = wrap(res, *INT_TYPE);
+    }
+
+    auto summary = make_shared<NumericConstant>(_node, move(res));
+    alias_in_cache(_node, getExpressionTable().intern(move(summary)));
+    return false;
 }
 
 bool BoundChecker::visit(solidity::FunctionCall const& _node)
@@ -95,64 +347,56 @@ bool BoundChecker::visit(solidity::FunctionCall const& _node)
         _node.expression().annotation().type
     );
 
-    if (ftype->kind() == solidity::FunctionType::Kind::ArrayPush)
+    if (ftype && ftype->kind() == solidity::FunctionType::Kind::ArrayPush)
     {
         write_to_cache(make_shared<PushCall>(_node));
         return false;
     }
     else
     {
-        throw;
+        string const SRC = srclocToStr(_node.location());
+        throw UnsupportedExpression("Unsupported numeric call: " + SRC);
     }
 }
 
 bool BoundChecker::visit(solidity::MemberAccess const& _node)
 {
-    write_to_cache(make_shared<NumericVariable>(_node));
+    auto summary = make_shared<NumericVariable>(_node);
+    alias_in_cache(_node, getExpressionTable().intern(move(summary)));
     return false;
 }
 
 bool BoundChecker::visit(solidity::IndexAccess const& _node)
 {
-    (void) _node;
-    throw;
+    string const SRC = srclocToStr(_node.location());
+    throw UnsupportedExpression("Unsupported numeric expression: " + SRC);
 }
 
 bool BoundChecker::visit(solidity::IndexRangeAccess const& _node)
 {
-    (void) _node;
-    throw;
+    string const SRC = srclocToStr(_node.location());
+    throw UnsupportedExpression("Unsupported numeric expression: " + SRC);
 }
 
 bool BoundChecker::visit(solidity::Identifier const& _node)
 {
-    // TODO: code duplication
-    SummaryPointer<NumericSummary> summary;
-
-    // Checks if this expression has a constant value.
+    // Constants are folded once, and then shared by all uses.
     auto const* REF = _node.annotation().referencedDeclaration;
     if (auto DECL = dynamic_cast<solidity::VariableDeclaration const*>(REF))
     {
         if (DECL->isConstant())
         {
-            auto tmp = check(*DECL->value());
-            if (!tmp->exact().has_value())
+            if (auto folded = getConstantTable().numeric(*DECL, *this))
             {
-                string const SRC = srclocToStr(DECL->location());
-                throw runtime_error("Expected constant, found: " + SRC); 
+                alias_in_cache(_node, move(folded));
+                return false;
             }
-            summary = make_shared<NumericConstant>(_node, *tmp->exact());
         }
-   }
-
-    // It is not reducible to a constant
-    if (!summary)
-    {
-        summary = make_shared<NumericVariable>(_node);
     }
 
-    // Records entry.
-    write_to_cache(move(summary));
+    // It is not reducible to a constant.
+    auto summary = make_shared<NumericVariable>(_node);
+    alias_in_cache(_node, getExpressionTable().intern(move(summary)));
     return false;
 }
 
@@ -164,10 +408,12 @@ bool BoundChecker::visit(solidity::Literal const& _node)
     std::tie(valid, val) = solidity::RationalNumberType::isValidLiteral(_node);
     if (!valid)
     {
-        throw runtime_error("Numeric literal is not convertible to rational.");
+        auto const ERR = "Numeric literal is not convertible to rational.";
+        throw UnsupportedExpression(ERR);
     }
 
-    write_to_cache(make_shared<NumericConstant>(_node, val));
+    auto summary = make_shared<NumericConstant>(_node, val);
+    alias_in_cache(_node, getExpressionTable().intern(move(summary)));
     return false;
 }
 
@@ -0,0 +1,333 @@
+/**
+ * A loop which calls a helper function can only be understood through the
+ * helper. Summarizing each callee again at every call site is exponential in
+ * the depth of the call chain, so callees should instead be summarized once,
+ * before their callers. This module builds the graph of internal calls, and
+ * orders its strongly connected components from the leaves upwards.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Call graphs over the functions and modifiers of a contract.
+ */
+
+#include <libsolintent/static/CallGraph.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
+#include <libsolintent/ir/StructuralSummary.h>
+#include <libsolintent/util/WorkStealingPool.h>
+#include <algorithm>
+#include <utility>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+namespace
+{
+
+/**
+ * Collects the internal functions called, and modifiers invoked, by a callable.
+ */
+class CallScanner: public solidity::ASTConstVisitor
+{
+public:
+    /**
+     * _callees: the list to extend with each callee, in visitation order.
+     * _dispatch: the functions run by the contract.
+     */
+    CallScanner(
+        vector<solidity::CallableDeclaration const*> & _callees,
+        CallGraph::Dispatch const& _dispatch
+    )
+        : m_callees(_callees), m_dispatch(_dispatch)
+    {
+    }
+
+protected:
+    void endVisit(solidity::FunctionCall const& _node) override
+    {
+        if (auto const* FUNC = CallGraph::calleeOf(_node, m_dispatch))
+        {
+            m_callees.push_back(FUNC);
+        }
+    }
+
+    void endVisit(solidity::ModifierInvocation const& _node) override
+    {
+        // Base constructor calls are also invocations, but name a contract.
+        // TODO: remove cast.
+        auto const* MOD = dynamic_cast<solidity::ModifierDefinition const*>(
+            _node.name()->annotation().referencedDeclaration
+        );
+        if (MOD) m_callees.push_back(MOD);
+    }
+
+private:
+    // The list being extended.
+    vector<solidity::CallableDeclaration const*> & m_callees;
+    // The functions run by the contract.
+    CallGraph::Dispatch const& m_dispatch;
+};
+
+}
+
+// -------------------------------------------------------------------------- //
+
+CallGraph::CallGraph(solidity::ContractDefinition const& _contract)
+    : m_dispatch(dispatchOf(ContractSummary::localityOf(_contract)))
+{
+    // The locality comes first, so that node i is the i-th function of the
+    // ContractSummary.
+    for (auto const* FUNC : ContractSummary::localityOf(_contract)) add(*FUNC);
+    for (auto const* MOD : _contract.functionModifiers()) add(*MOD);
+
+    // Callees are appended as they are discovered, so every reachable callable
+    // is scanned exactly once.
+    for (size_t i = 0; i < m_nodes.size(); ++i)
+    {
+        vector<solidity::CallableDeclaration const*> found;
+        CallScanner scanner(found, m_dispatch);
+        m_nodes[i]->accept(scanner);
+
+        for (auto const* CALLEE : found)
+        {
+            size_t const TARGET = add(*CALLEE);
+            auto & callees = m_callees[i];
+            if (find(callees.begin(), callees.end(), TARGET) == callees.end())
+            {
+                callees.push_back(TARGET);
+            }
+        }
+    }
+
+    // Tarjan's algorithm, with an explicit stack of (node, next edge) frames.
+    // A component is completed only after every component it reaches, so the
+    // components are found callees first.
+    size_t const NONE = m_nodes.size();
+    vector<size_t> order(m_nodes.size(), NONE);
+    vector<size_t> low(m_nodes.size(), NONE);
+    vector<bool> open(m_nodes.size(), false);
+    vector<size_t> pending;
+    size_t counter = 0;
+
+    m_component.assign(m_nodes.size(), NONE);
+    m_recursive.assign(m_nodes.size(), false);
+    for (size_t root = 0; root < m_nodes.size(); ++root)
+    {
+        if (order[root] != NONE) continue;
+
+        vector<pair<size_t, size_t>> frames{ { root, 0 } };
+        order[root] = low[root] = counter++;
+        pending.push_back(root);
+        open[root] = true;
+
+        while (!frames.empty())
+        {
+            size_t const NODE = frames.back().first;
+            size_t const EDGE = frames.back().second;
+            if (EDGE < m_callees[NODE].size())
+            {
+                ++frames.back().second;
+
+                size_t const NEXT = m_callees[NODE][EDGE];
+                if (NEXT == NODE) m_recursive[NODE] = true;
+
+                if (order[NEXT] == NONE)
+                {
+                    order[NEXT] = low[NEXT] = counter++;
+                    pending.push_back(NEXT);
+                    open[NEXT] = true;
+                    frames.push_back({ NEXT, 0 });
+                }
+                else if (open[NEXT])
+                {
+                    low[NODE] = min(low[NODE], order[NEXT]);
+                }
+                continue;
+            }
+
+            frames.pop_back();
+            if (!frames.empty())
+            {
+                size_t const PARENT = frames.back().first;
+                low[PARENT] = min(low[PARENT], low[NODE]);
+            }
+            if (low[NODE] != order[NODE]) continue;
+
+            vector<size_t> members;
+            size_t member;
+            do
+            {
+                member = pending.back();
+                pending.pop_back();
+                open[member] = false;
+                m_component[member] = m_components.size();
+                members.push_back(member);
+            }
+            while (member != NODE);
+
+            sort(members.begin(), members.end());
+            if (members.size() > 1)
+            {
+                for (auto const M : members) m_recursive[M] = true;
+            }
+            m_components.push_back(move(members));
+        }
+    }
+
+    // A component follows all of its callees, so their waves are known.
+    vector<size_t> wave(m_components.size(), 0);
+    for (size_t c = 0; c < m_components.size(); ++c)
+    {
+        for (auto const NODE : m_components[c])
+        {
+            for (auto const CALLEE : m_callees[NODE])
+            {
+                size_t const TARGET = m_component[CALLEE];
+                if (TARGET != c) wave[c] = max(wave[c], wave[TARGET] + 1);
+            }
+        }
+
+        if (m_waves.size() <= wave[c]) m_waves.resize(wave[c] + 1);
+        m_waves[wave[c]].push_back(c);
+    }
+}
+
+vector<solidity::CallableDeclaration const*> const& CallGraph::nodes() const
+{
+    return m_nodes;
+}
+
+optional<size_t> CallGraph::indexOf(
+    solidity::CallableDeclaration const& _callable
+) const
+{
+    auto const RESULT = m_index.find(&_callable);
+    if (RESULT == m_index.end()) return nullopt;
+    return RESULT->second;
+}
+
+vector<size_t> const& CallGraph::callees(size_t _node) const
+{
+    return m_callees[_node];
+}
+
+vector<vector<size_t>> const& CallGraph::components() const
+{
+    return m_components;
+}
+
+size_t CallGraph::componentOf(size_t _node) const
+{
+    return m_component[_node];
+}
+
+bool CallGraph::recursive(size_t _node) const
+{
+    return m_recursive[_node];
+}
+
+vector<vector<size_t>> const& CallGraph::waves() const
+{
+    return m_waves;
+}
+
+void CallGraph::bottomUp(
+    WorkStealingPool & _pool, function<void(size_t)> const& _job
+) const
+{
+    for (auto const& WAVE : m_waves)
+    {
+        _pool.parallelFor(WAVE.size(), [&](size_t, size_t _i) {
+            _job(WAVE[_i]);
+        });
+    }
+}
+
+CallGraph::Dispatch const& CallGraph::dispatch() const
+{
+    return m_dispatch;
+}
+
+CallGraph::Dispatch CallGraph::dispatchOf(
+    vector<solidity::FunctionDefinition const*> const& _locality
+)
+{
+    Dispatch dispatch;
+    for (auto const* FUNC : _locality)
+    {
+        if (FUNC->isConstructor()) continue;
+        dispatch.emplace(ContractSummary::overrideKeyOf(*FUNC), FUNC);
+    }
+    return dispatch;
+}
+
+solidity::FunctionDefinition const* CallGraph::calleeOf(
+    solidity::FunctionCall const& _call, Dispatch const& _dispatch
+)
+{
+    // TODO: remove casts.
+    using solidity::Identifier;
+    using solidity::MemberAccess;
+    auto const& EXPR = _call.expression();
+    auto const* TYPE = dynamic_cast<solidity::FunctionType const*>(
+        EXPR.annotation().type
+    );
+    if (!TYPE || TYPE->kind() != solidity::FunctionType::Kind::Internal)
+    {
+        return nullptr;
+    }
+
+    solidity::Declaration const* decl = nullptr;
+    if (auto const* ID = dynamic_cast<Identifier const*>(&EXPR))
+    {
+        decl = ID->annotation().referencedDeclaration;
+
+        // A call by name runs the override of the contract, whereas calls
+        // through `super` or a base name are static. Library functions are
+        // never overridden.
+        auto const* FUNC = dynamic_cast<solidity::FunctionDefinition const*>(
+            decl
+        );
+        auto const* SCOPE = FUNC
+            ? dynamic_cast<solidity::ContractDefinition const*>(FUNC->scope())
+            : nullptr;
+        if (SCOPE && !SCOPE->isLibrary())
+        {
+            auto const KEY = ContractSummary::overrideKeyOf(*FUNC);
+            auto const OVERRIDE = _dispatch.find(KEY);
+            if (OVERRIDE != _dispatch.end()) decl = OVERRIDE->second;
+        }
+    }
+    else if (auto const* MEM = dynamic_cast<MemberAccess const*>(&EXPR))
+    {
+        decl = MEM->annotation().referencedDeclaration;
+    }
+
+    auto const* FUNC = dynamic_cast<solidity::FunctionDefinition const*>(decl);
+    return (FUNC && FUNC->isImplemented()) ? FUNC : nullptr;
+}
+
+size_t CallGraph::add(solidity::CallableDeclaration const& _callable)
+{
+    auto const RESULT = m_index.emplace(&_callable, m_nodes.size());
+    if (RESULT.second)
+    {
+        m_nodes.push_back(&_callable);
+        m_callees.emplace_back();
+    }
+    return RESULT.first->second;
+}
+
+// -------------------------------------------------------------------------- //
+
+}
+}
@@ -0,0 +1,164 @@
+/**
+ * A loop which calls a helper function can only be understood through the
+ * helper. Summarizing each callee again at every call site is exponential in
+ * the depth of the call chain, so callees should instead be summarized once,
+ * before their callers. This module builds the graph of internal calls, and
+ * orders its strongly connected components from the leaves upwards.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Call graphs over the functions and modifiers of a contract.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/ASTForward.h>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace dev
+{
+namespace solintent
+{
+
+class WorkStealingPool;
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * The internal calls reachable from a contract. The nodes are the functions of
+ * the contract's locality, including those it inherits, and the modifiers it
+ * defines, along with every implemented function or modifier they reach, such
+ * as internal library functions.
+ * An edge runs from a caller to each internal function it calls, and to each
+ * modifier it invokes.
+ *
+ * Calls by name are dispatched to the override which the contract runs, as in
+ * ContractSummary::localityOf. Calls through `super`, or through the name of a
+ * base, are resolved to the declaration which the compiler references.
+ */
+class CallGraph
+{
+public:
+    /**
+     * Maps the override key of each function of a locality to the function
+     * which the contract runs. See ContractSummary::overrideKeyOf.
+     */
+    using Dispatch = std::map<std::string, solidity::FunctionDefinition const*>;
+
+    /**
+     * _contract: the contract whose calls are collected.
+     */
+    explicit CallGraph(solidity::ContractDefinition const& _contract);
+
+    /**
+     * Returns all functions and modifiers of the graph. The functions of the
+     * locality come first, in the order of ContractSummary::localityOf, and
+     * are followed by the modifiers defined by the contract.
+     */
+    std::vector<solidity::CallableDeclaration const*> const& nodes() const;
+
+    /**
+     * Returns the index of a callable, or nullopt if it is not in the graph.
+     */
+    std::optional<size_t> indexOf(
+        solidity::CallableDeclaration const& _callable
+    ) const;
+
+    /**
+     * Returns the callees of a node, without duplicates.
+     */
+    std::vector<size_t> const& callees(size_t _node) const;
+
+    /**
+     * Returns the strongly connected components of the graph. Each component
+     * follows every component it calls into.
+     */
+    std::vector<std::vector<size_t>> const& components() const;
+
+    /**
+     * Returns the index of the component which holds a node.
+     */
+    size_t componentOf(size_t _node) const;
+
+    /**
+     * Returns true if a node lies on a cycle of calls.
+     */
+    bool recursive(size_t _node) const;
+
+    /**
+     * Partitions the components into waves. Each component only calls into
+     * components of earlier waves, so the components of a wave are independent.
+     */
+    std::vector<std::vector<size_t>> const& waves() const;
+
+    /**
+     * Runs _job once per component, with all components of a wave in parallel.
+     * A job only starts once every component it calls into has completed.
+     *
+     * _pool: the workers which run the jobs.
+     * _job: receives the index of each component.
+     */
+    void bottomUp(
+        WorkStealingPool & _pool, std::function<void(size_t)> const& _job
+    ) const;
+
+    /**
+     * Returns the functions run by the contract of this graph.
+     */
+    Dispatch const& dispatch() const;
+
+    /**
+     * Returns the functions of a locality, keyed by override.
+     *
+     * _locality: the functions run by a contract, as given by
+     *            ContractSummary::localityOf.
+     */
+    static Dispatch dispatchOf(
+        std::vector<solidity::FunctionDefinition const*> const& _locality
+    );
+
+    /**
+     * Returns the implemented function reached by an internal call, or nullptr
+     * if the call is external, or does not name a function.
+     *
+     * _call: the call to resolve.
+     * _dispatch: the functions run by the contract which makes the call.
+     */
+    static solidity::FunctionDefinition const* calleeOf(
+        solidity::FunctionCall const& _call, Dispatch const& _dispatch
+    );
+
+private:
+    /**
+     * Adds _callable to the graph, if it is new, and returns its index.
+     */
+    size_t add(solidity::CallableDeclaration const& _callable);
+
+    // The functions run by the contract.
+    Dispatch m_dispatch;
+    // All nodes of the graph.
+    std::vector<solidity::CallableDeclaration const*> m_nodes;
+    // Maps each node to its index.
+    std::map<solidity::CallableDeclaration const*, size_t> m_index;
+    // The callees of each node.
+    std::vector<std::vector<size_t>> m_callees;
+    // The strongly connected components, callees first.
+    std::vector<std::vector<size_t>> m_components;
+    // The component of each node.
+    std::vector<size_t> m_component;
+    // True for each node on a cycle.
+    std::vector<bool> m_recursive;
+    // The components of each wave.
+    std::vector<std::vector<size_t>> m_waves;
+};
+
+// -------------------------------------------------------------------------- //
+
+}
+}
@@ -0,0 +1,209 @@
+/**
+ * A call site is understood through the summary of its callee. This module
+ * summarizes the side effects of every function and modifier in a call graph,
+ * callees first, so that each summary is computed once and then shared by all
+ * of its call sites. Components which do not call each other are summarized
+ * in parallel.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Bottom-up summaries of the effects of each call.
+ */
+
+#include <libsolintent/static/CallSummaries.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+namespace
+{
+
+/**
+ * Collects the local effects of a callable, ignoring the bodies of callees.
+ */
+class EffectScanner: public solidity::ASTConstVisitor
+{
+public:
+    /**
+     * _effects: the summary to extend.
+     */
+    explicit EffectScanner(CallSummaries::Effects & _effects)
+        : m_effects(_effects)
+    {
+    }
+
+protected:
+    bool visit(solidity::ForStatement const&) override
+    {
+        m_effects.loops = true;
+        return true;
+    }
+
+    bool visit(solidity::WhileStatement const&) override
+    {
+        m_effects.loops = true;
+        return true;
+    }
+
+    void endVisit(solidity::Assignment const& _node) override
+    {
+        write(_node.leftHandSide());
+    }
+
+    void endVisit(solidity::UnaryOperation const& _node) override
+    {
+        switch (_node.getOperator())
+        {
+        case solidity::Token::Inc:
+        case solidity::Token::Dec:
+        case solidity::Token::Delete:
+            write(_node.subExpression());
+            break;
+        default:
+            break;
+        }
+    }
+
+    void endVisit(solidity::FunctionCall const& _node) override
+    {
+        // TODO: remove casts.
+        auto const* TYPE = dynamic_cast<solidity::FunctionType const*>(
+            _node.expression().annotation().type
+        );
+        if (!TYPE) return;
+
+        using Kind = solidity::FunctionType::Kind;
+        switch (TYPE->kind())
+        {
+        case Kind::External:
+        case Kind::DelegateCall:
+        case Kind::BareCall:
+        case Kind::BareCallCode:
+        case Kind::BareDelegateCall:
+        case Kind::BareStaticCall:
+        case Kind::Creation:
+        case Kind::Send:
+        case Kind::Transfer:
+        case Kind::Selfdestruct:
+            m_effects.external = true;
+            break;
+        case Kind::ArrayPush:
+        case Kind::ArrayPop:
+            if (auto const* MEM = dynamic_cast<solidity::MemberAccess const*>(
+                &_node.expression()
+            ))
+            {
+                write(MEM->expression());
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+private:
+    /**
+     * Records a write to the variable which owns _target, if it is a state
+     * variable. Writes to a member or element write to the whole variable.
+     */
+    void write(solidity::Expression const& _target)
+    {
+        // TODO: remove casts.
+        solidity::Expression const* root = &_target;
+        while (true)
+        {
+            using solidity::IndexAccess;
+            using solidity::MemberAccess;
+            if (auto const* IDX = dynamic_cast<IndexAccess const*>(root))
+            {
+                root = &IDX->baseExpression();
+            }
+            else if (auto const* MEM = dynamic_cast<MemberAccess const*>(root))
+            {
+                root = &MEM->expression();
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        auto const* ID = dynamic_cast<solidity::Identifier const*>(root);
+        if (!ID) return;
+
+        auto const* DECL = dynamic_cast<solidity::VariableDeclaration const*>(
+            ID->annotation().referencedDeclaration
+        );
+        if (DECL && DECL->isStateVariable()) m_effects.writes.insert(DECL);
+    }
+
+    // The summary being extended.
+    CallSummaries::Effects & m_effects;
+};
+
+}
+
+// -------------------------------------------------------------------------- //
+
+CallSummaries::CallSummaries(CallGraph const& _graph, WorkStealingPool & _pool)
+    : m_graph(_graph)
+    , m_effects(_graph.components().size())
+{
+    // Each job writes only the slot of its own component, and reads only the
+    // slots of earlier waves, so no locking is needed.
+    _graph.bottomUp(_pool, [this](size_t _component) {
+        Effects effects;
+        for (auto const NODE : m_graph.components()[_component])
+        {
+            EffectScanner scanner(effects);
+            m_graph.nodes()[NODE]->accept(scanner);
+            if (m_graph.recursive(NODE)) effects.recursive = true;
+
+            for (auto const CALLEE : m_graph.callees(NODE))
+            {
+                size_t const TARGET = m_graph.componentOf(CALLEE);
+                if (TARGET == _component) continue;
+
+                auto const& OTHER = m_effects[TARGET];
+                effects.loops = (effects.loops || OTHER.loops);
+                effects.recursive = (effects.recursive || OTHER.recursive);
+                effects.external = (effects.external || OTHER.external);
+                effects.writes.insert(OTHER.writes.begin(), OTHER.writes.end());
+            }
+        }
+        m_effects[_component] = move(effects);
+    });
+}
+
+CallSummaries::Effects const& CallSummaries::of(size_t _node) const
+{
+    return m_effects[m_graph.componentOf(_node)];
+}
+
+CallSummaries::Effects const* CallSummaries::atCall(
+    solidity::FunctionCall const& _call
+) const
+{
+    auto const* CALLEE = CallGraph::calleeOf(_call, m_graph.dispatch());
+    if (!CALLEE) return nullptr;
+
+    auto const INDEX = m_graph.indexOf(*CALLEE);
+    if (!INDEX.has_value()) return nullptr;
+    return &of(*INDEX);
+}
+
+// -------------------------------------------------------------------------- //
+
+}
+}
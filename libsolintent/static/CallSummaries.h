@@ -0,0 +1,81 @@
+/**
+ * A call site is understood through the summary of its callee. This module
+ * summarizes the side effects of every function and modifier in a call graph,
+ * callees first, so that each summary is computed once and then shared by all
+ * of its call sites. Components which do not call each other are summarized
+ * in parallel.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Bottom-up summaries of the effects of each call.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/ASTForward.h>
+#include <libsolintent/static/CallGraph.h>
+#include <set>
+#include <vector>
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * Summarizes the effects of each node of a CallGraph, including the effects of
+ * everything it calls. The members of a strongly connected component reach one
+ * another, so they share a single summary.
+ */
+class CallSummaries
+{
+public:
+    /**
+     * The effects of running a callable to completion.
+     */
+    struct Effects
+    {
+        // True if a loop may run, in the callable or in any callee.
+        bool loops = false;
+        // True if the callable, or any callee, lies on a cycle of calls.
+        bool recursive = false;
+        // True if an external call, or transfer of ether, may be made.
+        bool external = false;
+        // The state variables which may be written.
+        std::set<solidity::VariableDeclaration const*> writes;
+    };
+
+    /**
+     * _graph: the graph to summarize. It must outlive these summaries.
+     * _pool: the workers used to summarize independent components.
+     */
+    CallSummaries(CallGraph const& _graph, WorkStealingPool & _pool);
+
+    /**
+     * Returns the effects of a node of the graph.
+     */
+    Effects const& of(size_t _node) const;
+
+    /**
+     * Returns the effects of a call, or nullptr if the call does not reach a
+     * node of the graph.
+     *
+     * _call: a call within some node of the graph.
+     */
+    Effects const* atCall(solidity::FunctionCall const& _call) const;
+
+private:
+    // The graph being summarized.
+    CallGraph const& m_graph;
+    // The effects of each component.
+    std::vector<Effects> m_effects;
+};
+
+// -------------------------------------------------------------------------- //
+
+}
+}
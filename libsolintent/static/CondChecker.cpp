@@ -13,6 +13,8 @@
 #include <libsolintent/static/CondChecker.h>
 
 #include <libsolintent/ir/ExpressionSummary.h>
+#include <libsolintent/static/ConstantTable.h>
+#include <libsolintent/static/ExpressionTable.h>
 #include <libsolintent/util/SourceLocation.h>
 #include <algorithm>
 #include <stdexcept>
@@ -26,34 +28,71 @@ namespace solintent
 
 // -------------------------------------------------------------------------- //
 
+namespace
+{
+
+/**
+ * Evaluates a comparison operator over two exact values.
+ *
+ * _op: the comparison token
+ * _lhs: the left-hand operand
+ * _rhs: the right-hand operand
+ */
+template <typename T>
+bool compare(solidity::Token _op, T const& _lhs, T const& _rhs)
+{
+    switch (_op)
+    {
+    case solidity::Token::Equal:
+        return _lhs == _rhs;
+    case solidity::Token::NotEqual:
+        return _lhs != _rhs;
+    case solidity::Token::LessThan:
+        return _lhs < _rhs;
+    case solidity::Token::LessThanOrEqual:
+        return _lhs <= _rhs;
+    case solidity::Token::GreaterThan:
+        return _lhs > _rhs;
+    case solidity::Token::GreaterThanOrEqual:
+        return _lhs >= _rhs;
+    default:
+        string const TOKSTR = solidity::TokenTraits::friendlyName(_op);
+        throw runtime_error("Unexpected comparison operator: " + TOKSTR);
+    }
+}
+
+}
+
+// -------------------------------------------------------------------------- //
+
 bool CondChecker::visit(solidity::ParameterList const& _node)
 {
-    (void) _node;
-    throw;
+    string const SRC = srclocToStr(_node.location());
+    throw UnsupportedExpression("Unsupported boolean expression: " + SRC);
 }
 
 bool CondChecker::visit(solidity::InlineAssembly const& _node)
 {
-    (void) _node;
-    throw;
+    string const SRC = srclocToStr(_node.location());
+    throw UnsupportedExpression("Unsupported boolean expression: " + SRC);
 }
 
 bool CondChecker::visit(solidity::Conditional const& _node)
 {
-    (void) _node;
-    throw;
+    string const SRC = srclocToStr(_node.location());
+    throw UnsupportedExpression("Unsupported boolean expression: " + SRC);
 }
 
 bool CondChecker::visit(solidity::TupleExpression const& _node)
 {
-    (void) _node;
-    throw;
+    string const SRC = srclocToStr(_node.location());
+    throw UnsupportedExpression("Unsupported boolean expression: " + SRC);
 }
 
 bool CondChecker::visit(solidity::UnaryOperation const& _node)
 {
-    (void) _node;
-    throw;
+    string const SRC = srclocToStr(_node.location());
+    throw UnsupportedExpression("Unsupported boolean expression: " + SRC);
 }
 
 bool CondChecker::visit(solidity::BinaryOperation const& _node)
@@ -71,60 +110,58 @@ bool CondChecker::visit(solidity::BinaryOperation const& _node)
         auto rhs = getNumericAnalyzer().check(_node.rightExpression());
 
         // Determines if the result may be resolved in-place.
-        if (lhs->exact().has_value() && rhs->exact().has_value())
+        auto const LHS_INT = lhs->exactInt();
+        auto const RHS_INT = rhs->exactInt();
+        if (LHS_INT.has_value() && RHS_INT.has_value())
         {
-            // Computes the operation.
-            bool res;
-            switch (OP)
-            {
-            case solidity::Token::Equal:
-                res = (*lhs->exact()) == (*rhs->exact());
-                break;
-            case solidity::Token::NotEqual:
-                res = (*lhs->exact()) != (*rhs->exact());
-                break;
-            case solidity::Token::LessThan:
-                res = (*lhs->exact()) < (*rhs->exact());
-                break;
-            case solidity::Token::LessThanOrEqual:
-                res = (*lhs->exact()) <= (*rhs->exact());
-                break;
-            case solidity::Token::GreaterThan:
-                res = (*lhs->exact()) > (*rhs->exact());
-                break;
-            case solidity::Token::GreaterThanOrEqual:
-                res = (*lhs->exact()) >= (*rhs->exact());
-                break;
-            }
-            write_to_cache(make_shared<BooleanConstant>(_node, res));
+            bool const RES = compare(OP, *LHS_INT, *RHS_INT);
+            auto summary = make_shared<BooleanConstant>(_node, RES);
+            alias_in_cache(_node, getExpressionTable().intern(move(summary)));
+        }
+        else if (lhs->exact().has_value() && rhs->exact().has_value())
+        {
+            bool const RES = compare(OP, *lhs->exact(), *rhs->exact());
+            auto summary = make_shared<BooleanConstant>(_node, RES);
+            alias_in_cache(_node, getExpressionTable().intern(move(summary)));
         }
         else
         {
             // Classifies the operation.
             Comparison::Condition cond;
+            bool strict = true;
             switch (OP)
             {
             case solidity::Token::Equal:
                 cond = Comparison::Condition::Equal;
+                strict = false;
                 break;
             case solidity::Token::NotEqual:
                 cond = Comparison::Condition::Distinct;
                 break;
             case solidity::Token::LessThan:
+                cond = Comparison::Condition::LessThan;
+                break;
             case solidity::Token::LessThanOrEqual:
                 cond = Comparison::Condition::LessThan;
+                strict = false;
                 break;
             case solidity::Token::GreaterThan:
+                cond = Comparison::Condition::GreaterThan;
+                break;
             case solidity::Token::GreaterThanOrEqual:
                 cond = Comparison::Condition::GreaterThan;
+                strict = false;
                 break;
             }
-            write_to_cache(make_shared<Comparison>(_node, cond, lhs, rhs));
+            auto summary = make_shared<Comparison>(
+                _node, cond, strict, lhs, rhs
+            );
+            alias_in_cache(_node, getExpressionTable().intern(move(summary)));
         }
     }
     else if (solidity::TokenTraits::isBooleanOp(OP))
     {
-        throw runtime_error("Connective operators not yet supported.");
+        throw UnsupportedExpression("Connective operators not yet supported.");
     }
     else
     {
@@ -137,58 +174,49 @@ bool CondChecker::visit(solidity::BinaryOperation const& _node)
 
 bool CondChecker::visit(solidity::FunctionCall const& _node)
 {
-    (void) _node;
-    throw;
+    string const SRC = srclocToStr(_node.location());
+    throw UnsupportedExpression("Unsupported boolean expression: " + SRC);
 }
 
 bool CondChecker::visit(solidity::MemberAccess const& _node)
 {
     // TODO: code duplication
-    write_to_cache(make_shared<BooleanVariable>(_node));
+    auto summary = make_shared<BooleanVariable>(_node);
+    alias_in_cache(_node, getExpressionTable().intern(move(summary)));
     return false;
 }
 
 bool CondChecker::visit(solidity::IndexAccess const& _node)
 {
-    (void) _node;
-    throw;
+    string const SRC = srclocToStr(_node.location());
+    throw UnsupportedExpression("Unsupported boolean expression: " + SRC);
 }
 
 bool CondChecker::visit(solidity::IndexRangeAccess const& _node)
 {
-    (void) _node;
-    throw;
+    string const SRC = srclocToStr(_node.location());
+    throw UnsupportedExpression("Unsupported boolean expression: " + SRC);
 }
 
 bool CondChecker::visit(solidity::Identifier const& _node)
 {
-    // TODO: code duplication
-    SummaryPointer<BooleanSummary const> summary;
-
-    // Checks if this expression has a constant value.
+    // Constants are folded once, and then shared by all uses.
     auto const* REF = _node.annotation().referencedDeclaration;
     if (auto DECL = dynamic_cast<solidity::VariableDeclaration const*>(REF))
     {
         if (DECL->isConstant())
         {
-            auto tmp = check(*DECL->value());
-            if (!tmp->exact().has_value())
+            if (auto folded = getConstantTable().boolean(*DECL, *this))
             {
-                string const SRC = srclocToStr(DECL->location());
-                throw runtime_error("Expected constant, found: " + SRC); 
+                alias_in_cache(_node, move(folded));
+                return false;
             }
-            summary = make_shared<BooleanConstant>(_node, *tmp->exact());
         }
-   }
-
-    // It is not reducible to a constant
-    if (!summary)
-    {
-        summary = make_shared<BooleanVariable>(_node);
     }
 
-    // Records entry.
-    write_to_cache(move(summary));
+    // It is not reducible to a constant.
+    auto summary = make_shared<BooleanVariable>(_node);
+    alias_in_cache(_node, getExpressionTable().intern(move(summary)));
     return false;
 }
 
@@ -209,7 +237,8 @@ bool CondChecker::visit(solidity::Literal const& _node)
     }
 
     // Records the value
-    write_to_cache(move(make_shared<BooleanConstant>(_node, val)));
+    auto summary = make_shared<BooleanConstant>(_node, val);
+    alias_in_cache(_node, getExpressionTable().intern(move(summary)));
     return false;
 }
 
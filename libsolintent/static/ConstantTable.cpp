@@ -0,0 +1,159 @@
+/**
+ * Constant declarations are referenced throughout a contract, often within
+ * every loop and guard. Rather than re-evaluating a declaration at each use,
+ * the ConstantTable folds each declaration exactly once, and then serves its
+ * value by declaration id.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Per-compilation table of folded compile-time constants.
+ */
+
+#include <libsolintent/static/ConstantTable.h>
+
+#include <stdexcept>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+template <typename Fold>
+ConstantTable::Entry const& ConstantTable::lookup(
+    solidity::VariableDeclaration const& _decl, Fold _fold
+)
+{
+    auto itr = m_table.find(_decl.id());
+    if (itr != m_table.end())
+    {
+        if (itr->second.state == State::Pending)
+        {
+            itr->second.state = State::Failed;
+            fail(_decl, "Cyclic dependency between constants.");
+        }
+        return itr->second;
+    }
+
+    // References to unordered_map entries are stable under insertion, so the
+    // entry outlives any recursive lookups made while folding.
+    Entry & entry = m_table[_decl.id()];
+    entry.state = State::Pending;
+
+    string reason = "Value does not reduce to a constant.";
+    bool folded = false;
+    if (_decl.value())
+    {
+        try
+        {
+            folded = _fold(entry);
+        }
+        catch (exception const& _err)
+        {
+            reason = _err.what();
+        }
+    }
+
+    if (entry.state == State::Pending)
+    {
+        entry.state = folded ? State::Folded : State::Failed;
+        if (!folded) fail(_decl, move(reason));
+    }
+
+    // A cyclic declaration is opaque, even if its fold somehow succeeded.
+    if (entry.state == State::Failed)
+    {
+        entry.numeric = nullptr;
+        entry.boolean = nullptr;
+    }
+
+    return entry;
+}
+
+void ConstantTable::fail(
+    solidity::VariableDeclaration const& _decl, string _reason
+)
+{
+    m_failures.push_back({ &_decl, move(_reason) });
+}
+
+// -------------------------------------------------------------------------- //
+
+void ConstantTable::populate(
+    vector<solidity::SourceUnit const*> const& _units,
+    detail::NumericAnalyzer & _numeric,
+    detail::BooleanAnalyzer & _boolean
+)
+{
+    using solidity::ASTNode;
+    using solidity::ContractDefinition;
+
+    for (auto const* unit : _units)
+    {
+        auto contracts = ASTNode::filteredNodes<ContractDefinition>(unit->nodes());
+        for (auto const* contract : contracts)
+        {
+            for (auto const* decl : contract->stateVariables())
+            {
+                if (!decl->isConstant() || !decl->value()) continue;
+
+                // Other constants (strings, bytes, etc.) are not summarized.
+                if (_boolean.matches(*decl->value()))
+                {
+                    boolean(*decl, _boolean);
+                }
+                else if (_numeric.matches(*decl->value()))
+                {
+                    numeric(*decl, _numeric);
+                }
+            }
+        }
+    }
+}
+
+SummaryPointer<NumericSummary> ConstantTable::numeric(
+    solidity::VariableDeclaration const& _decl,
+    detail::NumericAnalyzer & _analyzer
+)
+{
+    return lookup(_decl, [&](Entry & _entry) {
+        auto value = _analyzer.check(*_decl.value());
+        if (!value->exactInt().has_value() && !value->exact().has_value())
+        {
+            return false;
+        }
+        _entry.numeric = move(value);
+        return true;
+    }).numeric;
+}
+
+SummaryPointer<BooleanSummary> ConstantTable::boolean(
+    solidity::VariableDeclaration const& _decl,
+    detail::BooleanAnalyzer & _analyzer
+)
+{
+    return lookup(_decl, [&](Entry & _entry) {
+        auto value = _analyzer.check(*_decl.value());
+        if (!value->exact().has_value())
+        {
+            return false;
+        }
+        _entry.boolean = move(value);
+        return true;
+    }).boolean;
+}
+
+vector<ConstantTable::Failure> const& ConstantTable::failures() const
+{
+    return m_failures;
+}
+
+// -------------------------------------------------------------------------- //
+
+}
+}
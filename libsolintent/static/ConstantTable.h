@@ -0,0 +1,133 @@
+/**
+ * Constant declarations are referenced throughout a contract, often within
+ * every loop and guard. Rather than re-evaluating a declaration at each use,
+ * the ConstantTable folds each declaration exactly once, and then serves its
+ * value by declaration id.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Per-compilation table of folded compile-time constants.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/AST.h>
+#include <libsolintent/ir/ExpressionInterface.h>
+#include <libsolintent/static/AbstractExpressionAnalyzer.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * Maps each constant declaration to its folded value. Declarations are folded
+ * on first request, so that dependencies are always folded before their
+ * dependants. A declaration which is cyclic, or which does not reduce to a
+ * value, is reported once and thereafter treated as opaque.
+ *
+ * Note: the vendored compiler predates `immutable`, so only `constant`
+ *       declarations are folded.
+ */
+class ConstantTable
+{
+public:
+    /**
+     * Describes a declaration which could not be folded.
+     */
+    struct Failure
+    {
+        solidity::VariableDeclaration const* decl;
+        std::string reason;
+    };
+
+    /**
+     * Folds all constant declarations within the given source units. This is
+     * optional, as declarations are otherwise folded on demand.
+     *
+     * _units: the source units to scan for constants.
+     * _numeric: the analyzer used to fold numeric declarations.
+     * _boolean: the analyzer used to fold boolean declarations.
+     */
+    void populate(
+        std::vector<solidity::SourceUnit const*> const& _units,
+        detail::NumericAnalyzer & _numeric,
+        detail::BooleanAnalyzer & _boolean
+    );
+
+    /**
+     * Returns the folded value of a numeric constant. If the declaration cannot
+     * be folded, then nullptr is returned.
+     *
+     * _decl: the constant declaration.
+     * _analyzer: the analyzer used if the declaration is not yet folded.
+     */
+    SummaryPointer<NumericSummary> numeric(
+        solidity::VariableDeclaration const& _decl,
+        detail::NumericAnalyzer & _analyzer
+    );
+
+    /**
+     * Returns the folded value of a boolean constant. If the declaration cannot
+     * be folded, then nullptr is returned.
+     *
+     * _decl: the constant declaration.
+     * _analyzer: the analyzer used if the declaration is not yet folded.
+     */
+    SummaryPointer<BooleanSummary> boolean(
+        solidity::VariableDeclaration const& _decl,
+        detail::BooleanAnalyzer & _analyzer
+    );
+
+    /**
+     * Returns each declaration which failed to fold, in the order of failure.
+     */
+    std::vector<Failure> const& failures() const;
+
+private:
+    /**
+     * The folding state of a declaration. A declaration is pending while its
+     * initial value is being folded. Revisiting a pending declaration implies a
+     * cyclic dependency.
+     */
+    enum class State { Pending, Folded, Failed };
+
+    /**
+     * An entry of the table. At most one of numeric and boolean is set.
+     */
+    struct Entry
+    {
+        State state;
+        SummaryPointer<NumericSummary> numeric;
+        SummaryPointer<BooleanSummary> boolean;
+    };
+
+    /**
+     * Shared implementation of numeric() and boolean(). The _fold callback is
+     * invoked at most once per declaration, and returns true on success.
+     */
+    template <typename Fold>
+    Entry const& lookup(solidity::VariableDeclaration const& _decl, Fold _fold);
+
+    /**
+     * Records that a declaration could not be folded.
+     */
+    void fail(solidity::VariableDeclaration const& _decl, std::string _reason);
+
+    // Maps declaration ids to their entries.
+    std::unordered_map<SummaryKey, Entry> m_table;
+    // All declarations which failed to fold.
+    std::vector<Failure> m_failures;
+};
+
+// -------------------------------------------------------------------------- //
+
+}
+}
@@ -10,6 +10,8 @@
 
 #include <libsolintent/static/ContractChecker.h>
 
+#include <libsolidity/ast/AST.h>
+
 using namespace std;
 
 namespace dev
@@ -19,13 +21,23 @@ namespace solintent
 
 bool ContractChecker::visit(solidity::ContractDefinition const& _node)
 {
-    // TODO placeholder
-    vector<SummaryPointer<FunctionSummary>> funcs;
-    for (auto func : _node.definedFunctions())
-    {
-        funcs.push_back(getFunctionAnalyzer().check(*func));
-    }
-    write_to_cache(make_shared<ContractSummary>(_node, move(funcs)));
+    // Functions are summarized on demand. The analyzers memoize without locks,
+    // so loads from concurrent readers are serialized. A base function appears
+    // in the locality of each derived contract, but the function analyzer
+    // summarizes anew on each check, so loaded summaries are kept by id, and
+    // shared across contracts.
+    auto & analyzer = getFunctionAnalyzer();
+    auto lock = m_load_mutex;
+    auto memo = m_loaded;
+    auto loader = [&analyzer, lock, memo](
+        solidity::FunctionDefinition const& _func
+    ) {
+        lock_guard<mutex> const LOCK(*lock);
+        auto & summary = (*memo)[_func.id()];
+        if (!summary) summary = analyzer.check(_func);
+        return summary;
+    };
+    write_to_cache(make_shared<ContractSummary>(_node, move(loader)));
     return false;
 }
 
@@ -11,6 +11,9 @@
 #pragma once
 
 #include <libsolintent/static/AbstractContractAnalyzer.h>
+#include <map>
+#include <memory>
+#include <mutex>
 
 namespace dev
 {
@@ -21,6 +24,17 @@ class ContractChecker: public ContractAnalyzer
 {
 protected:
 	bool visit(solidity::ContractDefinition const& _node) override;
+
+private:
+	/**
+	 * The function summaries loaded so far, keyed by function id.
+	 */
+	using SummaryMemo = std::map<SummaryKey, SummaryPointer<FunctionSummary>>;
+
+	// Serializes the function summaries loaded by each ContractSummary.
+	std::shared_ptr<std::mutex> m_load_mutex = std::make_shared<std::mutex>();
+	// Shares the summary of each base function among all derived contracts.
+	std::shared_ptr<SummaryMemo> m_loaded = std::make_shared<SummaryMemo>();
 };
 
 }
@@ -0,0 +1,376 @@
+/**
+ * The statement IR is a tree, which mirrors the syntax of a function. Analyses
+ * such as reaching definitions instead follow the flow of control, through
+ * branches, around loops, and out of early exits. This module lowers the
+ * statement IR of a function into a graph of basic blocks.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Control-flow graphs over the statement IR.
+ */
+
+#include <libsolintent/static/ControlFlowGraph.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolintent/ir/IRVisitor.h>
+#include <libsolintent/ir/StatementSummary.h>
+#include <libsolintent/ir/StructuralSummary.h>
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+namespace
+{
+
+/**
+ * Lowers the statement IR into blocks, while tracking the targets of jumps.
+ */
+class Builder: public IRVisitor
+{
+public:
+    /**
+     * _blocks: the blocks to extend, which already hold the entry and exit.
+     * _loops: the loops to extend.
+     * _entry: the index of the entry block.
+     * _exit: the index of the exit block.
+     */
+    Builder(
+        vector<ControlFlowGraph::Block> & _blocks,
+        vector<ControlFlowGraph::Loop> & _loops,
+        size_t _entry,
+        size_t _exit
+    )
+        : m_blocks(_blocks)
+        , m_loops(_loops)
+        , m_current(_entry)
+        , m_exit(_exit)
+    {
+    }
+
+    /**
+     * Lowers _body, and then links the final block to the exit.
+     */
+    void build(IRSummary const& _body)
+    {
+        _body.acceptIR(*this);
+        link(m_current, m_exit);
+    }
+
+    void acceptIR(ContractSummary const&) override
+    {
+        throw runtime_error("Control-flow graphs are built per function.");
+    }
+
+    void acceptIR(FunctionSummary const& _ir) override
+    {
+        m_splices.push_back({ &_ir, 0 });
+        splice();
+        m_splices.pop_back();
+    }
+
+    void acceptIR(ModifierSummary const& _ir) override
+    {
+        _ir.body().acceptIR(*this);
+    }
+
+    void acceptIR(TreeBlockSummary const& _ir) override
+    {
+        for (size_t i = 0; i < _ir.summaryLength(); ++i)
+        {
+            _ir.get(i)->acceptIR(*this);
+        }
+    }
+
+    void acceptIR(LoopSummary const& _ir) override
+    {
+        // TODO: remove cast.
+        auto const* WHILE = dynamic_cast<solidity::WhileStatement const*>(
+            &_ir.expr()
+        );
+        bool const DO_WHILE = (WHILE && WHILE->isDoWhile());
+
+        if (auto const* INIT = _ir.initializer())
+        {
+            m_blocks[m_current].statements.push_back(INIT);
+        }
+
+        size_t const HEADER = fresh();
+        size_t const BODY = fresh();
+        size_t const LATCH = fresh();
+        size_t const AFTER = fresh();
+
+        m_blocks[HEADER].condition = (&_ir.terminationCondition());
+        m_blocks[HEADER].loop = (&_ir);
+        size_t const LOOP = m_loops.size();
+        m_loops.push_back({ &_ir, HEADER, {} });
+
+        link(m_current, DO_WHILE ? BODY : HEADER);
+        link(HEADER, BODY);
+        link(HEADER, AFTER);
+
+        m_targets.push_back({ LATCH, AFTER });
+        m_current = BODY;
+        _ir.body().acceptIR(*this);
+        link(m_current, LATCH);
+        m_targets.pop_back();
+
+        if (auto const* UPDATE = _ir.update())
+        {
+            m_blocks[LATCH].statements.push_back(UPDATE);
+        }
+        link(LATCH, HEADER);
+
+        // Blocks are numbered in creation order, so the loop owns its header,
+        // body and latch, along with every block created while in its body.
+        auto & blocks = m_loops[LOOP].blocks;
+        blocks = { HEADER, BODY, LATCH };
+        for (size_t i = AFTER + 1; i < m_blocks.size(); ++i)
+        {
+            blocks.push_back(i);
+        }
+
+        m_current = AFTER;
+    }
+
+    void acceptIR(BranchSummary const& _ir) override
+    {
+        size_t const TEST = m_current;
+        m_blocks[TEST].condition = (&_ir.condition());
+        m_blocks[TEST].branch = (&_ir);
+
+        size_t const ON_TRUE = fresh();
+        size_t const JOIN = fresh();
+
+        link(TEST, ON_TRUE);
+        m_current = ON_TRUE;
+        _ir.trueBranch().acceptIR(*this);
+        link(m_current, JOIN);
+
+        if (auto const* ELSE = _ir.falseBranch())
+        {
+            size_t const ON_FALSE = fresh();
+            link(TEST, ON_FALSE);
+            m_current = ON_FALSE;
+            ELSE->acceptIR(*this);
+            link(m_current, JOIN);
+        }
+        else
+        {
+            link(TEST, JOIN);
+        }
+
+        m_current = JOIN;
+    }
+
+    void acceptIR(JumpSummary const& _ir) override
+    {
+        m_blocks[m_current].statements.push_back(&_ir);
+
+        switch (_ir.kind())
+        {
+        case JumpSummary::Kind::Break:
+            link(m_current, target().second);
+            break;
+        case JumpSummary::Kind::Continue:
+            link(m_current, target().first);
+            break;
+        case JumpSummary::Kind::Return:
+            link(m_current, m_returns.empty() ? m_exit : m_returns.back());
+            break;
+        }
+
+        // Any statement after a jump is unreachable.
+        m_current = fresh();
+    }
+
+    void acceptIR(PlaceholderSummary const& _ir) override
+    {
+        // Outside of a function, the placeholder is opaque.
+        if (m_splices.empty())
+        {
+            m_blocks[m_current].statements.push_back(&_ir);
+            return;
+        }
+
+        // A return within the spliced code resumes after the placeholder. The
+        // loops of the modifier cannot be targeted by the spliced code.
+        size_t const RESUME = fresh();
+        vector<pair<size_t, size_t>> outer;
+        swap(outer, m_targets);
+        m_returns.push_back(RESUME);
+        splice();
+        m_returns.pop_back();
+        swap(outer, m_targets);
+
+        link(m_current, RESUME);
+        m_current = RESUME;
+    }
+
+    void acceptIR(NumericExprStatement const& _ir) override
+    {
+        m_blocks[m_current].statements.push_back(&_ir);
+    }
+
+    void acceptIR(BooleanExprStatement const& _ir) override
+    {
+        m_blocks[m_current].statements.push_back(&_ir);
+    }
+
+    void acceptIR(FreshVarSummary const& _ir) override
+    {
+        m_blocks[m_current].statements.push_back(&_ir);
+    }
+
+    void acceptIR(NumericConstant const&) override {}
+    void acceptIR(NumericVariable const&) override {}
+    void acceptIR(BooleanConstant const&) override {}
+    void acceptIR(BooleanVariable const&) override {}
+    void acceptIR(Comparison const&) override {}
+    void acceptIR(PushCall const&) override {}
+
+private:
+    /**
+     * Creates a new block, and returns its index.
+     */
+    size_t fresh()
+    {
+        m_blocks.emplace_back();
+        return m_blocks.size() - 1;
+    }
+
+    /**
+     * Lowers the next modifier of the innermost splice, or the function body
+     * once all of its modifiers have been entered.
+     */
+    void splice()
+    {
+        auto const* FUNC = m_splices.back().first;
+        size_t const DEPTH = m_splices.back().second;
+
+        auto const& MODIFIERS = FUNC->modifiers();
+        if (DEPTH < MODIFIERS.size())
+        {
+            ++m_splices.back().second;
+            MODIFIERS[DEPTH]->acceptIR(*this);
+            --m_splices.back().second;
+        }
+        else
+        {
+            FUNC->body().acceptIR(*this);
+        }
+    }
+
+    /**
+     * Adds an edge from _src to _dst.
+     */
+    void link(size_t _src, size_t _dst)
+    {
+        m_blocks[_src].succs.push_back(_dst);
+        m_blocks[_dst].preds.push_back(_src);
+    }
+
+    /**
+     * Returns the continue and break targets of the innermost loop.
+     */
+    pair<size_t, size_t> const& target() const
+    {
+        if (m_targets.empty())
+        {
+            throw runtime_error("Jump outside of a loop.");
+        }
+        return m_targets.back();
+    }
+
+    // The blocks under construction.
+    vector<ControlFlowGraph::Block> & m_blocks;
+    // The loops under construction.
+    vector<ControlFlowGraph::Loop> & m_loops;
+    // The block which receives the next statement.
+    size_t m_current;
+    // The index of the exit block.
+    size_t const m_exit;
+    // The continue and break targets of each enclosing loop, innermost last.
+    vector<pair<size_t, size_t>> m_targets;
+    // The return target of each enclosing placeholder, innermost last.
+    vector<size_t> m_returns;
+    // The functions whose modifiers are being spliced, innermost last, each
+    // with the number of its modifiers entered so far.
+    vector<pair<FunctionSummary const*, size_t>> m_splices;
+};
+
+}
+
+// -------------------------------------------------------------------------- //
+
+ControlFlowGraph::ControlFlowGraph(IRSummary const& _body)
+    : m_blocks(2)
+{
+    Builder(m_blocks, m_loops, entry(), exit()).build(_body);
+
+    // Iterative depth-first search, which records each block once all of its
+    // successors are finished.
+    vector<bool> seen(m_blocks.size(), false);
+    vector<pair<size_t, size_t>> stack{ { entry(), 0 } };
+    seen[entry()] = true;
+    while (!stack.empty())
+    {
+        auto & top = stack.back();
+        auto const& SUCCS = m_blocks[top.first].succs;
+        if (top.second < SUCCS.size())
+        {
+            size_t const NEXT = SUCCS[top.second++];
+            if (!seen[NEXT])
+            {
+                seen[NEXT] = true;
+                stack.push_back({ NEXT, 0 });
+            }
+        }
+        else
+        {
+            m_rpo.push_back(top.first);
+            stack.pop_back();
+        }
+    }
+    reverse(m_rpo.begin(), m_rpo.end());
+}
+
+size_t ControlFlowGraph::entry() const
+{
+    return 0;
+}
+
+size_t ControlFlowGraph::exit() const
+{
+    return 1;
+}
+
+vector<ControlFlowGraph::Block> const& ControlFlowGraph::blocks() const
+{
+    return m_blocks;
+}
+
+vector<ControlFlowGraph::Loop> const& ControlFlowGraph::loops() const
+{
+    return m_loops;
+}
+
+vector<size_t> const& ControlFlowGraph::reversePostOrder() const
+{
+    return m_rpo;
+}
+
+// -------------------------------------------------------------------------- //
+
+}
+}
@@ -0,0 +1,114 @@
+/**
+ * The statement IR is a tree, which mirrors the syntax of a function. Analyses
+ * such as reaching definitions instead follow the flow of control, through
+ * branches, around loops, and out of early exits. This module lowers the
+ * statement IR of a function into a graph of basic blocks.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Control-flow graphs over the statement IR.
+ */
+
+#pragma once
+
+#include <libsolintent/ir/ForwardIR.h>
+#include <vector>
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * A graph of basic blocks over the statement IR of a single function body. The
+ * graph has a unique entry and exit. Statements which follow a jump start a
+ * fresh block, which has no predecessors.
+ */
+class ControlFlowGraph
+{
+public:
+    /**
+     * A maximal sequence of statements without internal control flow.
+     */
+    struct Block
+    {
+        // The straight-line statements of the block, in order.
+        std::vector<StatementSummary const*> statements;
+        // The condition which selects the successor, if the block branches.
+        BooleanSummary const* condition = nullptr;
+        // The loop for which this is the header, if any.
+        LoopSummary const* loop = nullptr;
+        // The branch which tests the condition of this block, if any.
+        BranchSummary const* branch = nullptr;
+        // The blocks which may run directly after this block.
+        std::vector<size_t> succs;
+        // The blocks which may run directly before this block.
+        std::vector<size_t> preds;
+    };
+
+    /**
+     * A loop, as it appears in the graph.
+     */
+    struct Loop
+    {
+        // The summary of the loop.
+        LoopSummary const* summary;
+        // The block which tests the termination condition.
+        size_t header;
+        // All blocks of the loop, including the header.
+        std::vector<size_t> blocks;
+    };
+
+    /**
+     * Lowers _body into basic blocks. The modifiers of a function are spliced
+     * in, so that the function body runs at each placeholder, and each return
+     * resumes after the placeholder.
+     *
+     * _body: a function, or any statement within one.
+     */
+    explicit ControlFlowGraph(IRSummary const& _body);
+
+    /**
+     * Returns the index of the entry block.
+     */
+    size_t entry() const;
+
+    /**
+     * Returns the index of the exit block. The exit is empty, and is reached
+     * on return, or once the body completes.
+     */
+    size_t exit() const;
+
+    /**
+     * Returns all blocks of the graph.
+     */
+    std::vector<Block> const& blocks() const;
+
+    /**
+     * Returns all loops of the graph, outermost first.
+     */
+    std::vector<Loop> const& loops() const;
+
+    /**
+     * Returns the blocks reachable from the entry, in reverse post-order. Each
+     * block precedes its successors, other than along back edges.
+     */
+    std::vector<size_t> const& reversePostOrder() const;
+
+private:
+    // All blocks of the graph.
+    std::vector<Block> m_blocks;
+    // All loops of the graph.
+    std::vector<Loop> m_loops;
+    // The reachable blocks, in reverse post-order.
+    std::vector<size_t> m_rpo;
+};
+
+// -------------------------------------------------------------------------- //
+
+}
+}
@@ -0,0 +1,151 @@
+/**
+ * Many analyses over a control-flow graph are gen/kill problems: each block
+ * generates some facts, kills others, and facts are merged where paths meet.
+ * This module solves such problems once, for any finite set of facts, by
+ * encoding each set as a bitset. Blocks are revisited from a worklist ordered
+ * by reverse post-order, so most problems converge in a few passes.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Worklist dataflow over bitset lattices.
+ */
+
+#include <libsolintent/static/Dataflow.h>
+
+#include <algorithm>
+#include <set>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+BitsetDataflow::BitsetDataflow(
+    ControlFlowGraph const& _cfg, Direction _dir, Meet _meet, size_t _width
+)
+    : m_cfg(_cfg)
+    , m_dir(_dir)
+    , m_meet(_meet)
+    , m_gen(_cfg.blocks().size(), Bits(_width))
+    , m_kill(_cfg.blocks().size(), Bits(_width))
+    , m_boundary(_width)
+{
+    // Intersections start from the top of the lattice, so that the first path
+    // to reach a block is not discarded.
+    Bits const INIT = (m_meet == Meet::Union) ? Bits(_width) : ~Bits(_width);
+    m_in.assign(_cfg.blocks().size(), INIT);
+    m_out.assign(_cfg.blocks().size(), INIT);
+}
+
+BitsetDataflow::Bits & BitsetDataflow::gen(size_t _block)
+{
+    return m_gen[_block];
+}
+
+BitsetDataflow::Bits & BitsetDataflow::kill(size_t _block)
+{
+    return m_kill[_block];
+}
+
+void BitsetDataflow::setBoundary(Bits _facts)
+{
+    m_boundary = move(_facts);
+}
+
+size_t BitsetDataflow::solve()
+{
+    bool const FORWARD = (m_dir == Direction::Forward);
+    auto const& BLOCKS = m_cfg.blocks();
+
+    // Forward problems visit in reverse post-order, and backward problems in
+    // post-order, so that most blocks see their final inputs on first visit.
+    vector<size_t> order = m_cfg.reversePostOrder();
+    if (!FORWARD) reverse(order.begin(), order.end());
+
+    vector<size_t> rank(BLOCKS.size(), BLOCKS.size());
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        rank[order[i]] = i;
+    }
+
+    // The worklist is ordered by rank, which also removes duplicates.
+    set<size_t> worklist;
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        worklist.insert(i);
+    }
+
+    size_t const START = FORWARD ? m_cfg.entry() : m_cfg.exit();
+    size_t visits = 0;
+    while (!worklist.empty())
+    {
+        size_t const BLOCK = order[*worklist.begin()];
+        worklist.erase(worklist.begin());
+        ++visits;
+
+        auto const& NODE = BLOCKS[BLOCK];
+        auto & input = FORWARD ? m_in[BLOCK] : m_out[BLOCK];
+        auto & output = FORWARD ? m_out[BLOCK] : m_in[BLOCK];
+        auto const& SOURCES = FORWARD ? NODE.preds : NODE.succs;
+        auto const& SINKS = FORWARD ? NODE.succs : NODE.preds;
+
+        // Merges the facts of all reachable neighbours.
+        bool first = true;
+        for (auto const SRC : SOURCES)
+        {
+            if (rank[SRC] == BLOCKS.size()) continue;
+
+            auto const& FACTS = FORWARD ? m_out[SRC] : m_in[SRC];
+            if (first)
+            {
+                input = FACTS;
+                first = false;
+            }
+            else if (m_meet == Meet::Union)
+            {
+                input |= FACTS;
+            }
+            else
+            {
+                input &= FACTS;
+            }
+        }
+        if (BLOCK == START)
+        {
+            if (first) input = m_boundary;
+            else if (m_meet == Meet::Union) input |= m_boundary;
+            else input &= m_boundary;
+        }
+
+        Bits next = m_gen[BLOCK] | (input - m_kill[BLOCK]);
+        if (next == output) continue;
+        output = move(next);
+
+        for (auto const SINK : SINKS)
+        {
+            if (rank[SINK] < BLOCKS.size()) worklist.insert(rank[SINK]);
+        }
+    }
+    return visits;
+}
+
+BitsetDataflow::Bits const& BitsetDataflow::in(size_t _block) const
+{
+    return m_in[_block];
+}
+
+BitsetDataflow::Bits const& BitsetDataflow::out(size_t _block) const
+{
+    return m_out[_block];
+}
+
+// -------------------------------------------------------------------------- //
+
+}
+}
@@ -0,0 +1,116 @@
+/**
+ * Many analyses over a control-flow graph are gen/kill problems: each block
+ * generates some facts, kills others, and facts are merged where paths meet.
+ * This module solves such problems once, for any finite set of facts, by
+ * encoding each set as a bitset. Blocks are revisited from a worklist ordered
+ * by reverse post-order, so most problems converge in a few passes.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Worklist dataflow over bitset lattices.
+ */
+
+#pragma once
+
+#include <libsolintent/static/ControlFlowGraph.h>
+#include <boost/dynamic_bitset.hpp>
+#include <vector>
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * A gen/kill dataflow problem over a ControlFlowGraph. Each fact is a bit, and
+ * each block transfers its input to `gen | (in - kill)`.
+ *
+ * Expected usage:
+ * 1. Construct the problem over a graph.
+ * 2. Populate gen(b) and kill(b) for each block b, and the boundary.
+ * 3. Call solve().
+ * 4. Query in(b) and out(b). Unreachable blocks keep their initial facts.
+ */
+class BitsetDataflow
+{
+public:
+    using Bits = boost::dynamic_bitset<>;
+
+    /**
+     * Describes whether facts flow with, or against, control.
+     */
+    enum class Direction { Forward, Backward };
+
+    /**
+     * Describes how facts are merged where paths meet. Union answers "along
+     * some path", whereas intersection answers "along all paths".
+     */
+    enum class Meet { Union, Intersection };
+
+    /**
+     * _cfg: the graph to analyze. It must outlive this problem.
+     * _dir: whether facts flow with, or against, control.
+     * _meet: how facts are merged where paths meet.
+     * _width: the number of distinct facts.
+     */
+    BitsetDataflow(
+        ControlFlowGraph const& _cfg, Direction _dir, Meet _meet, size_t _width
+    );
+
+    /**
+     * Returns the facts generated by a block.
+     */
+    Bits & gen(size_t _block);
+
+    /**
+     * Returns the facts killed by a block.
+     */
+    Bits & kill(size_t _block);
+
+    /**
+     * Sets the facts which hold on entry, or on exit for backward problems.
+     */
+    void setBoundary(Bits _facts);
+
+    /**
+     * Iterates to the least fixed point. Returns the number of block visits.
+     */
+    size_t solve();
+
+    /**
+     * Returns the facts which hold as control enters a block.
+     */
+    Bits const& in(size_t _block) const;
+
+    /**
+     * Returns the facts which hold as control leaves a block.
+     */
+    Bits const& out(size_t _block) const;
+
+private:
+    // The graph under analysis.
+    ControlFlowGraph const& m_cfg;
+    // Whether facts flow with, or against, control.
+    Direction const m_dir;
+    // How facts are merged where paths meet.
+    Meet const m_meet;
+    // The facts generated by each block.
+    std::vector<Bits> m_gen;
+    // The facts killed by each block.
+    std::vector<Bits> m_kill;
+    // The facts at the start of each block.
+    std::vector<Bits> m_in;
+    // The facts at the end of each block.
+    std::vector<Bits> m_out;
+    // The facts at the boundary.
+    Bits m_boundary;
+};
+
+// -------------------------------------------------------------------------- //
+
+}
+}
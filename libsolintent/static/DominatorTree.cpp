@@ -0,0 +1,129 @@
+/**
+ * A block dominates another if every path from the entry to the latter passes
+ * through the former. Dominance decides where the values of a variable must be
+ * merged, and so is the backbone of SSA construction.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Dominator trees and dominance frontiers of control-flow graphs.
+ */
+
+#include <libsolintent/static/DominatorTree.h>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+DominatorTree::DominatorTree(ControlFlowGraph const& _cfg)
+{
+    auto const& BLOCKS = _cfg.blocks();
+    auto const& RPO = _cfg.reversePostOrder();
+    size_t const NONE = BLOCKS.size();
+
+    m_rank.assign(BLOCKS.size(), NONE);
+    for (size_t i = 0; i < RPO.size(); ++i)
+    {
+        m_rank[RPO[i]] = i;
+    }
+
+    // Walks up from two blocks until their paths meet. Blocks with a lower
+    // rank are closer to the entry.
+    m_idom.assign(BLOCKS.size(), NONE);
+    auto const INTERSECT = [this](size_t _a, size_t _b) {
+        while (_a != _b)
+        {
+            while (m_rank[_a] > m_rank[_b]) _a = m_idom[_a];
+            while (m_rank[_b] > m_rank[_a]) _b = m_idom[_b];
+        }
+        return _a;
+    };
+
+    m_idom[_cfg.entry()] = _cfg.entry();
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (auto const B : RPO)
+        {
+            if (B == _cfg.entry()) continue;
+
+            size_t next = NONE;
+            for (auto const PRED : BLOCKS[B].preds)
+            {
+                if (m_idom[PRED] == NONE) continue;
+                next = (next == NONE) ? PRED : INTERSECT(PRED, next);
+            }
+
+            if (m_idom[B] != next)
+            {
+                m_idom[B] = next;
+                changed = true;
+            }
+        }
+    }
+
+    m_children.resize(BLOCKS.size());
+    for (auto const B : RPO)
+    {
+        if (B != _cfg.entry()) m_children[m_idom[B]].push_back(B);
+    }
+
+    // A join is in the frontier of each block which dominates one of its
+    // predecessors, but which does not strictly dominate the join.
+    m_frontier.resize(BLOCKS.size());
+    for (auto const B : RPO)
+    {
+        if (BLOCKS[B].preds.size() < 2) continue;
+
+        for (auto const PRED : BLOCKS[B].preds)
+        {
+            if (!reachable(PRED)) continue;
+            for (size_t run = PRED; run != m_idom[B]; run = m_idom[run])
+            {
+                m_frontier[run].insert(B);
+            }
+        }
+    }
+}
+
+bool DominatorTree::reachable(size_t _block) const
+{
+    return m_rank[_block] < m_rank.size();
+}
+
+size_t DominatorTree::idom(size_t _block) const
+{
+    return m_idom[_block];
+}
+
+vector<size_t> const& DominatorTree::children(size_t _block) const
+{
+    return m_children[_block];
+}
+
+set<size_t> const& DominatorTree::frontier(size_t _block) const
+{
+    return m_frontier[_block];
+}
+
+bool DominatorTree::dominates(size_t _a, size_t _b) const
+{
+    if (!reachable(_a) || !reachable(_b)) return false;
+
+    // Dominators always precede the blocks they dominate in reverse
+    // post-order, so the walk stops once it passes _a.
+    while (m_rank[_b] > m_rank[_a]) _b = m_idom[_b];
+    return (_a == _b);
+}
+
+// -------------------------------------------------------------------------- //
+
+}
+}
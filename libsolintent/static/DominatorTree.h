@@ -0,0 +1,80 @@
+/**
+ * A block dominates another if every path from the entry to the latter passes
+ * through the former. Dominance decides where the values of a variable must be
+ * merged, and so is the backbone of SSA construction.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Dominator trees and dominance frontiers of control-flow graphs.
+ */
+
+#pragma once
+
+#include <libsolintent/static/ControlFlowGraph.h>
+#include <set>
+#include <vector>
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * Computes the immediate dominator of each reachable block, following Cooper,
+ * Harvey and Kennedy. Unreachable blocks take no part in the tree.
+ */
+class DominatorTree
+{
+public:
+    /**
+     * _cfg: the graph to analyze. It must outlive this analysis.
+     */
+    explicit DominatorTree(ControlFlowGraph const& _cfg);
+
+    /**
+     * Returns true if _block is reachable from the entry.
+     */
+    bool reachable(size_t _block) const;
+
+    /**
+     * Returns the immediate dominator of a reachable block. The entry is its
+     * own immediate dominator.
+     */
+    size_t idom(size_t _block) const;
+
+    /**
+     * Returns the blocks immediately dominated by a block, in reverse
+     * post-order.
+     */
+    std::vector<size_t> const& children(size_t _block) const;
+
+    /**
+     * Returns the dominance frontier of a block: the blocks where its
+     * dominance ends.
+     */
+    std::set<size_t> const& frontier(size_t _block) const;
+
+    /**
+     * Returns true if _a dominates _b. Each reachable block dominates itself.
+     */
+    bool dominates(size_t _a, size_t _b) const;
+
+private:
+    // The position of each block in reverse post-order, or the block count.
+    std::vector<size_t> m_rank;
+    // The immediate dominator of each block.
+    std::vector<size_t> m_idom;
+    // The blocks immediately dominated by each block.
+    std::vector<std::vector<size_t>> m_children;
+    // The dominance frontier of each block.
+    std::vector<std::set<size_t>> m_frontier;
+};
+
+// -------------------------------------------------------------------------- //
+
+}
+}
@@ -0,0 +1,168 @@
+/**
+ * The same expression, such as `i < users.length`, appears in many loops and
+ * functions. Summarizing each occurrence separately wastes memory, and hides
+ * the repetition from any cache keyed by summary. The ExpressionTable
+ * hash-conses expression summaries, so that structurally identical summaries
+ * are represented by a single shared node.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Per-compilation table of canonical expression summaries.
+ */
+
+#include <libsolintent/static/ExpressionTable.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolintent/ir/ExpressionSummary.h>
+#include <cstdint>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+namespace
+{
+
+/**
+ * Computes the structural key of a summary. The key is empty if the summary
+ * must not be shared.
+ */
+class KeyBuilder: public IRVisitor
+{
+public:
+    /**
+     * _summary: the summary to encode.
+     */
+    explicit KeyBuilder(ExpressionSummary const& _summary)
+    {
+        _summary.acceptIR(*this);
+    }
+
+    /**
+     * Returns the structural key.
+     */
+    string const& key() const
+    {
+        return m_key;
+    }
+
+    void acceptIR(ContractSummary const&) override {}
+    void acceptIR(FunctionSummary const&) override {}
+    void acceptIR(ModifierSummary const&) override {}
+    void acceptIR(TreeBlockSummary const&) override {}
+    void acceptIR(LoopSummary const&) override {}
+    void acceptIR(BranchSummary const&) override {}
+    void acceptIR(JumpSummary const&) override {}
+    void acceptIR(PlaceholderSummary const&) override {}
+    void acceptIR(NumericExprStatement const&) override {}
+    void acceptIR(BooleanExprStatement const&) override {}
+    void acceptIR(FreshVarSummary const&) override {}
+
+    void acceptIR(NumericConstant const& _ir) override
+    {
+        auto const VAL = _ir.exact().value();
+        m_key = "n:" + VAL.numerator().str() + "/" + VAL.denominator().str();
+    }
+
+    void acceptIR(NumericVariable const& _ir) override
+    {
+        auto const REF = referenceOf(_ir.expr());
+        if (REF.empty()) return;
+
+        auto const TREND = _ir.trend();
+        m_key = "v:" + (TREND ? to_string(*TREND) : "?") + ":" + REF;
+    }
+
+    void acceptIR(BooleanConstant const& _ir) override
+    {
+        m_key = (_ir.exact().value() ? "b:1" : "b:0");
+    }
+
+    void acceptIR(BooleanVariable const& _ir) override
+    {
+        auto const REF = referenceOf(_ir.expr());
+        if (REF.empty()) return;
+
+        m_key = "p:" + REF;
+    }
+
+    void acceptIR(Comparison const& _ir) override
+    {
+        // Children are canonical, so they are identified by address.
+        auto const LHS = reinterpret_cast<uintptr_t>(_ir.lhs().get());
+        auto const RHS = reinterpret_cast<uintptr_t>(_ir.rhs().get());
+        m_key = "c:" + to_string(static_cast<int>(_ir.cond()))
+              + (_ir.strict() ? "s:" : "w:")
+              + to_string(LHS) + ":" + to_string(RHS);
+    }
+
+    void acceptIR(PushCall const&) override {}
+
+private:
+    /**
+     * Encodes the declarations named by a variable, so that distinct variables
+     * of the same name, such as the counters of two loops, are never shared.
+     * The key is empty if a declaration cannot be resolved.
+     *
+     * _expr: the identifier or member access of the variable.
+     */
+    static string referenceOf(solidity::ASTNode const& _expr)
+    {
+        // TODO: remove casts.
+        if (auto const* ID = dynamic_cast<solidity::Identifier const*>(&_expr))
+        {
+            auto const* DECL = ID->annotation().referencedDeclaration;
+            return DECL ? to_string(DECL->id()) : "";
+        }
+
+        using solidity::MemberAccess;
+        if (auto const* MEM = dynamic_cast<MemberAccess const*>(&_expr))
+        {
+            auto const BASE = referenceOf(MEM->expression());
+            return BASE.empty() ? "" : BASE + "." + MEM->memberName();
+        }
+
+        return "";
+    }
+
+    // The key under construction.
+    string m_key;
+};
+
+}
+
+// -------------------------------------------------------------------------- //
+
+size_t ExpressionTable::size() const
+{
+    return m_table.size();
+}
+
+size_t ExpressionTable::hits() const
+{
+    return m_hits;
+}
+
+SummaryPointer<ExpressionSummary> ExpressionTable::internExpr(
+    SummaryPointer<ExpressionSummary> _summary
+)
+{
+    KeyBuilder const BUILDER(*_summary);
+    if (BUILDER.key().empty()) return _summary;
+
+    auto const RESULT = m_table.emplace(BUILDER.key(), _summary);
+    if (!RESULT.second) ++m_hits;
+    return RESULT.first->second;
+}
+
+// -------------------------------------------------------------------------- //
+
+}
+}
@@ -0,0 +1,92 @@
+/**
+ * The same expression, such as `i < users.length`, appears in many loops and
+ * functions. Summarizing each occurrence separately wastes memory, and hides
+ * the repetition from any cache keyed by summary. The ExpressionTable
+ * hash-conses expression summaries, so that structurally identical summaries
+ * are represented by a single shared node.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Per-compilation table of canonical expression summaries.
+ */
+
+#pragma once
+
+#include <libsolintent/ir/ExpressionInterface.h>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * Maps the structure of each expression summary to a canonical instance. Two
+ * summaries share a structure if they are of the same kind, and agree on their
+ * value, referenced declarations, trend or operator, and on their (canonical)
+ * children. Variables are matched by declaration rather than by name, so the
+ * counters of two loops are never shared.
+ *
+ * A canonical summary wraps the first occurrence of its expression. Therefore
+ * expr() and id() identify a representative occurrence, rather than every
+ * occurrence. Summaries of side effects, such as calls to push, are never
+ * shared.
+ */
+class ExpressionTable
+{
+public:
+    /**
+     * Returns the canonical summary structurally identical to _summary. If
+     * there is no such summary, then _summary becomes canonical. Children of
+     * _summary must already be canonical.
+     *
+     * _summary: the freshly built summary.
+     */
+    template <class SummaryT>
+    SummaryPointer<SummaryT> intern(std::shared_ptr<SummaryT> _summary)
+    {
+        static_assert(
+            std::is_base_of_v<ExpressionSummary, std::remove_const_t<SummaryT>>,
+            "Only expression summaries may be interned."
+        );
+        // The key encodes the kind, so the canonical instance shares its type.
+        return std::static_pointer_cast<SummaryT const>(
+            internExpr(std::move(_summary))
+        );
+    }
+
+    /**
+     * Returns the number of canonical summaries.
+     */
+    size_t size() const;
+
+    /**
+     * Returns the number of summaries replaced by a canonical summary.
+     */
+    size_t hits() const;
+
+private:
+    /**
+     * Implements intern, without regard to the summary type.
+     */
+    SummaryPointer<ExpressionSummary> internExpr(
+        SummaryPointer<ExpressionSummary> _summary
+    );
+
+    // Maps the structural key of each summary to its canonical instance.
+    std::unordered_map<std::string, SummaryPointer<ExpressionSummary>> m_table;
+    // The number of summaries replaced by a canonical summary.
+    size_t m_hits = 0;
+};
+
+// -------------------------------------------------------------------------- //
+
+}
+}
@@ -10,6 +10,9 @@
 
 #include <libsolintent/static/FunctionChecker.h>
 
+#include <libsolidity/ast/AST.h>
+#include <libsolintent/ir/StructuralSummary.h>
+
 using namespace std;
 
 namespace dev
@@ -21,9 +24,36 @@ bool FunctionChecker::visit(solidity::FunctionDefinition const& _node)
 {
     // TODO: placeholder
     auto body = getStatementAnalyzer().check(_node.body());
-    write_to_cache(make_shared<FunctionSummary>(_node, move(body)));
+
+    // Base constructor calls are also invocations, but name a contract.
+    vector<SummaryPointer<ModifierSummary const>> modifiers;
+    for (auto const& invocation : _node.modifiers())
+    {
+        // TODO: remove cast.
+        auto const* MOD = dynamic_cast<solidity::ModifierDefinition const*>(
+            invocation->name()->annotation().referencedDeclaration
+        );
+        if (MOD) modifiers.push_back(checkModifier(*MOD));
+    }
+
+    write_to_cache(make_shared<FunctionSummary>(
+        _node, move(body), move(modifiers)
+    ));
     return false;
 }
 
+SummaryPointer<ModifierSummary> FunctionChecker::checkModifier(
+    solidity::ModifierDefinition const& _modifier
+)
+{
+    auto & summary = m_modifiers[_modifier.id()];
+    if (!summary)
+    {
+        auto body = getStatementAnalyzer().check(_modifier.body());
+        summary = make_shared<ModifierSummary>(_modifier, move(body));
+    }
+    return summary;
+}
+
 }
 }
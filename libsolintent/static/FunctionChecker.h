@@ -11,6 +11,7 @@
 #pragma once
 
 #include <libsolintent/static/AbstractFunctionAnalyzer.h>
+#include <map>
 
 namespace dev
 {
@@ -21,6 +22,20 @@ class FunctionChecker: public FunctionAnalyzer
 {
 protected:
 	bool visit(solidity::FunctionDefinition const& _node) override;
+
+private:
+	/**
+	 * Returns the summary of a modifier, which is computed on first use. All
+	 * functions which invoke the modifier share this summary.
+	 *
+	 * _modifier: the modifier to summarize.
+	 */
+	SummaryPointer<ModifierSummary> checkModifier(
+		solidity::ModifierDefinition const& _modifier
+	);
+
+	// The summary of each modifier, by modifier id.
+	std::map<SummaryKey, SummaryPointer<ModifierSummary>> m_modifiers;
 };
 
 }
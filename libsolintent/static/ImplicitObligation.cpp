@@ -30,7 +30,7 @@
 #include <libsolintent/ir/StatementSummary.h>
 #include <libsolintent/ir/StructuralSummary.h>
 
-#include <libsolintent/util/Generic.h>
+#include <set>
 #include <stdexcept>
 
 using namespace std;
@@ -42,11 +42,113 @@ namespace solintent
 
 // -------------------------------------------------------------------------- //
 
+AssertionTemplate::Context::Context(AssertionTemplate const& _tmpl)
+    : m_tmpl(_tmpl)
+{
+}
+
+void AssertionTemplate::Context::raiseAlarm()
+{
+    m_raised = true;
+}
+
+bool AssertionTemplate::Context::isRaised() const
+{
+    return m_raised;
+}
+
+void AssertionTemplate::Context::acceptIR(ContractSummary const& _ir)
+{
+    m_tmpl.inspect(_ir, *this);
+}
+
+void AssertionTemplate::Context::acceptIR(FunctionSummary const& _ir)
+{
+    m_tmpl.inspect(_ir, *this);
+}
+
+void AssertionTemplate::Context::acceptIR(ModifierSummary const& _ir)
+{
+    m_tmpl.inspect(_ir, *this);
+}
+
+void AssertionTemplate::Context::acceptIR(TreeBlockSummary const& _ir)
+{
+    m_tmpl.inspect(_ir, *this);
+}
+
+void AssertionTemplate::Context::acceptIR(LoopSummary const& _ir)
+{
+    m_tmpl.inspect(_ir, *this);
+}
+
+void AssertionTemplate::Context::acceptIR(BranchSummary const& _ir)
+{
+    m_tmpl.inspect(_ir, *this);
+}
+
+void AssertionTemplate::Context::acceptIR(JumpSummary const& _ir)
+{
+    m_tmpl.inspect(_ir, *this);
+}
+
+void AssertionTemplate::Context::acceptIR(PlaceholderSummary const& _ir)
+{
+    m_tmpl.inspect(_ir, *this);
+}
+
+void AssertionTemplate::Context::acceptIR(NumericExprStatement const& _ir)
+{
+    m_tmpl.inspect(_ir, *this);
+}
+
+void AssertionTemplate::Context::acceptIR(BooleanExprStatement const& _ir)
+{
+    m_tmpl.inspect(_ir, *this);
+}
+
+void AssertionTemplate::Context::acceptIR(FreshVarSummary const& _ir)
+{
+    m_tmpl.inspect(_ir, *this);
+}
+
+void AssertionTemplate::Context::acceptIR(NumericConstant const& _ir)
+{
+    m_tmpl.inspect(_ir, *this);
+}
+
+void AssertionTemplate::Context::acceptIR(NumericVariable const& _ir)
+{
+    m_tmpl.inspect(_ir, *this);
+}
+
+void AssertionTemplate::Context::acceptIR(BooleanConstant const& _ir)
+{
+    m_tmpl.inspect(_ir, *this);
+}
+
+void AssertionTemplate::Context::acceptIR(BooleanVariable const& _ir)
+{
+    m_tmpl.inspect(_ir, *this);
+}
+
+void AssertionTemplate::Context::acceptIR(Comparison const& _ir)
+{
+    m_tmpl.inspect(_ir, *this);
+}
+
+void AssertionTemplate::Context::acceptIR(PushCall const& _ir)
+{
+    m_tmpl.inspect(_ir, *this);
+}
+
+// -------------------------------------------------------------------------- //
+
 bool AssertionTemplate::isSuspect(
     solidity::ASTNode const& _node, AbstractAnalysisEngine & _engine
-)
+) const
 {
-    ScopedSet alarm_drop(m_found_suspect, false);
+    Context context(*this);
 
     // TODO: avoid casts
     switch (m_type)
@@ -58,14 +160,14 @@ bool AssertionTemplate::isSuspect(
     case AssertionTemplate::Type::Statement:
         {
             auto node = dynamic_cast<solidity::Statement const*>(&_node);
-            _engine.checkStatement(*node)->acceptIR(*this);
+            _engine.checkStatement(*node)->acceptIR(context);
             break;
         }
     default:
         throw runtime_error("Unknown value for type AssertionTemplate::Type.");
     }
 
-    return m_found_suspect;
+    return context.isRaised();
 }
 
 bool AssertionTemplate::isApplicableTo(solidity::ASTNode const& _node) const
@@ -104,123 +206,165 @@ string AssertionTemplate::typeAsString() const
     }
 }
 
+SyntacticFeatures AssertionTemplate::requiredFeatures() const
+{
+    return {};
+}
+
 AssertionTemplate::AssertionTemplate(AssertionTemplate::Type _type)
     : m_type(_type)
-    , m_found_suspect(false)
 {
 }
 
-void AssertionTemplate::raiseAlarm()
+void AssertionTemplate::inspect(ContractSummary const&, Context &) const
 {
-    m_found_suspect = true;
 }
 
-// -------------------------------------------------------------------------- //
+void AssertionTemplate::inspect(FunctionSummary const&, Context &) const
+{
+}
 
-detail::ProgramPattern::~ProgramPattern()
+void AssertionTemplate::inspect(ModifierSummary const&, Context &) const
 {
 }
 
-optional<int64_t> detail::ProgramPattern::abductExplanation(
-    ContractSummary const& _obligation, ContractSummary const& _locality
-)
+void AssertionTemplate::inspect(TreeBlockSummary const&, Context &) const
 {
-    throw runtime_error("The Pattern must be specialized for Contracts");
 }
 
-optional<int64_t> detail::ProgramPattern::abductExplanation(
-    FunctionSummary const& _obligation, ContractSummary const& _locality
-)
+void AssertionTemplate::inspect(LoopSummary const&, Context &) const
 {
-    throw runtime_error("The Pattern must be specialized for Functions.");
 }
 
-optional<int64_t> detail::ProgramPattern::abductExplanation(
-    StatementSummary const& _obligation, ContractSummary const& _locality
-)
+void AssertionTemplate::inspect(BranchSummary const&, Context &) const
 {
-    throw runtime_error("The Pattern must be specialized for Statements.");
 }
 
-bool detail::ProgramPattern::hasSolution() const
+void AssertionTemplate::inspect(JumpSummary const&, Context &) const
 {
-    m_solution.has_value();
 }
 
-void detail::ProgramPattern::setSolution(int64_t _sol)
+void AssertionTemplate::inspect(PlaceholderSummary const&, Context &) const
 {
-    if (hasSolution())
-    {
-        throw runtime_error("Solution already set by aduction.");
-    }
-    m_solution.emplace(_sol);
 }
 
-void detail::ProgramPattern::aggregate()
+void AssertionTemplate::inspect(NumericExprStatement const&, Context &) const
 {
 }
 
-void detail::ProgramPattern::setObligation(ContractSummary const&)
+void AssertionTemplate::inspect(BooleanExprStatement const&, Context &) const
 {
 }
 
-void detail::ProgramPattern::setObligation(FunctionSummary const& _ir)
+void AssertionTemplate::inspect(FreshVarSummary const&, Context &) const
 {
 }
 
-void detail::ProgramPattern::setObligation(TreeBlockSummary const&)
+void AssertionTemplate::inspect(NumericConstant const&, Context &) const
 {
 }
 
-void detail::ProgramPattern::setObligation(LoopSummary const& _ir)
+void AssertionTemplate::inspect(NumericVariable const&, Context &) const
 {
 }
 
-void detail::ProgramPattern::setObligation(NumericExprStatement const&)
+void AssertionTemplate::inspect(BooleanConstant const&, Context &) const
 {
 }
 
-void detail::ProgramPattern::setObligation(BooleanExprStatement const&)
+void AssertionTemplate::inspect(BooleanVariable const&, Context &) const
 {
 }
 
-void detail::ProgramPattern::setObligation(FreshVarSummary const&)
+void AssertionTemplate::inspect(Comparison const&, Context &) const
 {
 }
 
-void detail::ProgramPattern::abductFrom(ContractSummary const&)
+void AssertionTemplate::inspect(PushCall const&, Context &) const
 {
 }
 
-void detail::ProgramPattern::abductFrom(FunctionSummary const&)
+// -------------------------------------------------------------------------- //
+
+detail::ProgramPattern::Context::Context(
+    ProgramPattern const& _pattern, unique_ptr<State> _state
+)
+    : m_pattern(_pattern)
+    , m_state(move(_state))
 {
 }
 
-void detail::ProgramPattern::abductFrom(TreeBlockSummary const&)
+void detail::ProgramPattern::Context::propagate(
+    IRDestination const& _obligation
+)
 {
+    m_setting_obligation = true;
+    _obligation.acceptIR(*this);
+    m_setting_obligation = false;
 }
 
-void detail::ProgramPattern::abductFrom(LoopSummary const& )
+void detail::ProgramPattern::Context::abduct(ContractSummary const& _locality)
 {
+    if (m_criterion)
+    {
+        m_slice.emplace(*m_criterion, _locality);
+    }
+    _locality.acceptIR(*this);
 }
 
-void detail::ProgramPattern::abductFrom(NumericExprStatement const&)
+optional<int64_t> const& detail::ProgramPattern::Context::solution() const
 {
+    return m_solution;
 }
 
-void detail::ProgramPattern::abductFrom(BooleanExprStatement const&)
+bool detail::ProgramPattern::Context::hasSolution() const
 {
+    return m_solution.has_value();
 }
 
-void detail::ProgramPattern::abductFrom(FreshVarSummary const&)
+void detail::ProgramPattern::Context::setSolution(int64_t _sol)
 {
+    if (hasSolution())
+    {
+        throw runtime_error("Solution already set by aduction.");
+    }
+    m_solution.emplace(_sol);
 }
 
-void detail::ProgramPattern::acceptIR(ContractSummary const& _ir)
+void detail::ProgramPattern::Context::acceptIR(ContractSummary const& _ir)
 {
     if (dispatchIR(_ir))
     {
-        for (size_t i = 0; i < _ir.summaryLength(); ++i)
+        // Only functions which are relevant, and in the slice, are summarized.
+        set<size_t> funcs;
+        auto const RELEVANT = m_pattern.relevantState(*this);
+        if (RELEVANT.has_value())
+        {
+            for (auto const* var : RELEVANT.value())
+            {
+                auto const& WRITERS = _ir.writersOf(*var);
+                funcs.insert(WRITERS.begin(), WRITERS.end());
+            }
+        }
+        else
+        {
+            for (size_t i = 0; i < _ir.summaryLength(); ++i)
+            {
+                funcs.insert(i);
+            }
+        }
+
+        if (m_slice.has_value())
+        {
+            set<size_t> sliced;
+            for (auto const i : m_slice->functions())
+            {
+                if (funcs.count(i) > 0) sliced.insert(i);
+            }
+            swap(funcs, sliced);
+        }
+
+        for (auto const i : funcs)
         {
             // TODO: wait, why did I make this a ref? (see below)
             _ir.get(i).acceptIR(*this);
@@ -228,69 +372,313 @@ void detail::ProgramPattern::acceptIR(ContractSummary const& _ir)
     }
 }
 
-void detail::ProgramPattern::acceptIR(FunctionSummary const& _ir)
+void detail::ProgramPattern::Context::acceptIR(FunctionSummary const& _ir)
+{
+    if (dispatchIR(_ir))
+    {
+        m_splices.push_back({ &_ir, 0 });
+        splice();
+        m_splices.pop_back();
+    }
+}
+
+void detail::ProgramPattern::Context::acceptIR(ModifierSummary const& _ir)
 {
     if (dispatchIR(_ir))
     {
+        bool const OUTER = m_in_modifier;
+        m_in_modifier = true;
         _ir.body().acceptIR(*this);
+        m_in_modifier = OUTER;
     }
 }
 
-void detail::ProgramPattern::acceptIR(TreeBlockSummary const& _ir)
+void detail::ProgramPattern::Context::acceptIR(TreeBlockSummary const& _ir)
 {
     if (dispatchIR(_ir))
     {
         for (size_t i = 0; i < _ir.summaryLength(); ++i)
         {
-            _ir.get(i)->acceptIR(*this);
+            auto const STMT = _ir.get(i);
+            if (m_slice.has_value() && !m_in_modifier)
+            {
+                if (!m_slice->contains(STMT->id())) continue;
+            }
+            STMT->acceptIR(*this);
         }
     }
 }
 
-void detail::ProgramPattern::acceptIR(LoopSummary const& _ir)
+void detail::ProgramPattern::Context::acceptIR(LoopSummary const& _ir)
 {
+    if (m_setting_obligation)
+    {
+        m_criterion = (&_ir);
+    }
+
     if (dispatchIR(_ir))
     {
         _ir.body().acceptIR(*this);
     }
 }
 
-void detail::ProgramPattern::acceptIR(NumericExprStatement const& _ir)
+void detail::ProgramPattern::Context::acceptIR(BranchSummary const& _ir)
+{
+    if (dispatchIR(_ir))
+    {
+        vector<StatementSummary const*> const BRANCHES{
+            &_ir.trueBranch(), _ir.falseBranch()
+        };
+        for (auto const* branch : BRANCHES)
+        {
+            if (!branch) continue;
+            if (m_slice.has_value() && !m_in_modifier)
+            {
+                if (!m_slice->contains(branch->id())) continue;
+            }
+            branch->acceptIR(*this);
+        }
+    }
+}
+
+void detail::ProgramPattern::Context::acceptIR(JumpSummary const& _ir)
+{
+    dispatchIR(_ir);
+}
+
+void detail::ProgramPattern::Context::acceptIR(PlaceholderSummary const& _ir)
+{
+    if (dispatchIR(_ir) && !m_splices.empty())
+    {
+        bool const OUTER = m_in_modifier;
+        m_in_modifier = false;
+        splice();
+        m_in_modifier = OUTER;
+    }
+}
+
+void detail::ProgramPattern::Context::acceptIR(NumericExprStatement const& _ir)
 {
     dispatchIR(_ir);
 }
 
-void detail::ProgramPattern::acceptIR(BooleanExprStatement const& _ir)
+void detail::ProgramPattern::Context::acceptIR(BooleanExprStatement const& _ir)
 {
     dispatchIR(_ir);
 }
 
-void detail::ProgramPattern::acceptIR(FreshVarSummary const& _ir)
+void detail::ProgramPattern::Context::acceptIR(FreshVarSummary const& _ir)
 {
     dispatchIR(_ir);
 }
 
-void detail::ProgramPattern::acceptIR(NumericConstant const&)
+void detail::ProgramPattern::Context::acceptIR(NumericConstant const&)
 {
 }
 
-void detail::ProgramPattern::acceptIR(NumericVariable const&)
+void detail::ProgramPattern::Context::acceptIR(NumericVariable const&)
 {
 }
 
-void detail::ProgramPattern::acceptIR(BooleanConstant const&)
+void detail::ProgramPattern::Context::acceptIR(BooleanConstant const&)
 {
 }
 
-void detail::ProgramPattern::acceptIR(BooleanVariable const&)
+void detail::ProgramPattern::Context::acceptIR(BooleanVariable const&)
 {
 }
 
-void detail::ProgramPattern::acceptIR(Comparison const&)
+void detail::ProgramPattern::Context::acceptIR(Comparison const&)
 {
 }
 
-void detail::ProgramPattern::acceptIR(PushCall const&)
+void detail::ProgramPattern::Context::acceptIR(PushCall const&)
+{
+}
+
+void detail::ProgramPattern::Context::splice()
+{
+    auto const* FUNC = m_splices.back().first;
+    size_t const DEPTH = m_splices.back().second;
+
+    auto const& MODIFIERS = FUNC->modifiers();
+    if (DEPTH < MODIFIERS.size())
+    {
+        ++m_splices.back().second;
+        MODIFIERS[DEPTH]->acceptIR(*this);
+        --m_splices.back().second;
+    }
+    else
+    {
+        FUNC->body().acceptIR(*this);
+    }
+}
+
+// -------------------------------------------------------------------------- //
+
+detail::ProgramPattern::~ProgramPattern()
+{
+}
+
+optional<int64_t> detail::ProgramPattern::abductExplanation(
+    ContractSummary const& _obligation, ContractSummary const& _locality
+) const
+{
+    throw runtime_error("The Pattern must be specialized for Contracts");
+}
+
+optional<int64_t> detail::ProgramPattern::abductExplanation(
+    FunctionSummary const& _obligation, ContractSummary const& _locality
+) const
+{
+    throw runtime_error("The Pattern must be specialized for Functions.");
+}
+
+optional<int64_t> detail::ProgramPattern::abductExplanation(
+    StatementSummary const& _obligation, ContractSummary const& _locality
+) const
+{
+    throw runtime_error("The Pattern must be specialized for Statements.");
+}
+
+optional<int64_t> detail::ProgramPattern::run(
+    IRDestination const& _obligation, ContractSummary const& _locality
+) const
+{
+    Context context(*this, makeState());
+    context.propagate(_obligation);
+    context.abduct(_locality);
+    aggregate(context);
+    return context.solution();
+}
+
+unique_ptr<detail::ProgramPattern::State>
+    detail::ProgramPattern::makeState() const
+{
+    return nullptr;
+}
+
+optional<vector<solidity::VariableDeclaration const*>>
+    detail::ProgramPattern::relevantState(Context &) const
+{
+    return nullopt;
+}
+
+void detail::ProgramPattern::aggregate(Context &) const
+{
+}
+
+void detail::ProgramPattern::setObligation(
+    ContractSummary const&, Context &
+) const
+{
+}
+
+void detail::ProgramPattern::setObligation(
+    FunctionSummary const&, Context &
+) const
+{
+}
+
+void detail::ProgramPattern::setObligation(
+    ModifierSummary const&, Context &
+) const
+{
+}
+
+void detail::ProgramPattern::setObligation(
+    TreeBlockSummary const&, Context &
+) const
+{
+}
+
+void detail::ProgramPattern::setObligation(LoopSummary const&, Context &) const
+{
+}
+
+void detail::ProgramPattern::setObligation(
+    BranchSummary const&, Context &
+) const
+{
+}
+
+void detail::ProgramPattern::setObligation(JumpSummary const&, Context &) const
+{
+}
+
+void detail::ProgramPattern::setObligation(
+    PlaceholderSummary const&, Context &
+) const
+{
+}
+
+void detail::ProgramPattern::setObligation(
+    NumericExprStatement const&, Context &
+) const
+{
+}
+
+void detail::ProgramPattern::setObligation(
+    BooleanExprStatement const&, Context &
+) const
+{
+}
+
+void detail::ProgramPattern::setObligation(
+    FreshVarSummary const&, Context &
+) const
+{
+}
+
+void detail::ProgramPattern::abductFrom(ContractSummary const&, Context &) const
+{
+}
+
+void detail::ProgramPattern::abductFrom(FunctionSummary const&, Context &) const
+{
+}
+
+void detail::ProgramPattern::abductFrom(ModifierSummary const&, Context &) const
+{
+}
+
+void detail::ProgramPattern::abductFrom(
+    TreeBlockSummary const&, Context &
+) const
+{
+}
+
+void detail::ProgramPattern::abductFrom(LoopSummary const&, Context &) const
+{
+}
+
+void detail::ProgramPattern::abductFrom(BranchSummary const&, Context &) const
+{
+}
+
+void detail::ProgramPattern::abductFrom(JumpSummary const&, Context &) const
+{
+}
+
+void detail::ProgramPattern::abductFrom(
+    PlaceholderSummary const&, Context &
+) const
+{
+}
+
+void detail::ProgramPattern::abductFrom(
+    NumericExprStatement const&, Context &
+) const
+{
+}
+
+void detail::ProgramPattern::abductFrom(
+    BooleanExprStatement const&, Context &
+) const
+{
+}
+
+void detail::ProgramPattern::abductFrom(FreshVarSummary const&, Context &) const
 {
 }
 
@@ -299,13 +687,14 @@ void detail::ProgramPattern::acceptIR(PushCall const&)
 ImplicitObligation::ImplicitObligation(
     string _name,
     string _desc,
-    shared_ptr<AssertionTemplate> _tmpl,
+    shared_ptr<AssertionTemplate const> _tmpl,
     AbstractAnalysisEngine & _engine
 )
     : m_engine(_engine)
     , m_name(_name)
     , m_desc(move(_desc))
     , m_tmpl(move(_tmpl))
+    , m_required(m_tmpl->requiredFeatures())
 {
 }
 
@@ -321,6 +710,15 @@ void ImplicitObligation::computeSuspects(
     }
 }
 
+void ImplicitObligation::computeSuspects(
+    solidity::ContractDefinition const& _contract
+)
+{
+    m_suspects.clear();
+    m_context = nullptr;
+    _contract.accept(*this);
+}
+
 vector<ImplicitObligation::Suspect> ImplicitObligation::findSuspects() const
 {
     return m_suspects;
@@ -343,6 +741,22 @@ bool ImplicitObligation::visit(solidity::ContractDefinition const& _node)
     return true;
 }
 
+bool ImplicitObligation::visit(solidity::FunctionDefinition const& _node)
+{
+    // The scan is syntactic, so skipped functions never reach the engine.
+    m_skip_function = !SyntacticFeatures::of(_node).covers(m_required);
+    return !m_skip_function;
+}
+
+void ImplicitObligation::endVisit(solidity::FunctionDefinition const& _node)
+{
+    if (!m_skip_function)
+    {
+        endVisitNode(_node);
+    }
+    m_skip_function = false;
+}
+
 // -------------------------------------------------------------------------- //
 
 }
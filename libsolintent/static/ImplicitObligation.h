@@ -30,10 +30,14 @@
 #include <libsolintent/ir/StructuralSummary.h>
 #include <libsolintent/ir/IRVisitor.h>
 #include <libsolintent/static/AnalysisEngine.h>
+#include <libsolintent/static/ProgramSlice.h>
+#include <libsolintent/static/SyntacticFeatures.h>
 #include <libsolintent/util/Generic.h>
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace dev
@@ -48,8 +52,12 @@ namespace solintent
  * Solidity program. Given a resolution to the proof obligation, the template
  * can generate a program patch to remove the obligation in future verification.
  * This may resolve (or impose) other obligations.
+ *
+ * A template holds no state between, or during, inspections. All state of an
+ * inspection lives in its Context, so a single instance may be shared by every
+ * thread.
  */
-class AssertionTemplate: protected IRVisitor
+class AssertionTemplate
 {
 public:
     /**
@@ -58,6 +66,57 @@ public:
      */
     enum class Type { Contract, Function, Statement };
 
+    /**
+     * The state of a single inspection. The context is also the visitor which
+     * walks the IR, and it forwards each node to the inspect hooks of its
+     * template.
+     */
+    class Context: public IRVisitor
+    {
+    public:
+        /**
+         * _tmpl: the template which receives each node.
+         */
+        explicit Context(AssertionTemplate const& _tmpl);
+
+        /**
+         * Called when a suspect has been detected. Repeated calls are
+         * equivalent to a single call.
+         */
+        void raiseAlarm();
+
+        /**
+         * Returns true if an alarm has been raised.
+         */
+        bool isRaised() const;
+
+        void acceptIR(ContractSummary const& _ir) override;
+        void acceptIR(FunctionSummary const& _ir) override;
+        void acceptIR(ModifierSummary const& _ir) override;
+        void acceptIR(TreeBlockSummary const& _ir) override;
+        void acceptIR(LoopSummary const& _ir) override;
+        void acceptIR(BranchSummary const& _ir) override;
+        void acceptIR(JumpSummary const& _ir) override;
+        void acceptIR(PlaceholderSummary const& _ir) override;
+        void acceptIR(NumericExprStatement const& _ir) override;
+        void acceptIR(BooleanExprStatement const& _ir) override;
+        void acceptIR(FreshVarSummary const& _ir) override;
+        void acceptIR(NumericConstant const& _ir) override;
+        void acceptIR(NumericVariable const& _ir) override;
+        void acceptIR(BooleanConstant const& _ir) override;
+        void acceptIR(BooleanVariable const& _ir) override;
+        void acceptIR(Comparison const& _ir) override;
+        void acceptIR(PushCall const& _ir) override;
+
+    private:
+        // The template under evaluation.
+        AssertionTemplate const& m_tmpl;
+        // Is true if and only if a suspect was detected.
+        bool m_raised = false;
+    };
+
+    virtual ~AssertionTemplate() = default;
+
     /**
      * Runs the rule against the given ASTNode. If the _node is suspect, then
      * true is returned. Results are only valid if isApplicableTo(_node) yields
@@ -68,7 +127,7 @@ public:
      */
     bool isSuspect(
         solidity::ASTNode const& _node, AbstractAnalysisEngine & _engine
-    );
+    ) const;
 
     /**
      * Returns true if the rule applies to a given construct.
@@ -82,6 +141,13 @@ public:
      */
     std::string typeAsString() const;
 
+    /**
+     * Returns the syntactic features which any suspect must contain. Functions
+     * without these features are skipped before any IR is built. By default,
+     * no features are required.
+     */
+    virtual SyntacticFeatures requiredFeatures() const;
+
 protected:
     /**
      * _type: the type that will be used when checking applicability.
@@ -89,16 +155,36 @@ protected:
     AssertionTemplate(AssertionTemplate::Type _type);
 
     /**
-     * Called when a suspect has been detected. Repeated calls are equivalent to
-     * a single call.
+     * Inspects a single IR node. Alarms are raised through _ctx. To inspect the
+     * children of a node, pass _ctx to their acceptIR methods. By default, each
+     * node is ignored.
+     *
+     * _ir: the node to inspect.
+     * _ctx: the state of the current inspection.
      */
-    void raiseAlarm();
+    virtual void inspect(ContractSummary const& _ir, Context & _ctx) const;
+    virtual void inspect(FunctionSummary const& _ir, Context & _ctx) const;
+    virtual void inspect(ModifierSummary const& _ir, Context & _ctx) const;
+    virtual void inspect(TreeBlockSummary const& _ir, Context & _ctx) const;
+    virtual void inspect(LoopSummary const& _ir, Context & _ctx) const;
+    virtual void inspect(BranchSummary const& _ir, Context & _ctx) const;
+    virtual void inspect(JumpSummary const& _ir, Context & _ctx) const;
+    virtual void inspect(
+        PlaceholderSummary const& _ir, Context & _ctx
+    ) const;
+    virtual void inspect(NumericExprStatement const& _ir, Context & _ctx) const;
+    virtual void inspect(BooleanExprStatement const& _ir, Context & _ctx) const;
+    virtual void inspect(FreshVarSummary const& _ir, Context & _ctx) const;
+    virtual void inspect(NumericConstant const& _ir, Context & _ctx) const;
+    virtual void inspect(NumericVariable const& _ir, Context & _ctx) const;
+    virtual void inspect(BooleanConstant const& _ir, Context & _ctx) const;
+    virtual void inspect(BooleanVariable const& _ir, Context & _ctx) const;
+    virtual void inspect(Comparison const& _ir, Context & _ctx) const;
+    virtual void inspect(PushCall const& _ir, Context & _ctx) const;
 
 private:
     // The type of code fragment this template should be applied to.
     AssertionTemplate::Type const m_type;
-    // Is true if and only if a suspect was detected on the current inspection.
-    bool m_found_suspect;
 };
 
 // -------------------------------------------------------------------------- //
@@ -108,10 +194,148 @@ namespace detail
 /**
  * An interface used to abduct a proof for an associated assertion template.
  * This is a detail as it is not specialized to any given obligaiton.
+ *
+ * A pattern holds no state between, or during, abductions. All state of an
+ * abduction lives in its Context, so a single instance may be shared by every
+ * thread. Patterns which require scratch space provide it through makeState.
  */
-class ProgramPattern: protected IRVisitor
+class ProgramPattern
 {
 public:
+    /**
+     * The scratch space of a single abduction. Patterns extend this to hold
+     * their own intermediate results.
+     */
+    struct State
+    {
+        virtual ~State() = default;
+    };
+
+    /**
+     * The state of a single abduction. The context is also the visitor which
+     * walks the IR, and it forwards each node to the hooks of its pattern.
+     */
+    class Context: public IRVisitor
+    {
+    public:
+        /**
+         * _pattern: the pattern which receives each node.
+         * _state: the scratch space of the pattern, if any.
+         */
+        Context(ProgramPattern const& _pattern, std::unique_ptr<State> _state);
+
+        /**
+         * Walks the obligation, to propogate it into the pattern.
+         *
+         * _obligation: the IR of the obligation.
+         */
+        void propagate(IRDestination const& _obligation);
+
+        /**
+         * Walks the locality, to abduct a solution from it. If the obligation
+         * is a loop, then only the slice of the locality which may affect its
+         * termination condition is walked.
+         *
+         * _locality: the IR of the surrounding contract.
+         */
+        void abduct(ContractSummary const& _locality);
+
+        /**
+         * Returns the abducted solution, if any.
+         */
+        std::optional<int64_t> const& solution() const;
+
+        /**
+         * Returns true if the solution has been set.
+         */
+        bool hasSolution() const;
+
+        /**
+         * Sets the solution, if one has not been set. If a solution is set
+         * twice, then an exception is raised.
+         *
+         * _sol: the solution
+         */
+        void setSolution(int64_t _sol);
+
+        /**
+         * Returns the scratch space of the pattern. StateT must be the type
+         * produced by the pattern's makeState.
+         */
+        template <class StateT>
+        StateT & state()
+        {
+            return static_cast<StateT &>(*m_state);
+        }
+
+        void acceptIR(ContractSummary const& _ir) override;
+        void acceptIR(FunctionSummary const& _ir) override;
+        void acceptIR(ModifierSummary const& _ir) override;
+        void acceptIR(TreeBlockSummary const& _ir) override;
+        void acceptIR(LoopSummary const& _ir) override;
+        void acceptIR(BranchSummary const& _ir) override;
+        void acceptIR(JumpSummary const& _ir) override;
+        void acceptIR(PlaceholderSummary const& _ir) override;
+        void acceptIR(NumericExprStatement const& _ir) override;
+        void acceptIR(BooleanExprStatement const& _ir) override;
+        void acceptIR(FreshVarSummary const& _ir) override;
+        void acceptIR(NumericConstant const&) override;
+        void acceptIR(NumericVariable const&) override;
+        void acceptIR(BooleanConstant const&) override;
+        void acceptIR(BooleanVariable const&) override;
+        void acceptIR(Comparison const&) override;
+        void acceptIR(PushCall const&) override;
+
+    private:
+        /**
+         * Visits the next modifier of the innermost splice, or the function
+         * body once all of its modifiers have been entered.
+         */
+        void splice();
+
+        /**
+         * Used to determine which hook of the pattern should receive _ir. This
+         * depends on whether or not this is the obligation propogation stage.
+         * Returns true if the children of _ir should be visited.
+         * 
+         * _ir: the IR node to visit.
+         */
+        template <class T>
+        bool dispatchIR(T const& _ir)
+        {
+            if (m_setting_obligation)
+            {
+                m_pattern.clearObligation(*this);
+                m_pattern.setObligation(_ir, *this);
+                return false;
+            }
+            else
+            {
+                m_pattern.abductFrom(_ir, *this);
+                return true;
+            }
+        }
+
+        // The pattern under evaluation.
+        ProgramPattern const& m_pattern;
+        // The scratch space of the pattern.
+        std::unique_ptr<State> m_state;
+        // The aducted solution.
+        std::optional<int64_t> m_solution;
+        // True if the obligation is being set.
+        bool m_setting_obligation = false;
+        // The loop obligation, if any, used as the slicing criterion.
+        LoopSummary const* m_criterion = nullptr;
+        // The slice of the locality, once the obligation is a loop.
+        std::optional<ProgramSlice> m_slice;
+        // The functions whose modifiers are being spliced, innermost last,
+        // each with the number of its modifiers entered so far.
+        std::vector<std::pair<FunctionSummary const*, size_t>> m_splices;
+        // True while visiting the body of a modifier. The slice only covers
+        // functions, so the statements of a modifier are never filtered.
+        bool m_in_modifier = false;
+    };
+
     /**
      * This method will try to dispatch the properly typed obligation. It will
      * use the local scope of the contract to abduct a solution.
@@ -121,99 +345,76 @@ public:
      */
     virtual std::optional<int64_t> abductExplanation(
         ContractSummary const& _obligation, ContractSummary const& _locality
-    );
+    ) const;
     virtual std::optional<int64_t> abductExplanation(
         FunctionSummary const& _obligation, ContractSummary const& _locality
-    );
+    ) const;
     virtual std::optional<int64_t> abductExplanation(
         StatementSummary const& _obligation, ContractSummary const& _locality
-    );
+    ) const;
 
     virtual ~ProgramPattern() = 0;
 
 protected:
     /**
-     * Returns true if the solution has been set.
+     * Runs a full abduction: the obligation is propogated, the locality is
+     * searched, and then the results are aggregated.
+     *
+     * _obligation: the IR of the obligation.
+     * _locality: the IR of the surrounding contract.
      */
-    bool hasSolution() const;
+    std::optional<int64_t> run(
+        IRDestination const& _obligation, ContractSummary const& _locality
+    ) const;
 
     /**
-     * Sets the solution, if one has not been set. If a solution is set twice,
-     * then an exception is raised.
-     * 
-     * _sol: the exception
+     * Returns fresh scratch space for a single abduction. By default, patterns
+     * have no scratch space.
      */
-    void setSolution(int64_t _sol);
+    virtual std::unique_ptr<State> makeState() const;
 
     /**
-     * Allows for a callback once the analysis has ended.
+     * Returns the state variables on which the current obligation depends. If
+     * set, then abduction only searches the functions which write to these
+     * variables, and all other functions are never summarized. By default, all
+     * functions are searched.
      */
-    virtual void aggregate();
+    virtual std::optional<std::vector<solidity::VariableDeclaration const*>>
+        relevantState(Context & _ctx) const;
 
     /**
-     * Forces the pattern to clear its old obligation.
+     * Allows for a callback once the analysis has ended.
      */
-    virtual void clearObligation() = 0;
-
-    virtual void setObligation(ContractSummary const&);
-    virtual void setObligation(FunctionSummary const& _ir);
-    virtual void setObligation(TreeBlockSummary const&);
-    virtual void setObligation(LoopSummary const& _ir);
-    virtual void setObligation(NumericExprStatement const&);
-    virtual void setObligation(BooleanExprStatement const&);
-    virtual void setObligation(FreshVarSummary const&);
-
-    virtual void abductFrom(ContractSummary const&);
-    virtual void abductFrom(FunctionSummary const& _ir);
-    virtual void abductFrom(TreeBlockSummary const&);
-    virtual void abductFrom(LoopSummary const& _ir);
-    virtual void abductFrom(NumericExprStatement const&);
-    virtual void abductFrom(BooleanExprStatement const&);
-    virtual void abductFrom(FreshVarSummary const&);
+    virtual void aggregate(Context & _ctx) const;
 
     /**
-     * Used to determine which implmentation of acceptIR the derived policy
-     * should apply. This depends on whether or not this is the obligation
-     * propogation stage.
-     * 
-     * _ir: the IR node to visit.
+     * Forces the pattern to clear its old obligation.
      */
-    template <class T>
-    bool dispatchIR(T const& _ir)
-    {
-        if (m_setting_obligation)
-        {
-            clearObligation();
-            setObligation(_ir);
-            return false;
-        }
-        else
-        {
-            abductFrom(_ir);
-            return true;
-        }
-    }
-
-    void acceptIR(ContractSummary const& _ir);
-    void acceptIR(FunctionSummary const& _ir);
-    void acceptIR(TreeBlockSummary const& _ir);
-    void acceptIR(LoopSummary const& _ir);
-    void acceptIR(NumericExprStatement const& _ir);
-    void acceptIR(BooleanExprStatement const& _ir);
-    void acceptIR(FreshVarSummary const& _ir);
-
-    void acceptIR(NumericConstant const&);
-    void acceptIR(NumericVariable const&);
-    void acceptIR(BooleanConstant const&);
-    void acceptIR(BooleanVariable const&);
-    void acceptIR(Comparison const&);
-    void acceptIR(PushCall const&);
-
-public:
-    // The aducted solution.
-    std::optional<int64_t> m_solution{std::nullopt};
-    // True if the obligation is being set.
-    bool m_setting_obligation{false};
+    virtual void clearObligation(Context & _ctx) const = 0;
+
+    virtual void setObligation(ContractSummary const&, Context &) const;
+    virtual void setObligation(FunctionSummary const&, Context &) const;
+    virtual void setObligation(ModifierSummary const&, Context &) const;
+    virtual void setObligation(TreeBlockSummary const&, Context &) const;
+    virtual void setObligation(LoopSummary const&, Context &) const;
+    virtual void setObligation(BranchSummary const&, Context &) const;
+    virtual void setObligation(JumpSummary const&, Context &) const;
+    virtual void setObligation(PlaceholderSummary const&, Context &) const;
+    virtual void setObligation(NumericExprStatement const&, Context &) const;
+    virtual void setObligation(BooleanExprStatement const&, Context &) const;
+    virtual void setObligation(FreshVarSummary const&, Context &) const;
+
+    virtual void abductFrom(ContractSummary const&, Context &) const;
+    virtual void abductFrom(FunctionSummary const&, Context &) const;
+    virtual void abductFrom(ModifierSummary const&, Context &) const;
+    virtual void abductFrom(TreeBlockSummary const&, Context &) const;
+    virtual void abductFrom(LoopSummary const&, Context &) const;
+    virtual void abductFrom(BranchSummary const&, Context &) const;
+    virtual void abductFrom(JumpSummary const&, Context &) const;
+    virtual void abductFrom(PlaceholderSummary const&, Context &) const;
+    virtual void abductFrom(NumericExprStatement const&, Context &) const;
+    virtual void abductFrom(BooleanExprStatement const&, Context &) const;
+    virtual void abductFrom(FreshVarSummary const&, Context &) const;
 };
 
 /**
@@ -225,30 +426,18 @@ template <typename SummaryT>
 class SpecializedPattern: public ProgramPattern
 {
 public:
+    using ProgramPattern::abductExplanation;
+
     std::optional<int64_t> abductExplanation(
         SummaryT const& _obligation, ContractSummary const& _locality
-    ) override
+    ) const override
     {
-        ScopedSet solutionGuard(m_solution, std::optional<int64_t>{});
-        {
-            ScopedSet scope(m_setting_obligation, true);
-            _obligation.acceptIR(*this);
-        }
-        {
-            ScopedSet scope(m_setting_obligation, false);
-            _locality.acceptIR(*this);
-        }
-        aggregate();
-        return m_solution;
+        return run(_obligation, _locality);
     }
 
     virtual ~SpecializedPattern()
     {
     }
-
-private:
-    // Hides the solution raw data from concrete implementations.
-    using ProgramPattern::m_solution;
 };
 }
 
@@ -285,7 +474,7 @@ public:
     ImplicitObligation(
         std::string _name,
         std::string _desc,
-        std::shared_ptr<AssertionTemplate> _tmpl,
+        std::shared_ptr<AssertionTemplate const> _tmpl,
         AbstractAnalysisEngine & _engine
     );
 
@@ -314,6 +503,14 @@ public:
         std::vector<solidity::SourceUnit const*> const& _fullprog
     );
 
+    /**
+     * Equivalent to computeSuspects, but restricted to a single contract. This
+     * allows suspects to be consumed as soon as each contract is inspected.
+     * 
+     * _contract: the contract to inspect.
+     */
+    void computeSuspects(solidity::ContractDefinition const& _contract);
+
     /**
      * Using the assertion templates, this will generate a list of suspicious
      * statements. These are implicit obligations which must be dispatched.
@@ -328,15 +525,22 @@ private:
     // A "human-readable" description of this obligation.
     std::string m_desc;
     // The template used to nominate and elect assertion candidates.
-    std::shared_ptr<AssertionTemplate> m_tmpl;
+    std::shared_ptr<AssertionTemplate const> m_tmpl;
     // The current set of candidate suspects.
     std::vector<Suspect> m_suspects;
     // The contract under inspection.
     solidity::ContractDefinition const* m_context;
+    // The features required by m_tmpl.
+    SyntacticFeatures m_required;
+    // True if the function under inspection lacks the required features.
+    bool m_skip_function = false;
 
     void endVisitNode(solidity::ASTNode const& _node) override;
 
     bool visit(solidity::ContractDefinition const& _node) override;
+
+    bool visit(solidity::FunctionDefinition const& _node) override;
+    void endVisit(solidity::FunctionDefinition const& _node) override;
 };
 
 // -------------------------------------------------------------------------- //
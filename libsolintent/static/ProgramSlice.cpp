@@ -0,0 +1,224 @@
+/**
+ * A pattern searches the locality of an obligation for evidence. Most of a
+ * large contract is unrelated to any single loop, yet a full search visits all
+ * of it. This module computes a slice of the locality: the functions and
+ * statements which may affect the termination condition of a loop. Abduction
+ * then searches only the slice.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Program slicing over the writes of a contract.
+ */
+
+#include <libsolintent/static/ProgramSlice.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
+#include <libsolintent/ir/StatementSummary.h>
+#include <libsolintent/ir/StructuralSummary.h>
+#include <libsolintent/static/CallGraph.h>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+namespace
+{
+
+/**
+ * Collects the state variables read by an expression. Internal calls are
+ * followed, so that a read through a helper, such as `i < count()`, is found.
+ * A call to a virtual helper follows the override which the contract runs.
+ */
+class StateReadCollector: public solidity::ASTConstVisitor
+{
+public:
+    /**
+     * _reads: the list to extend with each state variable read.
+     * _dispatch: the functions run by the contract, so that a call to a
+     *            virtual helper follows its override.
+     */
+    StateReadCollector(
+        vector<solidity::VariableDeclaration const*> & _reads,
+        CallGraph::Dispatch const& _dispatch
+    )
+        : m_reads(_reads), m_dispatch(_dispatch)
+    {
+    }
+
+    /**
+     * Returns true if some call could not be followed, in which case the reads
+     * are incomplete.
+     */
+    bool opaque() const
+    {
+        return m_opaque;
+    }
+
+protected:
+    bool visit(solidity::Identifier const& _node) override
+    {
+        auto const* DECL = dynamic_cast<solidity::VariableDeclaration const*>(
+            _node.annotation().referencedDeclaration
+        );
+        if (DECL && DECL->isStateVariable())
+        {
+            m_reads.push_back(DECL);
+        }
+        return false;
+    }
+
+    bool visit(solidity::FunctionCall const& _node) override
+    {
+        // Type conversions and struct constructors have no function type.
+        // TODO: remove cast.
+        auto const* TYPE = dynamic_cast<solidity::FunctionType const*>(
+            _node.expression().annotation().type
+        );
+        if (!TYPE) return true;
+
+        if (auto const* CALLEE = CallGraph::calleeOf(_node, m_dispatch))
+        {
+            // Each helper is scanned once, which also bounds recursion.
+            if (m_scanned.insert(CALLEE).second) CALLEE->accept(*this);
+            return true;
+        }
+
+        // Builtins do not read the state of the contract, whereas other calls
+        // may read any of it.
+        switch (TYPE->kind())
+        {
+        case solidity::FunctionType::Kind::Internal:
+        case solidity::FunctionType::Kind::External:
+        case solidity::FunctionType::Kind::DelegateCall:
+        case solidity::FunctionType::Kind::BareCall:
+        case solidity::FunctionType::Kind::BareCallCode:
+        case solidity::FunctionType::Kind::BareDelegateCall:
+        case solidity::FunctionType::Kind::BareStaticCall:
+            m_opaque = true;
+            break;
+        default:
+            break;
+        }
+        return true;
+    }
+
+private:
+    // The list being extended.
+    vector<solidity::VariableDeclaration const*> & m_reads;
+    // The functions run by the contract.
+    CallGraph::Dispatch const& m_dispatch;
+    // The helpers which have been scanned.
+    set<solidity::FunctionDefinition const*> m_scanned;
+    // Set once a call cannot be followed.
+    bool m_opaque = false;
+};
+
+/**
+ * Returns the condition of a branch or loop, or nullptr if _stmt has none.
+ *
+ * _stmt: the statement to inspect.
+ */
+solidity::Expression const* conditionOf(solidity::Statement const& _stmt)
+{
+    // TODO: remove casts.
+    if (auto const* FOR = dynamic_cast<solidity::ForStatement const*>(&_stmt))
+    {
+        return FOR->condition();
+    }
+    if (auto const* LOOP = dynamic_cast<solidity::WhileStatement const*>(&_stmt))
+    {
+        return &LOOP->condition();
+    }
+    if (auto const* IF = dynamic_cast<solidity::IfStatement const*>(&_stmt))
+    {
+        return &IF->condition();
+    }
+    return nullptr;
+}
+
+}
+
+// -------------------------------------------------------------------------- //
+
+ProgramSlice::ProgramSlice(
+    LoopSummary const& _criterion, ContractSummary const& _locality
+)
+{
+    auto const DISPATCH = CallGraph::dispatchOf(_locality.locality());
+
+    vector<solidity::VariableDeclaration const*> worklist;
+    StateReadCollector collector(worklist, DISPATCH);
+
+    if (auto const* COND = conditionOf(_criterion.expr()))
+    {
+        COND->accept(collector);
+    }
+
+    set<size_t> functions;
+    auto const& INDEX = _locality.writes();
+    while (!worklist.empty())
+    {
+        auto const* VAR = worklist.back();
+        worklist.pop_back();
+        if (!m_variables.insert(VAR->id()).second) continue;
+
+        for (auto const& site : INDEX.sitesOf(*VAR))
+        {
+            functions.insert(site.function);
+
+            // A write depends on its operands, and on the conditions which
+            // control whether, and how often, it runs.
+            site.expr->accept(collector);
+            for (auto const* stmt : site.statements)
+            {
+                m_statements.insert(stmt->id());
+                if (auto const* COND = conditionOf(*stmt))
+                {
+                    COND->accept(collector);
+                }
+            }
+        }
+    }
+
+    // A call which cannot be followed may read any state, so the slice falls
+    // back to the whole locality.
+    if (collector.opaque())
+    {
+        m_whole = true;
+        functions.clear();
+        for (size_t i = 0; i < _locality.summaryLength(); ++i)
+        {
+            functions.insert(i);
+        }
+    }
+
+    m_functions.assign(functions.begin(), functions.end());
+}
+
+set<SummaryKey> const& ProgramSlice::variables() const
+{
+    return m_variables;
+}
+
+vector<size_t> const& ProgramSlice::functions() const
+{
+    return m_functions;
+}
+
+bool ProgramSlice::contains(SummaryKey _id) const
+{
+    return m_whole || (m_statements.find(_id) != m_statements.end());
+}
+
+// -------------------------------------------------------------------------- //
+
+}
+}
@@ -0,0 +1,82 @@
+/**
+ * A pattern searches the locality of an obligation for evidence. Most of a
+ * large contract is unrelated to any single loop, yet a full search visits all
+ * of it. This module computes a slice of the locality: the functions and
+ * statements which may affect the termination condition of a loop. Abduction
+ * then searches only the slice.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Program slicing over the writes of a contract.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/ASTForward.h>
+#include <libsolintent/ir/ForwardIR.h>
+#include <set>
+#include <vector>
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * A backwards slice of a contract, with respect to the termination condition of
+ * a loop. The slice is computed over state variables. A variable is relevant if
+ * it is read by the condition, or if it is read by a write to, or controls a
+ * write to, a relevant variable. The slice then holds each write to a relevant
+ * variable, along with the statements and functions which enclose it.
+ *
+ * Local variables and parameters are not tracked, so each write is kept as a
+ * whole. Internal calls are followed into the functions they reach. If any
+ * other call which may read state is made, then the slice is the whole
+ * locality.
+ */
+class ProgramSlice
+{
+public:
+    /**
+     * _criterion: the loop whose termination condition is sliced upon.
+     * _locality: the contract to slice.
+     */
+    ProgramSlice(LoopSummary const& _criterion, ContractSummary const& _locality);
+
+    /**
+     * Returns the ids of all relevant state variables.
+     */
+    std::set<SummaryKey> const& variables() const;
+
+    /**
+     * Returns the indices of the functions in the slice, in definition order.
+     */
+    std::vector<size_t> const& functions() const;
+
+    /**
+     * Returns true if the statement with the given id is in the slice. A
+     * statement is in the slice if it is, or it encloses, a relevant write.
+     *
+     * _id: the id of the statement.
+     */
+    bool contains(SummaryKey _id) const;
+
+private:
+    // The ids of all relevant state variables.
+    std::set<SummaryKey> m_variables;
+    // The indices of the functions in the slice.
+    std::vector<size_t> m_functions;
+    // The ids of the statements in the slice.
+    std::set<SummaryKey> m_statements;
+    // True if the slice is the whole locality.
+    bool m_whole = false;
+};
+
+// -------------------------------------------------------------------------- //
+
+}
+}
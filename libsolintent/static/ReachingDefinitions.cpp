@@ -0,0 +1,192 @@
+/**
+ * A definition reaches a point if some path from the definition to that point
+ * leaves the variable untouched. Reaching definitions answer which values a
+ * variable may hold at a loop header, and in turn, which variables change from
+ * one iteration to the next.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Reaching definitions, and loop-variant variables.
+ */
+
+#include <libsolintent/static/ReachingDefinitions.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
+#include <libsolintent/ir/StatementSummary.h>
+#include <map>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+namespace
+{
+
+/**
+ * Collects the variables defined by a statement, in order.
+ */
+class DefinitionScanner: public solidity::ASTConstVisitor
+{
+public:
+    /**
+     * _vars: the list to extend with each variable defined.
+     */
+    explicit DefinitionScanner(
+        vector<solidity::VariableDeclaration const*> & _vars
+    )
+        : m_vars(_vars)
+    {
+    }
+
+protected:
+    bool visit(solidity::VariableDeclarationStatement const& _node) override
+    {
+        for (auto const& decl : _node.declarations())
+        {
+            if (decl) m_vars.push_back(decl.get());
+        }
+        return true;
+    }
+
+    void endVisit(solidity::Assignment const& _node) override
+    {
+        define(_node.leftHandSide());
+    }
+
+    void endVisit(solidity::UnaryOperation const& _node) override
+    {
+        switch (_node.getOperator())
+        {
+        case solidity::Token::Inc:
+        case solidity::Token::Dec:
+        case solidity::Token::Delete:
+            define(_node.subExpression());
+            break;
+        default:
+            break;
+        }
+    }
+
+private:
+    /**
+     * Records a definition of _target, if it names a variable.
+     */
+    void define(solidity::Expression const& _target)
+    {
+        // TODO: remove casts.
+        auto const* ID = dynamic_cast<solidity::Identifier const*>(&_target);
+        if (!ID) return;
+
+        auto const* DECL = dynamic_cast<solidity::VariableDeclaration const*>(
+            ID->annotation().referencedDeclaration
+        );
+        if (DECL) m_vars.push_back(DECL);
+    }
+
+    // The list being extended.
+    vector<solidity::VariableDeclaration const*> & m_vars;
+};
+
+/**
+ * Returns all definitions of _cfg, in block order.
+ */
+vector<ReachingDefinitions::Definition> collect(ControlFlowGraph const& _cfg)
+{
+    vector<ReachingDefinitions::Definition> defs;
+    vector<solidity::VariableDeclaration const*> vars;
+    DefinitionScanner scanner(vars);
+
+    auto const& BLOCKS = _cfg.blocks();
+    for (size_t b = 0; b < BLOCKS.size(); ++b)
+    {
+        for (auto const* stmt : BLOCKS[b].statements)
+        {
+            vars.clear();
+            stmt->expr().accept(scanner);
+            for (auto const* var : vars)
+            {
+                defs.push_back({ stmt, b, var });
+            }
+        }
+    }
+    return defs;
+}
+
+}
+
+// -------------------------------------------------------------------------- //
+
+ReachingDefinitions::ReachingDefinitions(ControlFlowGraph const& _cfg)
+    : m_defs(collect(_cfg))
+    , m_flow(
+        _cfg,
+        BitsetDataflow::Direction::Forward,
+        BitsetDataflow::Meet::Union,
+        m_defs.size()
+    )
+{
+    // Each definition kills all definitions of the same variable.
+    map<solidity::VariableDeclaration const*, BitsetDataflow::Bits> byVar;
+    for (size_t i = 0; i < m_defs.size(); ++i)
+    {
+        auto & bits = byVar[m_defs[i].var];
+        if (bits.empty()) bits.resize(m_defs.size());
+        bits.set(i);
+    }
+
+    // Definitions are in block order, so the last definition of a variable in
+    // a block overrides all earlier definitions.
+    for (size_t i = 0; i < m_defs.size(); ++i)
+    {
+        auto const& DEFS = byVar[m_defs[i].var];
+        auto & gen = m_flow.gen(m_defs[i].block);
+        gen -= DEFS;
+        gen.set(i);
+        m_flow.kill(m_defs[i].block) |= DEFS;
+    }
+
+    m_flow.solve();
+}
+
+vector<ReachingDefinitions::Definition> const&
+    ReachingDefinitions::definitions() const
+{
+    return m_defs;
+}
+
+BitsetDataflow::Bits const& ReachingDefinitions::reachingIn(size_t _block) const
+{
+    return m_flow.in(_block);
+}
+
+set<solidity::VariableDeclaration const*> ReachingDefinitions::variantsOf(
+    ControlFlowGraph::Loop const& _loop
+) const
+{
+    set<size_t> const BLOCKS(_loop.blocks.begin(), _loop.blocks.end());
+
+    set<solidity::VariableDeclaration const*> variants;
+    auto const& REACHING = m_flow.in(_loop.header);
+    auto i = REACHING.find_first();
+    for (; i != REACHING.npos; i = REACHING.find_next(i))
+    {
+        if (BLOCKS.count(m_defs[i].block) > 0)
+        {
+            variants.insert(m_defs[i].var);
+        }
+    }
+    return variants;
+}
+
+// -------------------------------------------------------------------------- //
+
+}
+}
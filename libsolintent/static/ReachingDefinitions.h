@@ -0,0 +1,87 @@
+/**
+ * A definition reaches a point if some path from the definition to that point
+ * leaves the variable untouched. Reaching definitions answer which values a
+ * variable may hold at a loop header, and in turn, which variables change from
+ * one iteration to the next.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Reaching definitions, and loop-variant variables.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/ASTForward.h>
+#include <libsolintent/static/Dataflow.h>
+#include <set>
+#include <vector>
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * Computes the reaching definitions of every block in a ControlFlowGraph. A
+ * definition is a declaration, assignment, increment, decrement or delete of a
+ * variable named directly by an identifier. Writes through an index or member
+ * access do not define a variable.
+ */
+class ReachingDefinitions
+{
+public:
+    /**
+     * A single write to a variable.
+     */
+    struct Definition
+    {
+        // The statement which performs the write.
+        StatementSummary const* stmt;
+        // The block which holds the statement.
+        size_t block;
+        // The variable written to.
+        solidity::VariableDeclaration const* var;
+    };
+
+    /**
+     * _cfg: the graph to analyze. It must outlive this analysis.
+     */
+    explicit ReachingDefinitions(ControlFlowGraph const& _cfg);
+
+    /**
+     * Returns all definitions, in block order. Bit i of each set corresponds to
+     * definition i.
+     */
+    std::vector<Definition> const& definitions() const;
+
+    /**
+     * Returns the definitions which reach the start of a block.
+     */
+    BitsetDataflow::Bits const& reachingIn(size_t _block) const;
+
+    /**
+     * Returns the variables whose value may change between iterations of a
+     * loop. These are the variables with a definition inside the loop which
+     * reaches the loop header along a back edge.
+     *
+     * _loop: a loop of the analyzed graph.
+     */
+    std::set<solidity::VariableDeclaration const*> variantsOf(
+        ControlFlowGraph::Loop const& _loop
+    ) const;
+
+private:
+    // All definitions in the graph.
+    std::vector<Definition> m_defs;
+    // The solved dataflow problem.
+    BitsetDataflow m_flow;
+};
+
+// -------------------------------------------------------------------------- //
+
+}
+}
@@ -0,0 +1,400 @@
+/**
+ * Patterns which relate a variable across statements cannot compare names
+ * alone, since a name may be reassigned between its uses. In static single
+ * assignment form, every write yields a new value, values are merged by phi
+ * nodes where paths meet, and every read names exactly one value. Questions of
+ * the form "which write does this read see" then become pointer lookups.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Static single assignment form over control-flow graphs.
+ */
+
+#include <libsolintent/static/SsaForm.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
+#include <libsolintent/ir/StatementSummary.h>
+#include <libsolintent/static/DominatorTree.h>
+#include <functional>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+namespace
+{
+
+/**
+ * Reports each read and write of a variable, in evaluation order.
+ */
+class AccessScanner: public solidity::ASTConstVisitor
+{
+public:
+    using Callback = function<void(
+        solidity::Identifier const*, solidity::VariableDeclaration const*, bool
+    )>;
+
+    /**
+     * _record: called with the identifier, variable and write flag of each
+     *          access. Declarations are reported without an identifier.
+     */
+    explicit AccessScanner(Callback _record): m_record(move(_record))
+    {
+    }
+
+protected:
+    bool visit(solidity::VariableDeclarationStatement const& _node) override
+    {
+        if (auto const* INIT = _node.initialValue())
+        {
+            INIT->accept(*this);
+        }
+        for (auto const& decl : _node.declarations())
+        {
+            if (decl) m_record(nullptr, decl.get(), true);
+        }
+        return false;
+    }
+
+    bool visit(solidity::Assignment const& _node) override
+    {
+        auto const* ID = named(_node.leftHandSide());
+        if (!ID) return true;
+
+        if (_node.assignmentOperator() != solidity::Token::Assign)
+        {
+            m_record(ID, varOf(*ID), false);
+        }
+        _node.rightHandSide().accept(*this);
+        m_record(ID, varOf(*ID), true);
+        return false;
+    }
+
+    bool visit(solidity::UnaryOperation const& _node) override
+    {
+        auto const OP = _node.getOperator();
+        bool const READS = (OP == solidity::Token::Inc)
+                        || (OP == solidity::Token::Dec);
+        if (!READS && OP != solidity::Token::Delete) return true;
+
+        auto const* ID = named(_node.subExpression());
+        if (!ID) return true;
+
+        if (READS) m_record(ID, varOf(*ID), false);
+        m_record(ID, varOf(*ID), true);
+        return false;
+    }
+
+    void endVisit(solidity::Identifier const& _node) override
+    {
+        if (auto const* VAR = varOf(_node)) m_record(&_node, VAR, false);
+    }
+
+private:
+    /**
+     * Returns the variable referenced by _id, or nullptr.
+     */
+    static solidity::VariableDeclaration const* varOf(
+        solidity::Identifier const& _id
+    )
+    {
+        // TODO: remove cast.
+        return dynamic_cast<solidity::VariableDeclaration const*>(
+            _id.annotation().referencedDeclaration
+        );
+    }
+
+    /**
+     * Returns _expr if it is an identifier which names a variable.
+     */
+    static solidity::Identifier const* named(solidity::Expression const& _expr)
+    {
+        // TODO: remove cast.
+        auto const* ID = dynamic_cast<solidity::Identifier const*>(&_expr);
+        return (ID && varOf(*ID)) ? ID : nullptr;
+    }
+
+    // Receives each access.
+    Callback m_record;
+};
+
+/**
+ * Returns the condition of _block, as written in the loop or branch which owns
+ * the block, or nullptr. Condition summaries are interned, so the AST of the
+ * summary itself may lie in an identical condition elsewhere.
+ */
+solidity::Expression const* conditionOf(ControlFlowGraph::Block const& _block)
+{
+    StatementSummary const* owner = _block.loop;
+    if (!owner) owner = _block.branch;
+    if (!owner) return nullptr;
+
+    // TODO: remove casts.
+    auto const* STMT = &owner->expr();
+    if (auto const* FOR = dynamic_cast<solidity::ForStatement const*>(STMT))
+    {
+        return FOR->condition();
+    }
+    if (auto const* LOOP = dynamic_cast<solidity::WhileStatement const*>(STMT))
+    {
+        return &LOOP->condition();
+    }
+    if (auto const* IF = dynamic_cast<solidity::IfStatement const*>(STMT))
+    {
+        return &IF->condition();
+    }
+    return nullptr;
+}
+
+}
+
+// -------------------------------------------------------------------------- //
+
+SsaForm::SsaForm(ControlFlowGraph const& _cfg)
+    : m_cfg(_cfg)
+    , m_phis(_cfg.blocks().size())
+{
+    DominatorTree const TREE(_cfg);
+    auto const& BLOCKS = _cfg.blocks();
+
+    // Records all accesses of each reachable block. A branch condition is
+    // evaluated once the statements of its block complete.
+    vector<vector<Access>> accesses(BLOCKS.size());
+    vector<solidity::VariableDeclaration const*> vars;
+    map<solidity::VariableDeclaration const*, set<size_t>> writes;
+    for (auto const B : _cfg.reversePostOrder())
+    {
+        StatementSummary const* stmt = nullptr;
+        AccessScanner scanner([&](
+            solidity::Identifier const* _id,
+            solidity::VariableDeclaration const* _var,
+            bool _write
+        ) {
+            if (m_versions.emplace(_var, 0).second) vars.push_back(_var);
+            if (_write) writes[_var].insert(B);
+            accesses[B].push_back({ stmt, _id, _var, _write });
+        });
+
+        for (auto const* STMT : BLOCKS[B].statements)
+        {
+            stmt = STMT;
+            STMT->expr().accept(scanner);
+        }
+        stmt = nullptr;
+        if (auto const* COND = conditionOf(BLOCKS[B]))
+        {
+            COND->accept(scanner);
+        }
+    }
+
+    // Every variable holds some value on entry, even if it is declared later,
+    // as declarations without a value are zero-initialized.
+    map<solidity::VariableDeclaration const*, Value *> latest;
+    for (auto const* VAR : vars)
+    {
+        m_values.push_back(
+            Value{ Value::Kind::Entry, VAR, 0, _cfg.entry(), nullptr, {}, {} }
+        );
+        latest[VAR] = &m_values.back();
+    }
+
+    // Places phi nodes on the iterated dominance frontier of each write. The
+    // entry has no predecessors, so its frontier is always empty.
+    for (auto const* VAR : vars)
+    {
+        auto const& WRITES = writes[VAR];
+        vector<size_t> worklist(WRITES.begin(), WRITES.end());
+        set<size_t> placed;
+        while (!worklist.empty())
+        {
+            size_t const B = worklist.back();
+            worklist.pop_back();
+
+            for (auto const F : TREE.frontier(B))
+            {
+                if (!placed.insert(F).second) continue;
+
+                vector<Value const*> operands(BLOCKS[F].preds.size(), nullptr);
+                m_values.push_back(
+                    Value{ Value::Kind::Phi, VAR, 0, F, nullptr, operands, {} }
+                );
+                m_phis[F].push_back(&m_values.back());
+
+                if (WRITES.count(F) == 0) worklist.push_back(F);
+            }
+        }
+    }
+
+    rename(TREE, accesses, _cfg.entry(), move(latest));
+}
+
+deque<SsaForm::Value> const& SsaForm::values() const
+{
+    return m_values;
+}
+
+SsaForm::Value const* SsaForm::valueOf(solidity::Identifier const& _read) const
+{
+    auto const RESULT = m_reads.find(&_read);
+    return (RESULT == m_reads.end()) ? nullptr : RESULT->second;
+}
+
+vector<SsaForm::Value const*> SsaForm::definedBy(
+    StatementSummary const& _stmt
+) const
+{
+    auto const RESULT = m_defs.find(&_stmt);
+    if (RESULT == m_defs.end()) return {};
+    return RESULT->second;
+}
+
+vector<SsaForm::Value const*> SsaForm::phisAt(size_t _block) const
+{
+    return { m_phis[_block].begin(), m_phis[_block].end() };
+}
+
+set<solidity::VariableDeclaration const*> SsaForm::variantsOf(
+    ControlFlowGraph::Loop const& _loop
+) const
+{
+    set<size_t> const BLOCKS(_loop.blocks.begin(), _loop.blocks.end());
+    auto const& PREDS = m_cfg.blocks()[_loop.header].preds;
+
+    set<solidity::VariableDeclaration const*> variants;
+    for (auto const* PHI : m_phis[_loop.header])
+    {
+        for (size_t i = 0; i < PREDS.size(); ++i)
+        {
+            auto const* OPERAND = PHI->operands[i];
+            if (BLOCKS.count(PREDS[i]) == 0) continue;
+            if (OPERAND && OPERAND != PHI) variants.insert(PHI->var);
+        }
+    }
+    return variants;
+}
+
+void SsaForm::rename(
+    DominatorTree const& _tree,
+    vector<vector<Access>> const& _accesses,
+    size_t _root,
+    map<solidity::VariableDeclaration const*, Value *> _latest
+)
+{
+    // Each frame holds a block, the index of its next child, and the size of
+    // the undo stack before the block was renamed.
+    struct Frame
+    {
+        size_t block;
+        size_t child;
+        size_t mark;
+    };
+
+    vector<pair<solidity::VariableDeclaration const*, Value *>> undo;
+    vector<Frame> frames{ { _root, 0, 0 } };
+    renameBlock(_accesses, _root, _latest, undo);
+    while (!frames.empty())
+    {
+        auto & top = frames.back();
+        auto const& CHILDREN = _tree.children(top.block);
+        if (top.child < CHILDREN.size())
+        {
+            size_t const NEXT = CHILDREN[top.child++];
+            size_t const MARK = undo.size();
+            renameBlock(_accesses, NEXT, _latest, undo);
+            frames.push_back({ NEXT, 0, MARK });
+        }
+        else
+        {
+            while (undo.size() > top.mark)
+            {
+                _latest[undo.back().first] = undo.back().second;
+                undo.pop_back();
+            }
+            frames.pop_back();
+        }
+    }
+}
+
+void SsaForm::renameBlock(
+    vector<vector<Access>> const& _accesses,
+    size_t _block,
+    map<solidity::VariableDeclaration const*, Value *> & _latest,
+    vector<pair<solidity::VariableDeclaration const*, Value *>> & _undo
+)
+{
+    auto const update = [&](
+        solidity::VariableDeclaration const* _var, Value * _value
+    ) {
+        auto & latest = _latest[_var];
+        _undo.push_back({ _var, latest });
+        latest = _value;
+    };
+
+    for (auto * phi : m_phis[_block])
+    {
+        phi->version = ++m_versions[phi->var];
+        update(phi->var, phi);
+    }
+
+    // Each definition takes as operands the values read by its statement.
+    auto const& ACCESSES = _accesses[_block];
+    vector<Value const*> operands;
+    for (size_t i = 0; i < ACCESSES.size(); ++i)
+    {
+        auto const& ACCESS = ACCESSES[i];
+        if (i > 0 && ACCESS.stmt != ACCESSES[i - 1].stmt) operands.clear();
+
+        if (ACCESS.write)
+        {
+            m_values.push_back(Value{
+                Value::Kind::Def,
+                ACCESS.var,
+                ++m_versions[ACCESS.var],
+                _block,
+                ACCESS.stmt,
+                operands,
+                {}
+            });
+            update(ACCESS.var, &m_values.back());
+            if (ACCESS.stmt) m_defs[ACCESS.stmt].push_back(&m_values.back());
+        }
+        else
+        {
+            auto * value = _latest[ACCESS.var];
+            value->uses.push_back({ _block, ACCESS.stmt, ACCESS.id, nullptr });
+            m_reads[ACCESS.id] = value;
+            operands.push_back(value);
+        }
+    }
+
+    // Fills in the operands of each successor's phi nodes along this edge.
+    auto const& BLOCKS = m_cfg.blocks();
+    auto const& SUCCS = BLOCKS[_block].succs;
+    for (auto const SUCC : set<size_t>(SUCCS.begin(), SUCCS.end()))
+    {
+        auto const& PREDS = BLOCKS[SUCC].preds;
+        for (auto * phi : m_phis[SUCC])
+        {
+            auto * value = _latest[phi->var];
+            for (size_t i = 0; i < PREDS.size(); ++i)
+            {
+                if (PREDS[i] != _block) continue;
+                phi->operands[i] = value;
+                value->uses.push_back({ SUCC, nullptr, nullptr, phi });
+            }
+        }
+    }
+}
+
+// -------------------------------------------------------------------------- //
+
+}
+}
@@ -0,0 +1,187 @@
+/**
+ * Patterns which relate a variable across statements cannot compare names
+ * alone, since a name may be reassigned between its uses. In static single
+ * assignment form, every write yields a new value, values are merged by phi
+ * nodes where paths meet, and every read names exactly one value. Questions of
+ * the form "which write does this read see" then become pointer lookups.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Static single assignment form over control-flow graphs.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/ASTForward.h>
+#include <libsolintent/static/ControlFlowGraph.h>
+#include <deque>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace dev
+{
+namespace solintent
+{
+
+class DominatorTree;
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * Lowers the variables of a ControlFlowGraph into SSA form. A write is a
+ * declaration, assignment, increment, decrement or delete of a variable named
+ * directly by an identifier, as in ReachingDefinitions. Phi nodes are placed on
+ * the iterated dominance frontier of each write. Unreachable blocks are not
+ * lowered.
+ */
+class SsaForm
+{
+public:
+    struct Value;
+
+    /**
+     * A single read of a value.
+     */
+    struct Use
+    {
+        // The block in which the read occurs.
+        size_t block;
+        // The statement which reads the value, or nullptr if the read is by a
+        // block condition or a phi node.
+        StatementSummary const* stmt;
+        // The identifier which reads the value, or nullptr for a phi node.
+        solidity::Identifier const* read;
+        // The phi node which reads the value, if any.
+        Value const* phi;
+    };
+
+    /**
+     * A single version of a variable.
+     */
+    struct Value
+    {
+        /**
+         * The origin of a value: the value held on entry, a write, or a merge.
+         */
+        enum class Kind { Entry, Def, Phi };
+
+        // The origin of this value.
+        Kind kind;
+        // The variable which holds this value.
+        solidity::VariableDeclaration const* var;
+        // The version of var. Entry values are version 0.
+        size_t version;
+        // The block in which the value is defined.
+        size_t block;
+        // The statement which writes the value, for definitions.
+        StatementSummary const* stmt;
+        // For phi nodes, the value along each predecessor of the block, or
+        // nullptr for unreachable predecessors. For definitions, the values
+        // read by the same statement before the write.
+        std::vector<Value const*> operands;
+        // Each read of this value.
+        std::vector<Use> uses;
+    };
+
+    /**
+     * _cfg: the graph to lower. It must outlive this analysis.
+     */
+    explicit SsaForm(ControlFlowGraph const& _cfg);
+
+    /**
+     * Returns all values.
+     */
+    std::deque<Value> const& values() const;
+
+    /**
+     * Returns the value seen by an identifier, or nullptr if the identifier
+     * does not read a variable within a reachable block. An identifier which
+     * is both read and written, as in `i++`, sees the value before the write.
+     */
+    Value const* valueOf(solidity::Identifier const& _read) const;
+
+    /**
+     * Returns the values written by a statement, in order.
+     */
+    std::vector<Value const*> definedBy(StatementSummary const& _stmt) const;
+
+    /**
+     * Returns the phi nodes at the start of a block.
+     */
+    std::vector<Value const*> phisAt(size_t _block) const;
+
+    /**
+     * Returns the variables whose value may change between iterations of a
+     * loop. These are the variables with a phi node at the loop header which
+     * receives a new value along a back edge.
+     *
+     * _loop: a loop of the lowered graph.
+     */
+    std::set<solidity::VariableDeclaration const*> variantsOf(
+        ControlFlowGraph::Loop const& _loop
+    ) const;
+
+private:
+    /**
+     * A read or write of a variable, in evaluation order.
+     */
+    struct Access
+    {
+        // The statement which performs the access, if any.
+        StatementSummary const* stmt;
+        // The identifier which performs the access, if any.
+        solidity::Identifier const* id;
+        // The variable accessed.
+        solidity::VariableDeclaration const* var;
+        // True if the variable is written to.
+        bool write;
+    };
+
+    /**
+     * Numbers the values of every block dominated by _root, in a preorder walk
+     * of the dominator tree. The walk is iterative, and keeps a single map of
+     * the latest value of each variable. The values replaced within a block
+     * are restored once the walk leaves the subtree of that block.
+     *
+     * _latest: the latest value of each variable on entry to _root.
+     */
+    void rename(
+        DominatorTree const& _tree,
+        std::vector<std::vector<Access>> const& _accesses,
+        size_t _root,
+        std::map<solidity::VariableDeclaration const*, Value *> _latest
+    );
+
+    /**
+     * Numbers the values of _block alone. Each entry of _latest which is
+     * replaced is first pushed, with its old value, onto _undo.
+     */
+    void renameBlock(
+        std::vector<std::vector<Access>> const& _accesses,
+        size_t _block,
+        std::map<solidity::VariableDeclaration const*, Value *> & _latest,
+        std::vector<std::pair<solidity::VariableDeclaration const*, Value *>> &
+            _undo
+    );
+
+    // The graph which was lowered.
+    ControlFlowGraph const& m_cfg;
+    // All values. A deque keeps pointers stable as values are added.
+    std::deque<Value> m_values;
+    // The phi nodes of each block.
+    std::vector<std::vector<Value *>> m_phis;
+    // The value seen by each identifier.
+    std::map<solidity::Identifier const*, Value const*> m_reads;
+    // The values written by each statement.
+    std::map<StatementSummary const*, std::vector<Value const*>> m_defs;
+    // The number of versions of each variable.
+    std::map<solidity::VariableDeclaration const*, size_t> m_versions;
+};
+
+// -------------------------------------------------------------------------- //
+
+}
+}
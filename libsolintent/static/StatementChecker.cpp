@@ -20,6 +20,78 @@ namespace dev
 namespace solintent
 {
 
+optional<CounterInit> StatementChecker::initialValueOf(
+    solidity::Statement const& _init
+)
+{
+    // TODO: remove casts.
+    solidity::VariableDeclaration const* decl = nullptr;
+    solidity::Expression const* value = nullptr;
+    using DeclStatement = solidity::VariableDeclarationStatement;
+    using ExprStatement = solidity::ExpressionStatement;
+    if (auto const* DECL = dynamic_cast<DeclStatement const*>(&_init))
+    {
+        auto const& VARS = DECL->declarations();
+        if (VARS.size() == 1 && VARS[0])
+        {
+            decl = VARS[0].get();
+            value = DECL->initialValue();
+        }
+    }
+    else if (auto const* STMT = dynamic_cast<ExprStatement const*>(&_init))
+    {
+        auto const* ASSIGN = dynamic_cast<solidity::Assignment const*>(
+            &STMT->expression()
+        );
+        if (ASSIGN && ASSIGN->assignmentOperator() == solidity::Token::Assign)
+        {
+            auto const* ID = dynamic_cast<solidity::Identifier const*>(
+                &ASSIGN->leftHandSide()
+            );
+            if (ID)
+            {
+                decl = dynamic_cast<solidity::VariableDeclaration const*>(
+                    ID->annotation().referencedDeclaration
+                );
+                value = &ASSIGN->rightHandSide();
+            }
+        }
+    }
+
+    if (!decl || !value) return nullopt;
+    if (!getNumericAnalyzer().matches(*value)) return nullopt;
+
+    // An initializer outside of the model leaves the count unknown.
+    optional<solidity::rational> exact;
+    try
+    {
+        exact = getNumericAnalyzer().check(*value)->exact();
+    }
+    catch (UnsupportedExpression const&)
+    {
+        return nullopt;
+    }
+
+    if (!exact.has_value()) return nullopt;
+    return CounterInit{ decl, move(*exact) };
+}
+
+SummaryPointer<TreeBlockSummary> StatementChecker::checkLoopBody(
+    solidity::Statement const& _loop, solidity::Statement const& _body
+)
+{
+    auto body = dynamic_pointer_cast<TreeBlockSummary const>(check(_body));
+    if (!body)
+    {
+        auto const LOC = srclocToStr(_loop.location());
+        auto const ERR = "Loop expected TreeBlockSummary from: " + LOC;
+        throw runtime_error(ERR);
+    }
+    return body;
+}
+
+// -------------------------------------------------------------------------- //
+
 bool StatementChecker::visit(solidity::Block const& _node)
 {
     vector<SummaryPointer<StatementSummary>> statements;
@@ -36,14 +108,25 @@ bool StatementChecker::visit(solidity::Block const& _node)
 
 bool StatementChecker::visit(solidity::PlaceholderStatement const& _node)
 {
-    (void) _node;
-    throw;
+    write_to_cache(make_shared<PlaceholderSummary>(_node));
+    return false;
 }
 
 bool StatementChecker::visit(solidity::IfStatement const& _node)
 {
-    (void) _node;
-    throw;
+    auto cond = getBooleanAnalyzer().check(_node.condition());
+    auto onTrue = check(_node.trueStatement());
+
+    SummaryPointer<StatementSummary> onFalse;
+    if (_node.falseStatement())
+    {
+        onFalse = check(*_node.falseStatement());
+    }
+
+    write_to_cache(make_shared<BranchSummary>(
+        _node, move(cond), move(onTrue), move(onFalse)
+    ));
+    return false;
 }
 
 bool StatementChecker::visit(solidity::TryCatchClause const& _node)
@@ -60,25 +143,23 @@ bool StatementChecker::visit(solidity::TryStatement const& _node)
 
 bool StatementChecker::visit(solidity::WhileStatement const& _node)
 {
-    (void) _node;
-    throw;
+    auto body = checkLoopBody(_node, _node.body());
+    auto loopCondition = getBooleanAnalyzer().check(_node.condition());
+
+    // Without a loop expression, no variable is known to trend.
+    auto loop = make_shared<LoopSummary>(
+        _node, move(loopCondition), move(body), nullptr, nullptr,
+        vector<reference_wrapper<TrendingNumeric const>>{}, TripCount()
+    );
+
+    write_to_cache(move(loop));
+    return false;
 }
 
 bool StatementChecker::visit(solidity::ForStatement const& _node)
 {
     // TODO: scan body.
-    SummaryPointer<TreeBlockSummary> body;
-    {
-        auto tmp = check(_node.body());
-        body = dynamic_pointer_cast<TreeBlockSummary const>(tmp);
-        if (!body)
-        {
-            auto const LOC = srclocToStr(_node.location());
-            auto const ERR = "Loop expected TreeBlockSummary from: " + LOC;
-            throw runtime_error(ERR);
-        }
-
-    }
+    auto body = checkLoopBody(_node, _node.body());
 
     SummaryPointer<BooleanSummary> loopCondition;
     if (_node.condition())
@@ -91,12 +172,13 @@ bool StatementChecker::visit(solidity::ForStatement const& _node)
         throw runtime_error("Loop condition expected: " + LOC);
     }
 
+    SummaryPointer<StatementSummary> update;
     vector<reference_wrapper<TrendingNumeric const>> trending;
     if (_node.loopExpression())
     {
         // TODO: no dynamic casts would be best.
-        auto tmp = check(*_node.loopExpression());
-        auto change = dynamic_pointer_cast<NumericExprStatement const>(tmp);
+        update = check(*_node.loopExpression());
+        auto change = dynamic_pointer_cast<NumericExprStatement const>(update);
 
         if (!change)
         {
@@ -114,8 +196,30 @@ bool StatementChecker::visit(solidity::ForStatement const& _node)
         }
     }
 
+    SummaryPointer<StatementSummary> init;
+    optional<CounterInit> counter;
+    if (auto const* INIT = _node.initializationExpression())
+    {
+        // An initializer outside of the model is left out of the summary.
+        try
+        {
+            init = check(*INIT);
+        }
+        catch (UnsupportedExpression const&)
+        {
+        }
+        counter = initialValueOf(*INIT);
+    }
+    auto trips = countTrips(counter, trending, *loopCondition, *body);
+
     auto loop = make_shared<LoopSummary>(
-        _node, move(loopCondition), move(body), move(trending)
+        _node,
+        move(loopCondition),
+        move(body),
+        move(init),
+        move(update),
+        move(trending),
+        move(trips)
     );
 
     write_to_cache(move(loop));
@@ -124,8 +228,9 @@ bool StatementChecker::visit(solidity::ForStatement const& _node)
 
 bool StatementChecker::visit(solidity::Continue const& _node)
 {
-    (void) _node;
-    throw;
+    auto const KIND = JumpSummary::Kind::Continue;
+    write_to_cache(make_shared<JumpSummary>(_node, KIND));
+    return false;
 }
 
 bool StatementChecker::visit(solidity::InlineAssembly const& _node)
@@ -136,14 +241,16 @@ bool StatementChecker::visit(solidity::InlineAssembly const& _node)
 
 bool StatementChecker::visit(solidity::Break const& _node)
 {
-    (void) _node;
-    throw;
+    auto const KIND = JumpSummary::Kind::Break;
+    write_to_cache(make_shared<JumpSummary>(_node, KIND));
+    return false;
 }
 
 bool StatementChecker::visit(solidity::Return const& _node)
 {
-    (void) _node;
-    throw;
+    auto const KIND = JumpSummary::Kind::Return;
+    write_to_cache(make_shared<JumpSummary>(_node, KIND));
+    return false;
 }
 
 bool StatementChecker::visit(solidity::Throw const& _node)
@@ -187,7 +294,7 @@ bool StatementChecker::visit(solidity::ExpressionStatement const& _node)
     {
         auto const LOC = srclocToStr(_node.location());
         auto const ERR = "ExpressionStatement without matching analyzer: " + LOC;
-        throw runtime_error(ERR);
+        throw UnsupportedExpression(ERR);
     }
     write_to_cache(move(stmt));
     
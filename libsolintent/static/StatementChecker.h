@@ -10,9 +10,11 @@
 
 #pragma once
 
-#include <libsolintent/ir/StatementInterface.h>
+#include <libsolintent/ir/StatementSummary.h>
 #include <libsolintent/static/AbstractStatementAnalyzer.h>
+#include <libsolintent/static/TripCounter.h>
 #include <memory>
+#include <optional>
 
 namespace dev
 {
@@ -37,6 +39,26 @@ protected:
 	bool visit(solidity::EmitStatement const& _node) override;
 	bool visit(solidity::VariableDeclarationStatement const& _node) override;
 	bool visit(solidity::ExpressionStatement const& _node) override;
+
+private:
+	/**
+	 * Summarizes the body of a loop, which must be a block.
+	 *
+	 * _loop: the loop, for use in error messages.
+	 * _body: the body of _loop.
+	 */
+	SummaryPointer<TreeBlockSummary> checkLoopBody(
+		solidity::Statement const& _loop, solidity::Statement const& _body
+	);
+
+	/**
+	 * Extracts the value assigned to a loop counter by the initializer of a
+	 * for loop. If the initializer does not assign a single variable a
+	 * constant value, then nullopt is returned.
+	 *
+	 * _init: the initialization statement of the loop.
+	 */
+	std::optional<CounterInit> initialValueOf(solidity::Statement const& _init);
 };
 
 }
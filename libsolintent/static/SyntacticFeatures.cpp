@@ -0,0 +1,121 @@
+/**
+ * Most functions contain none of the constructs an assertion template looks
+ * for. Building IR for such functions is wasted effort. This module provides a
+ * cheap syntactic scan which records the constructs found within an AST, so
+ * that functions which cannot match a template are skipped before any IR is
+ * built.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * A syntactic pre-filter for assertion templates.
+ */
+
+#include <libsolintent/static/SyntacticFeatures.h>
+
+#include <libsolidity/ast/AST.h>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+namespace
+{
+
+/**
+ * Collects the features of an AST in a single pass.
+ */
+class FeatureScanner: public solidity::ASTConstVisitor
+{
+public:
+    /**
+     * _features: the set to populate.
+     */
+    explicit FeatureScanner(SyntacticFeatures & _features)
+        : m_features(_features)
+    {
+    }
+
+protected:
+    bool visit(solidity::ForStatement const&) override
+    {
+        m_features.add(SyntacticFeatures::Feature::Loop);
+        return true;
+    }
+
+    bool visit(solidity::WhileStatement const&) override
+    {
+        m_features.add(SyntacticFeatures::Feature::Loop);
+        return true;
+    }
+
+    bool visit(solidity::InlineAssembly const&) override
+    {
+        m_features.add(SyntacticFeatures::Feature::InlineAssembly);
+        return false;
+    }
+
+    bool visit(solidity::MemberAccess const& _node) override
+    {
+        auto const& NAME = _node.memberName();
+        if (NAME == "push")
+        {
+            m_features.add(SyntacticFeatures::Feature::Push);
+        }
+        else if (NAME == "length")
+        {
+            m_features.add(SyntacticFeatures::Feature::Length);
+        }
+        return true;
+    }
+
+private:
+    // The set being populated.
+    SyntacticFeatures & m_features;
+};
+
+}
+
+// -------------------------------------------------------------------------- //
+
+SyntacticFeatures::SyntacticFeatures(initializer_list<Feature> _features)
+{
+    for (auto const FEATURE : _features)
+    {
+        add(FEATURE);
+    }
+}
+
+SyntacticFeatures SyntacticFeatures::of(solidity::ASTNode const& _node)
+{
+    SyntacticFeatures features;
+    FeatureScanner scanner(features);
+    _node.accept(scanner);
+    return features;
+}
+
+bool SyntacticFeatures::has(Feature _feature) const
+{
+    return m_bits.test(static_cast<size_t>(_feature));
+}
+
+bool SyntacticFeatures::covers(SyntacticFeatures const& _required) const
+{
+    return (_required.m_bits & ~m_bits).none();
+}
+
+void SyntacticFeatures::add(Feature _feature)
+{
+    m_bits.set(static_cast<size_t>(_feature));
+}
+
+// -------------------------------------------------------------------------- //
+
+}
+}
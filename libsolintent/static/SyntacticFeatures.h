@@ -0,0 +1,95 @@
+/**
+ * Most functions contain none of the constructs an assertion template looks
+ * for. Building IR for such functions is wasted effort. This module provides a
+ * cheap syntactic scan which records the constructs found within an AST, so
+ * that functions which cannot match a template are skipped before any IR is
+ * built.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * A syntactic pre-filter for assertion templates.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/ASTVisitor.h>
+#include <bitset>
+#include <initializer_list>
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * A set of syntactic features. The set is either computed from an AST, or used
+ * to describe the features a template requires.
+ */
+class SyntacticFeatures
+{
+public:
+    /**
+     * Each feature which may be detected.
+     */
+    enum class Feature
+    {
+        // A for, while or do-while loop.
+        Loop,
+        // A member access to push.
+        Push,
+        // A member access to length.
+        Length,
+        // An inline assembly block.
+        InlineAssembly,
+        // The number of features. Not a feature.
+        Count
+    };
+
+    /**
+     * Constructs a set holding the given features.
+     *
+     * _features: the initial features.
+     */
+    SyntacticFeatures(std::initializer_list<Feature> _features = {});
+
+    /**
+     * Scans _node and all of its descendants for features.
+     *
+     * _node: the root of the AST to scan.
+     */
+    static SyntacticFeatures of(solidity::ASTNode const& _node);
+
+    /**
+     * Returns true if _feature is in this set.
+     *
+     * _feature: the feature to check.
+     */
+    bool has(Feature _feature) const;
+
+    /**
+     * Returns true if every feature of _required is also in this set.
+     *
+     * _required: the features to check.
+     */
+    bool covers(SyntacticFeatures const& _required) const;
+
+    /**
+     * Adds _feature to this set.
+     *
+     * _feature: the feature to add.
+     */
+    void add(Feature _feature);
+
+private:
+    // The bit of each feature is set if and only if the feature is present.
+    std::bitset<static_cast<size_t>(Feature::Count)> m_bits;
+};
+
+// -------------------------------------------------------------------------- //
+
+}
+}
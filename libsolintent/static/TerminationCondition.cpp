@@ -0,0 +1,284 @@
+/**
+ * The same termination condition may be written in many ways: `i < n` is also
+ * `n > i`, and `i < 10` is also `10 > i`. This module rewrites each condition
+ * over variables and constants into a canonical form, so that equivalent
+ * loops are recognized as such. Verdicts reached for one loop are then memoized
+ * by canonical form, and reused for every loop of the same shape.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Canonical termination conditions, and a cache of loop verdicts.
+ */
+
+#include <libsolintent/static/TerminationCondition.h>
+
+#include <libsolidity/ast/AST.h>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+namespace
+{
+
+/**
+ * One side of a comparison, split into a variable and a constant.
+ */
+struct Operand
+{
+    // The variable, or nullptr if the side is constant.
+    NumericVariable const* var;
+    // The constant.
+    solidity::rational value;
+};
+
+/**
+ * Splits _expr into a variable and a constant. If _expr is neither, then
+ * nullopt is returned.
+ *
+ * _expr: the side to split.
+ */
+optional<Operand> split(NumericSummary const& _expr)
+{
+    if (auto const VAL = _expr.exact())
+    {
+        return Operand{ nullptr, *VAL };
+    }
+
+    // TODO: remove cast.
+    if (auto const* VAR = dynamic_cast<NumericVariable const*>(&_expr))
+    {
+        return Operand{ VAR, solidity::rational(0) };
+    }
+
+    return nullopt;
+}
+
+/**
+ * Encodes a variable independently of the AST it was drawn from.
+ *
+ * _var: the variable to encode.
+ */
+string keyOf(NumericVariable const& _var)
+{
+    string key = _var.symb() + "{";
+    for (auto const TAG : _var.symbolTags())
+    {
+        key += to_string(static_cast<int>(TAG)) + ",";
+    }
+
+    auto const TREND = _var.trend();
+    return key + "}" + (TREND ? to_string(*TREND) : "?");
+}
+
+/**
+ * Returns the relation which holds once the operands are exchanged.
+ *
+ * _cond: the relation to flip.
+ */
+Comparison::Condition flip(Comparison::Condition _cond)
+{
+    switch (_cond)
+    {
+    case Comparison::Condition::LessThan:
+        return Comparison::Condition::GreaterThan;
+    case Comparison::Condition::GreaterThan:
+        return Comparison::Condition::LessThan;
+    default:
+        return _cond;
+    }
+}
+
+}
+
+// -------------------------------------------------------------------------- //
+
+optional<CanonicalCondition> CanonicalCondition::of(BooleanSummary const& _cond)
+{
+    // TODO: remove cast.
+    auto const* CMP = dynamic_cast<Comparison const*>(&_cond);
+    if (!CMP) return nullopt;
+
+    auto const LHS = split(*CMP->lhs());
+    auto const RHS = split(*CMP->rhs());
+    if (!LHS || !RHS) return nullopt;
+    if (!LHS->var && !RHS->var) return nullopt;
+
+    // Starts from `lhs.var <cond> rhs.var + (rhs.value - lhs.value)`.
+    auto cond = CMP->cond();
+    auto const* lhs = LHS->var;
+    auto const* rhs = RHS->var;
+    auto offset = RHS->value - LHS->value;
+
+    // Exchanging sides maps `x <cond> y + k` to `y <flip(cond)> x - k`.
+    bool exchange = false;
+    if (!lhs)
+    {
+        exchange = true;
+    }
+    else if (rhs)
+    {
+        if (cond == Comparison::Condition::GreaterThan)
+        {
+            exchange = true;
+        }
+        else if (cond != Comparison::Condition::LessThan)
+        {
+            exchange = (keyOf(*rhs) < keyOf(*lhs));
+        }
+    }
+
+    if (exchange)
+    {
+        std::swap(lhs, rhs);
+        cond = flip(cond);
+        offset = -offset;
+    }
+
+    return CanonicalCondition(cond, CMP->strict(), lhs, rhs, move(offset));
+}
+
+CanonicalCondition::CanonicalCondition(
+    Comparison::Condition _cond,
+    bool _strict,
+    NumericVariable const* _lhs,
+    NumericVariable const* _rhs,
+    solidity::rational _offset
+)
+    : m_cond(_cond)
+    , m_strict(_strict)
+    , m_lhs(_lhs)
+    , m_rhs(_rhs)
+    , m_offset(move(_offset))
+{
+    m_key = to_string(static_cast<int>(m_cond)) + (m_strict ? "s" : "w");
+    m_key += ":" + keyOf(*m_lhs);
+    m_key += ":" + (m_rhs ? keyOf(*m_rhs) : "");
+    m_key += ":" + m_offset.numerator().str();
+    m_key += "/" + m_offset.denominator().str();
+}
+
+Comparison::Condition CanonicalCondition::cond() const
+{
+    return m_cond;
+}
+
+bool CanonicalCondition::strict() const
+{
+    return m_strict;
+}
+
+NumericVariable const& CanonicalCondition::lhs() const
+{
+    return (*m_lhs);
+}
+
+NumericVariable const* CanonicalCondition::rhs() const
+{
+    return m_rhs;
+}
+
+solidity::rational const& CanonicalCondition::offset() const
+{
+    return m_offset;
+}
+
+string const& CanonicalCondition::key() const
+{
+    return m_key;
+}
+
+// -------------------------------------------------------------------------- //
+
+solidity::Expression const& variableOf(NumericVariable const& _var)
+{
+    // TODO: remove cast.
+    solidity::Expression const* expr = &_var.expr();
+    while (auto const* OP = dynamic_cast<solidity::UnaryOperation const*>(expr))
+    {
+        expr = &OP->subExpression();
+    }
+    return (*expr);
+}
+
+optional<string> pathOf(solidity::Expression const& _expr)
+{
+    // TODO: remove casts.
+    if (auto const* ID = dynamic_cast<solidity::Identifier const*>(&_expr))
+    {
+        auto const* DECL = ID->annotation().referencedDeclaration;
+        if (!DECL) return nullopt;
+        return to_string(DECL->id());
+    }
+    if (auto const* MEM = dynamic_cast<solidity::MemberAccess const*>(&_expr))
+    {
+        auto const BASE = pathOf(MEM->expression());
+        if (!BASE.has_value()) return nullopt;
+        return (*BASE) + "." + MEM->memberName();
+    }
+    return nullopt;
+}
+
+optional<string> pathOf(NumericVariable const& _var)
+{
+    return pathOf(variableOf(_var));
+}
+
+// -------------------------------------------------------------------------- //
+
+optional<TerminationCache::Verdict> TerminationCache::find(
+    string const& _key
+) const
+{
+    lock_guard<mutex> lock(m_mutex);
+
+    auto const RES = m_verdicts.find(_key);
+    if (RES == m_verdicts.end()) return nullopt;
+
+    ++m_hits;
+    return RES->second;
+}
+
+void TerminationCache::insert(string _key, Verdict _verdict)
+{
+    lock_guard<mutex> lock(m_mutex);
+    m_verdicts.emplace(move(_key), move(_verdict));
+}
+
+size_t TerminationCache::size() const
+{
+    lock_guard<mutex> lock(m_mutex);
+    return m_verdicts.size();
+}
+
+size_t TerminationCache::hits() const
+{
+    lock_guard<mutex> lock(m_mutex);
+    return m_hits;
+}
+
+optional<solidity::rational> TerminationCache::boundOf(
+    CanonicalCondition const& _cond
+)
+{
+    if (_cond.rhs()) return nullopt;
+    if (_cond.cond() != Comparison::Condition::LessThan) return nullopt;
+
+    // Counters are integral, so `x <= k` is bounded by k + 1.
+    auto const& OFFSET = _cond.offset();
+    if (_cond.strict()) return OFFSET;
+    if (OFFSET.denominator() != 1) return nullopt;
+    return OFFSET + solidity::rational(1);
+}
+
+// -------------------------------------------------------------------------- //
+
+}
+}
@@ -0,0 +1,206 @@
+/**
+ * The same termination condition may be written in many ways: `i < n` is also
+ * `n > i`, and `i < 10` is also `10 > i`. This module rewrites each condition
+ * over variables and constants into a canonical form, so that equivalent
+ * loops are recognized as such. Verdicts reached for one loop are then memoized
+ * by canonical form, and reused for every loop of the same shape.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Canonical termination conditions, and a cache of loop verdicts.
+ */
+
+#pragma once
+
+#include <libsolintent/ir/ExpressionSummary.h>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * A comparison rewritten as `lhs <cond> rhs + offset`. Constant operands are
+ * moved into the offset, so lhs is always a variable, and rhs is either a
+ * variable or nullptr. An ordering is written as LessThan whenever rhs is a
+ * variable. Otherwise, the ordering is kept from the perspective of lhs. The
+ * operands of an equality are ordered by their symbols.
+ *
+ * Strictness is kept explicitly, rather than folded into the offset, so that a
+ * canonical condition over rationals remains faithful to its source.
+ */
+class CanonicalCondition
+{
+public:
+    /**
+     * Rewrites _cond into canonical form. If _cond is not a comparison, or if
+     * an operand is neither a constant nor a variable, then nullopt is
+     * returned. Comparisons between constants are also rejected, as these are
+     * resolved by the CondChecker.
+     *
+     * _cond: the termination condition.
+     */
+    static std::optional<CanonicalCondition> of(BooleanSummary const& _cond);
+
+    /**
+     * Returns the relation between the operands.
+     */
+    Comparison::Condition cond() const;
+
+    /**
+     * Returns true if equality falsifies the condition.
+     */
+    bool strict() const;
+
+    /**
+     * Returns the variable on the left-hand side.
+     */
+    NumericVariable const& lhs() const;
+
+    /**
+     * Returns the variable on the right-hand side, or nullptr if the right-hand
+     * side is the offset alone.
+     */
+    NumericVariable const* rhs() const;
+
+    /**
+     * Returns the constant added to the right-hand side.
+     */
+    solidity::rational const& offset() const;
+
+    /**
+     * Returns a string which identifies the canonical form. The key depends
+     * only on symbols, sources, trends and values, so it is stable across
+     * compilations.
+     */
+    std::string const& key() const;
+
+private:
+    CanonicalCondition(
+        Comparison::Condition _cond,
+        bool _strict,
+        NumericVariable const* _lhs,
+        NumericVariable const* _rhs,
+        solidity::rational _offset
+    );
+
+    // The relation between the operands.
+    Comparison::Condition m_cond;
+    // True if equality falsifies the condition.
+    bool m_strict;
+    // The variable on the left-hand side.
+    NumericVariable const* m_lhs;
+    // The variable on the right-hand side, if any.
+    NumericVariable const* m_rhs;
+    // The constant added to the right-hand side.
+    solidity::rational m_offset;
+    // The identifying string of this form.
+    std::string m_key;
+};
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * Returns the expression which names the variable behind _var. A variable which
+ * has been stepped (e.g., by `i++`) is traced back to the variable it steps.
+ *
+ * _var: the variable to trace.
+ */
+solidity::Expression const& variableOf(NumericVariable const& _var);
+
+/**
+ * Returns the path of the variable named by _expr, such as `7.length` for
+ * `a.length` where `a` has id 7. Two variables are the same if and only if
+ * their paths are equal, regardless of their symbols. Returns nullopt if _expr
+ * is not a chain of member accesses over an identifier.
+ *
+ * _expr: the expression naming the variable.
+ */
+std::optional<std::string> pathOf(solidity::Expression const& _expr);
+
+/**
+ * Returns the path of the variable behind _var, as in pathOf(variableOf(_var)).
+ *
+ * _var: the variable to resolve.
+ */
+std::optional<std::string> pathOf(NumericVariable const& _var);
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * Memoizes the verdicts reached for loops, by the canonical form of their
+ * termination conditions. A single cache may be shared by every query of an
+ * assertion template, across all compilations in a run, so access is
+ * synchronized.
+ */
+class TerminationCache
+{
+public:
+    /**
+     * The outcome of checking a single loop shape.
+     */
+    struct Verdict
+    {
+        // True if the loop shape is suspect.
+        bool suspect;
+        // An exclusive upper bound on lhs, if the condition implies one.
+        std::optional<solidity::rational> bound;
+    };
+
+    /**
+     * Returns the verdict recorded for _key, if any.
+     *
+     * _key: the key of a canonical condition, possibly extended by the caller.
+     */
+    std::optional<Verdict> find(std::string const& _key) const;
+
+    /**
+     * Records a verdict for _key. If a verdict is already recorded, then the
+     * original verdict is kept.
+     *
+     * _key: the key of a canonical condition, possibly extended by the caller.
+     * _verdict: the verdict reached for _key.
+     */
+    void insert(std::string _key, Verdict _verdict);
+
+    /**
+     * Returns the number of distinct shapes recorded.
+     */
+    size_t size() const;
+
+    /**
+     * Returns the number of lookups answered from the cache.
+     */
+    size_t hits() const;
+
+    /**
+     * Computes the bound on lhs implied by _cond, if any. A bound exists when
+     * lhs is compared against a constant.
+     *
+     * _cond: the canonical condition.
+     */
+    static std::optional<solidity::rational> boundOf(
+        CanonicalCondition const& _cond
+    );
+
+private:
+    // Guards all fields below.
+    mutable std::mutex m_mutex;
+    // Maps the key of each shape to its verdict.
+    std::unordered_map<std::string, Verdict> m_verdicts;
+    // The number of lookups answered from the cache.
+    mutable size_t m_hits = 0;
+};
+
+// -------------------------------------------------------------------------- //
+
+}
+}
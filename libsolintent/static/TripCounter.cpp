@@ -0,0 +1,387 @@
+/**
+ * Most loops advance a single counter from a known value towards a bound. The
+ * number of iterations of such a loop has a closed form, so it can be computed
+ * once, when the loop is summarized, rather than rediscovered by each pattern
+ * which reasons about the loop.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Closed-form trip counts for counted loops.
+ */
+
+#include <libsolintent/static/TripCounter.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
+#include <libsolintent/static/TerminationCondition.h>
+#include <set>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+namespace
+{
+
+/**
+ * Returns the greatest integer no larger than _val.
+ */
+solidity::rational floorOf(solidity::rational const& _val)
+{
+    auto quot = _val.numerator() / _val.denominator();
+    if (_val.numerator() < 0 && quot * _val.denominator() != _val.numerator())
+    {
+        quot -= 1;
+    }
+    return solidity::rational(quot);
+}
+
+/**
+ * Returns the least integer no smaller than _val.
+ */
+solidity::rational ceilOf(solidity::rational const& _val)
+{
+    return -floorOf(-_val);
+}
+
+/**
+ * Returns the number of steps of size _step needed to cover _dist, or zero if
+ * _dist is not positive.
+ */
+solidity::rational stepsOver(
+    solidity::rational const& _dist, solidity::rational const& _step
+)
+{
+    if (_dist <= 0) return solidity::rational(0);
+    return ceilOf(_dist / _step);
+}
+
+/**
+ * Returns true if _val is outside the range of _type. If _type is unknown, then
+ * the range is taken to be unbounded.
+ */
+bool outOfRange(
+    solidity::rational const& _val, solidity::IntegerType const* _type
+)
+{
+    if (!_type) return false;
+    return _val < _type->minValue() || _val > _type->maxValue();
+}
+
+/**
+ * Counts the trips of `x <cond> k`, for a counter x which starts at _init and
+ * changes by _step. A counter of type _type wraps before it reaches a value out
+ * of range, so if the condition only fails out of range, the count is unknown.
+ */
+TripCount countConstant(
+    CanonicalCondition const& _cond,
+    solidity::rational const& _init,
+    solidity::rational const& _step,
+    solidity::IntegerType const* _type
+)
+{
+    auto const& K = _cond.offset();
+    bool const STRICT = _cond.strict();
+    solidity::rational const ZERO(0);
+    solidity::rational const ONE(1);
+
+    switch (_cond.cond())
+    {
+    case Comparison::Condition::LessThan:
+    {
+        if (STRICT ? (_init >= K) : (_init > K)) return TripCount::exact(ZERO);
+        if (_step < 0) return TripCount();
+
+        // The least integer which falsifies the condition.
+        auto const END = STRICT ? ceilOf(K) : floorOf(K) + ONE;
+        if (outOfRange(END, _type)) return TripCount();
+        return TripCount::exact(stepsOver(END - _init, _step));
+    }
+    case Comparison::Condition::GreaterThan:
+    {
+        if (STRICT ? (_init <= K) : (_init < K)) return TripCount::exact(ZERO);
+        if (_step > 0) return TripCount();
+
+        // The greatest integer which falsifies the condition.
+        auto const END = STRICT ? floorOf(K) : ceilOf(K) - ONE;
+        if (outOfRange(END, _type)) return TripCount();
+        return TripCount::exact(stepsOver(_init - END, -_step));
+    }
+    case Comparison::Condition::Equal:
+        return TripCount::exact((_init == K) ? ONE : ZERO);
+    case Comparison::Condition::Distinct:
+    {
+        if (_init == K) return TripCount::exact(ZERO);
+
+        // The counter must land on K, or else the loop overflows.
+        if (outOfRange(K, _type)) return TripCount();
+        auto const STEPS = (K - _init) / _step;
+        if (STEPS <= 0 || STEPS.denominator() != 1) return TripCount();
+        return TripCount::exact(STEPS);
+    }
+    }
+    return TripCount();
+}
+
+/**
+ * Returns the variable at the root of _expr, after stripping all members and
+ * elements, or nullptr.
+ */
+solidity::VariableDeclaration const* rootOf(solidity::Expression const& _expr)
+{
+    // TODO: remove casts.
+    using solidity::IndexAccess;
+    using solidity::MemberAccess;
+    solidity::Expression const* root = &_expr;
+    while (true)
+    {
+        if (auto const* IDX = dynamic_cast<IndexAccess const*>(root))
+        {
+            root = &IDX->baseExpression();
+        }
+        else if (auto const* MEM = dynamic_cast<MemberAccess const*>(root))
+        {
+            root = &MEM->expression();
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    auto const* ID = dynamic_cast<solidity::Identifier const*>(root);
+    if (!ID) return nullptr;
+    return dynamic_cast<solidity::VariableDeclaration const*>(
+        ID->annotation().referencedDeclaration
+    );
+}
+
+/**
+ * Collects the effects of a loop body on its trip count: the variables it may
+ * write, and whether it may exit before the condition fails.
+ */
+class BodyScanner: public solidity::ASTConstVisitor
+{
+public:
+    /**
+     * _body: the body of the loop.
+     */
+    explicit BodyScanner(solidity::Statement const& _body)
+    {
+        _body.accept(*this);
+    }
+
+    /**
+     * Returns true if the body may write to the variable named by _var. State
+     * may also be written through calls, and through storage pointers.
+     */
+    bool writes(NumericVariable const& _var) const
+    {
+        auto const PATH = pathOf(_var);
+        if (!PATH.has_value()) return true;
+
+        auto const* ROOT = rootOf(variableOf(_var));
+        if (m_opaque && (!ROOT || ROOT->isStateVariable())) return true;
+
+        // A write to a variable also writes to each of its members.
+        for (auto const& written : m_written)
+        {
+            if (*PATH == written) return true;
+            if (PATH->compare(0, written.size() + 1, written + ".") == 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Returns true if the body may break out of the loop, or return.
+     */
+    bool exits() const
+    {
+        return m_exits;
+    }
+
+protected:
+    bool visit(solidity::ForStatement const&) override
+    {
+        ++m_depth;
+        return true;
+    }
+
+    void endVisit(solidity::ForStatement const&) override
+    {
+        --m_depth;
+    }
+
+    bool visit(solidity::WhileStatement const&) override
+    {
+        ++m_depth;
+        return true;
+    }
+
+    void endVisit(solidity::WhileStatement const&) override
+    {
+        --m_depth;
+    }
+
+    void endVisit(solidity::Break const&) override
+    {
+        // A break within a nested loop only ends the nested loop.
+        if (m_depth == 0) m_exits = true;
+    }
+
+    void endVisit(solidity::Return const&) override
+    {
+        m_exits = true;
+    }
+
+    void endVisit(solidity::Assignment const& _node) override
+    {
+        write(_node.leftHandSide(), "");
+    }
+
+    void endVisit(solidity::UnaryOperation const& _node) override
+    {
+        switch (_node.getOperator())
+        {
+        case solidity::Token::Inc:
+        case solidity::Token::Dec:
+        case solidity::Token::Delete:
+            write(_node.subExpression(), "");
+            break;
+        default:
+            break;
+        }
+    }
+
+    void endVisit(solidity::FunctionCall const& _node) override
+    {
+        // TODO: remove casts.
+        auto const* TYPE = dynamic_cast<solidity::FunctionType const*>(
+            _node.expression().annotation().type
+        );
+        if (!TYPE) return;
+
+        using Kind = solidity::FunctionType::Kind;
+        if (TYPE->kind() == Kind::ArrayPush || TYPE->kind() == Kind::ArrayPop)
+        {
+            auto const* MEM = dynamic_cast<solidity::MemberAccess const*>(
+                &_node.expression()
+            );
+            if (MEM) write(MEM->expression(), ".length");
+        }
+        else if (TYPE->stateMutability() > solidity::StateMutability::View)
+        {
+            m_opaque = true;
+        }
+    }
+
+private:
+    /**
+     * Records a write to _target, or to the member _suffix of _target. A write
+     * to an element of an array changes neither the array nor its length, so
+     * it is not recorded.
+     */
+    void write(solidity::Expression const& _target, string const& _suffix)
+    {
+        if (auto const PATH = pathOf(_target))
+        {
+            m_written.insert(*PATH + _suffix);
+        }
+
+        // Storage pointers alias state, which is then written indirectly.
+        auto const* ROOT = rootOf(_target);
+        if (ROOT && !ROOT->isStateVariable())
+        {
+            using Location = solidity::VariableDeclaration::Location;
+            if (ROOT->referenceLocation() == Location::Storage) m_opaque = true;
+        }
+    }
+
+    // The paths of all variables written directly.
+    set<string> m_written;
+    // True if state may be written without being named.
+    bool m_opaque = false;
+    // True if the body may exit the loop early.
+    bool m_exits = false;
+    // The number of nested loops enclosing the current node.
+    size_t m_depth = 0;
+};
+
+}
+
+// -------------------------------------------------------------------------- //
+
+TripCount countTrips(
+    optional<CounterInit> const& _init,
+    vector<reference_wrapper<TrendingNumeric const>> const& _deltas,
+    BooleanSummary const& _cond,
+    StatementSummary const& _body
+)
+{
+    if (!_init.has_value() || _deltas.size() != 1) return TripCount();
+
+    // TODO: remove cast.
+    auto const* COUNTER = dynamic_cast<NumericVariable const*>(
+        &_deltas.front().get()
+    );
+    if (!COUNTER || !_init->decl) return TripCount();
+
+    // Variables are identified by declaration, as symbols may be shadowed.
+    auto const COUNTER_PATH = pathOf(*COUNTER);
+    if (COUNTER_PATH != to_string(_init->decl->id())) return TripCount();
+
+    auto const TREND = COUNTER->trend();
+    if (!TREND.has_value() || *TREND == 0) return TripCount();
+    solidity::rational const STEP(*TREND);
+
+    auto const COND = CanonicalCondition::of(_cond);
+    if (!COND.has_value()) return TripCount();
+    if (pathOf(COND->lhs()) != COUNTER_PATH) return TripCount();
+
+    // A body which moves the counter, or the limit, breaks the closed form.
+    BodyScanner const BODY(_body.expr());
+    if (BODY.writes(*COUNTER)) return TripCount();
+
+    TripCount trips;
+    auto const* LIMIT = COND->rhs();
+    if (!LIMIT)
+    {
+        // TODO: remove cast.
+        auto const* TYPE = dynamic_cast<solidity::IntegerType const*>(
+            COUNTER->expr().annotation().type
+        );
+        trips = countConstant(*COND, _init->value, STEP, TYPE);
+    }
+    else
+    {
+        if (pathOf(*LIMIT) == COUNTER_PATH) return TripCount();
+        if (BODY.writes(*LIMIT)) return TripCount();
+
+        // The counter must approach the limit from below.
+        if (COND->cond() != Comparison::Condition::LessThan) return TripCount();
+        if (STEP < 0) return TripCount();
+
+        // Counters are integral, so `x <= n + k` runs while `x < n + (k + 1)`.
+        auto END = COND->offset();
+        if (!COND->strict()) END += solidity::rational(1);
+        trips = TripCount::bounded(*LIMIT, _init->value - END, STEP);
+    }
+
+    // A break or return may end the loop before the condition fails.
+    return BODY.exits() ? trips.upperBound() : trips;
+}
+
+// -------------------------------------------------------------------------- //
+
+}
+}
@@ -0,0 +1,65 @@
+/**
+ * Most loops advance a single counter from a known value towards a bound. The
+ * number of iterations of such a loop has a closed form, so it can be computed
+ * once, when the loop is summarized, rather than rediscovered by each pattern
+ * which reasons about the loop.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Closed-form trip counts for counted loops.
+ */
+
+#pragma once
+
+#include <libsolintent/ir/StatementSummary.h>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * The value assigned to a counter before a loop begins.
+ */
+struct CounterInit
+{
+    // The declaration of the counter.
+    solidity::VariableDeclaration const* decl;
+    // The initial value of the counter.
+    solidity::rational value;
+};
+
+/**
+ * Computes the trip count of a loop with a single counter. The count is exact
+ * when the counter is compared against a constant, and bounded when the counter
+ * approaches a variable from below. In all other cases, the count is unknown.
+ *
+ * If the body may write to the counter, or to the limit, then the count is
+ * unknown. If the body may break out of the loop, or return, then the count is
+ * only an upper bound. Writes to the elements of an array do not change its
+ * length, whereas calls which may modify state may change any state variable.
+ *
+ * _init: the initial value of the counter, if known.
+ * _deltas: the trends of the variables updated by the loop.
+ * _cond: the termination condition.
+ * _body: the body of the loop.
+ */
+TripCount countTrips(
+    std::optional<CounterInit> const& _init,
+    std::vector<std::reference_wrapper<TrendingNumeric const>> const& _deltas,
+    BooleanSummary const& _cond,
+    StatementSummary const& _body
+);
+
+// -------------------------------------------------------------------------- //
+
+}
+}
@@ -0,0 +1,125 @@
+/**
+ * Pipelined stages run at different speeds. If a fast stage feeds a slow stage
+ * through an unbounded queue, then the queue grows without limit. This module
+ * provides a queue of fixed capacity. A producer blocks while the queue is full,
+ * so the memory held between stages stays flat.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * A blocking queue of bounded capacity.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * A multi-producer, multi-consumer FIFO queue which holds at most a fixed
+ * number of elements. Once closed, no further elements are accepted, but those
+ * already queued may still be popped.
+ */
+template <typename T>
+class BoundedQueue
+{
+public:
+    /**
+     * _capacity: the maximum number of queued elements. At least one.
+     */
+    explicit BoundedQueue(size_t _capacity)
+        : m_capacity(std::max<size_t>(_capacity, 1))
+    {
+    }
+
+    BoundedQueue(BoundedQueue const&) = delete;
+    BoundedQueue & operator=(BoundedQueue const&) = delete;
+
+    /**
+     * Appends an element, blocking while the queue is full. Returns false if
+     * the queue was closed, in which case the element is dropped.
+     *
+     * _element: the element to append.
+     */
+    bool push(T _element)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notFull.wait(lock, [this] {
+            return m_closed || m_queue.size() < m_capacity;
+        });
+        if (m_closed) return false;
+
+        m_queue.push_back(std::move(_element));
+        lock.unlock();
+        m_notEmpty.notify_one();
+        return true;
+    }
+
+    /**
+     * Removes the oldest element, blocking while the queue is empty. Returns
+     * nullopt once the queue is both closed and drained.
+     */
+    std::optional<T> pop()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notEmpty.wait(lock, [this] { return m_closed || !m_queue.empty(); });
+        if (m_queue.empty()) return std::nullopt;
+
+        std::optional<T> element(std::move(m_queue.front()));
+        m_queue.pop_front();
+        lock.unlock();
+        m_notFull.notify_one();
+        return element;
+    }
+
+    /**
+     * Stops the queue from accepting elements, and wakes all waiting threads.
+     */
+    void close()
+    {
+        {
+            std::lock_guard<std::mutex> const LOCK(m_mutex);
+            m_closed = true;
+        }
+        m_notFull.notify_all();
+        m_notEmpty.notify_all();
+    }
+
+    /**
+     * Returns the maximum number of queued elements.
+     */
+    size_t capacity() const
+    {
+        return m_capacity;
+    }
+
+private:
+    // The maximum number of queued elements.
+    size_t const m_capacity;
+    // Guards all remaining fields.
+    std::mutex m_mutex;
+    // Signalled when an element is removed.
+    std::condition_variable m_notFull;
+    // Signalled when an element is added.
+    std::condition_variable m_notEmpty;
+    // The queued elements, oldest first.
+    std::deque<T> m_queue;
+    // True once the queue no longer accepts elements.
+    bool m_closed = false;
+};
+
+// -------------------------------------------------------------------------- //
+
+}
+}
@@ -0,0 +1,332 @@
+/**
+ * Solidity evaluates constant expressions over arbitrary-precision rationals.
+ * In practice, nearly every such value is an integer which fits within an EVM
+ * word. This module provides a fixed-width integer for this common case, so
+ * that constant folding does not pay for heap allocation and normalization.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Fixed-width 256-bit integer values.
+ */
+
+#include <libsolintent/util/FixedInt.h>
+
+#include <functional>
+#include <limits>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+namespace
+{
+
+// An all-ones limb, used for sign-extension.
+uint64_t const ONES = numeric_limits<uint64_t>::max();
+
+}
+
+// -------------------------------------------------------------------------- //
+
+FixedInt::FixedInt(int64_t _val)
+    : m_negative(_val < 0)
+{
+    uint64_t const EXT = m_negative ? ONES : 0;
+    m_limbs = {{ static_cast<uint64_t>(_val), EXT, EXT, EXT }};
+}
+
+FixedInt::FixedInt(Limbs _limbs, bool _negative)
+    : m_limbs(_limbs)
+    , m_negative(_negative)
+{
+}
+
+optional<FixedInt> FixedInt::fromRational(solidity::rational const& _val)
+{
+    if (_val.denominator() != 1) return nullopt;
+
+    bigint const BOUND = bigint(1) << 256;
+    bigint num = _val.numerator();
+    if (num >= BOUND || num <= -BOUND) return nullopt;
+
+    bool const NEGATIVE = (num < 0);
+    if (NEGATIVE) num += BOUND;
+
+    Limbs limbs;
+    for (size_t i = 0; i < LIMBS; ++i)
+    {
+        limbs[i] = static_cast<uint64_t>(num & ONES);
+        num >>= 64;
+    }
+    return FixedInt(limbs, NEGATIVE);
+}
+
+solidity::rational FixedInt::toRational() const
+{
+    bigint num = 0;
+    for (size_t i = LIMBS; i > 0; --i)
+    {
+        num <<= 64;
+        num |= m_limbs[i - 1];
+    }
+    if (m_negative) num -= (bigint(1) << 256);
+    return solidity::rational(num);
+}
+
+optional<int64_t> FixedInt::toInt64() const
+{
+    uint64_t const EXT = m_negative ? ONES : 0;
+    bool const HIGH_BIT = (m_limbs[0] >> 63) != 0;
+    if (m_limbs[1] != EXT || m_limbs[2] != EXT || m_limbs[3] != EXT)
+    {
+        return nullopt;
+    }
+    if (HIGH_BIT != m_negative) return nullopt;
+    return static_cast<int64_t>(m_limbs[0]);
+}
+
+bool FixedInt::isZero() const
+{
+    return (m_limbs[0] | m_limbs[1] | m_limbs[2] | m_limbs[3]) == 0;
+}
+
+bool FixedInt::fitsSigned() const
+{
+    return ((m_limbs[3] >> 63) != 0) == m_negative;
+}
+
+// -------------------------------------------------------------------------- //
+
+optional<FixedInt> FixedInt::add(FixedInt const& _rhs) const
+{
+    // Sign-extends both operands to a fifth limb. The sum of two 257-bit values
+    // is exact in 320 bits, so overflow is detected by the fifth limb.
+    uint64_t carry = 0;
+    Limbs sum;
+    for (size_t i = 0; i < LIMBS; ++i)
+    {
+        uint64_t const PARTIAL = m_limbs[i] + _rhs.m_limbs[i];
+        uint64_t const TOTAL = PARTIAL + carry;
+        carry = (PARTIAL < m_limbs[i]) | (TOTAL < PARTIAL);
+        sum[i] = TOTAL;
+    }
+    uint64_t const TOP = (m_negative ? ONES : 0)
+                       + (_rhs.m_negative ? ONES : 0)
+                       + carry;
+
+    // The result must be a valid 257-bit value, other than -2^256.
+    bool const NEGATIVE = (TOP == ONES);
+    if (TOP != 0 && !NEGATIVE) return nullopt;
+
+    FixedInt result(sum, NEGATIVE);
+    if (NEGATIVE && result.isZero()) return nullopt;
+    return result;
+}
+
+optional<FixedInt> FixedInt::sub(FixedInt const& _rhs) const
+{
+    return add(_rhs.negate());
+}
+
+optional<FixedInt> FixedInt::mul(FixedInt const& _rhs) const
+{
+    Limbs const LHS = magnitude();
+    Limbs const RHS = _rhs.magnitude();
+
+    // Schoolbook multiplication into a 512-bit product.
+    array<uint64_t, 2 * LIMBS> prod{};
+    for (size_t i = 0; i < LIMBS; ++i)
+    {
+        unsigned __int128 carry = 0;
+        for (size_t j = 0; j < LIMBS; ++j)
+        {
+            unsigned __int128 const CELL
+                = static_cast<unsigned __int128>(LHS[i]) * RHS[j]
+                + prod[i + j]
+                + carry;
+            prod[i + j] = static_cast<uint64_t>(CELL);
+            carry = CELL >> 64;
+        }
+        prod[i + LIMBS] = static_cast<uint64_t>(carry);
+    }
+
+    uint64_t overflow = 0;
+    for (size_t i = LIMBS; i < 2 * LIMBS; ++i) overflow |= prod[i];
+    if (overflow != 0) return nullopt;
+
+    Limbs const MAG{{ prod[0], prod[1], prod[2], prod[3] }};
+    return fromMagnitude(MAG, m_negative != _rhs.m_negative);
+}
+
+optional<FixedInt> FixedInt::div(FixedInt const& _rhs) const
+{
+    if (_rhs.isZero()) return nullopt;
+
+    Limbs quot, rem;
+    divmod(magnitude(), _rhs.magnitude(), quot, rem);
+    return fromMagnitude(quot, m_negative != _rhs.m_negative);
+}
+
+optional<FixedInt> FixedInt::mod(FixedInt const& _rhs) const
+{
+    if (_rhs.isZero()) return nullopt;
+
+    Limbs quot, rem;
+    divmod(magnitude(), _rhs.magnitude(), quot, rem);
+    return fromMagnitude(rem, m_negative);
+}
+
+FixedInt FixedInt::negate() const
+{
+    if (isZero()) return (*this);
+
+    Limbs neg;
+    uint64_t carry = 1;
+    for (size_t i = 0; i < LIMBS; ++i)
+    {
+        neg[i] = ~m_limbs[i] + carry;
+        carry = (carry & (neg[i] == 0));
+    }
+    return FixedInt(neg, !m_negative);
+}
+
+size_t FixedInt::hash() const
+{
+    size_t seed = m_negative;
+    for (auto const LIMB : m_limbs)
+    {
+        seed ^= std::hash<uint64_t>{}(LIMB) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+    return seed;
+}
+
+// -------------------------------------------------------------------------- //
+
+FixedInt::Limbs FixedInt::magnitude() const
+{
+    return m_negative ? negate().m_limbs : m_limbs;
+}
+
+FixedInt FixedInt::fromMagnitude(Limbs const& _mag, bool _negative)
+{
+    FixedInt const ABS(_mag, false);
+    return _negative ? ABS.negate() : ABS;
+}
+
+void FixedInt::divmod(
+    Limbs const& _num, Limbs const& _den, Limbs & _quot, Limbs & _rem
+)
+{
+    _quot = {{ 0, 0, 0, 0 }};
+    _rem = {{ 0, 0, 0, 0 }};
+
+    // Fast path for single-limb divisors.
+    if ((_den[1] | _den[2] | _den[3]) == 0)
+    {
+        unsigned __int128 rem = 0;
+        for (size_t i = LIMBS; i > 0; --i)
+        {
+            unsigned __int128 const CUR = (rem << 64) | _num[i - 1];
+            _quot[i - 1] = static_cast<uint64_t>(CUR / _den[0]);
+            rem = CUR % _den[0];
+        }
+        _rem[0] = static_cast<uint64_t>(rem);
+        return;
+    }
+
+    // Otherwise, falls back to restoring division, one bit at a time.
+    for (size_t bit = 64 * LIMBS; bit > 0; --bit)
+    {
+        size_t const LIMB = (bit - 1) / 64;
+        size_t const SHIFT = (bit - 1) % 64;
+
+        // Shifts the next bit of the numerator into the remainder.
+        uint64_t const CARRY_OUT = _rem[LIMBS - 1] >> 63;
+        for (size_t i = LIMBS - 1; i > 0; --i)
+        {
+            _rem[i] = (_rem[i] << 1) | (_rem[i - 1] >> 63);
+        }
+        _rem[0] = (_rem[0] << 1) | ((_num[LIMB] >> SHIFT) & 1);
+
+        // Determines if the remainder exceeds the denominator.
+        bool geq = (CARRY_OUT != 0);
+        if (!geq)
+        {
+            geq = true;
+            for (size_t i = LIMBS; i > 0; --i)
+            {
+                if (_rem[i - 1] != _den[i - 1])
+                {
+                    geq = (_rem[i - 1] > _den[i - 1]);
+                    break;
+                }
+            }
+        }
+
+        if (geq)
+        {
+            uint64_t borrow = 0;
+            for (size_t i = 0; i < LIMBS; ++i)
+            {
+                uint64_t const DIFF = _rem[i] - _den[i];
+                uint64_t const NEXT = (_rem[i] < _den[i]) | (DIFF < borrow);
+                _rem[i] = DIFF - borrow;
+                borrow = NEXT;
+            }
+            _quot[LIMB] |= (uint64_t(1) << SHIFT);
+        }
+    }
+}
+
+// -------------------------------------------------------------------------- //
+
+bool operator==(FixedInt const& _lhs, FixedInt const& _rhs)
+{
+    return (_lhs.m_negative == _rhs.m_negative)
+        && (_lhs.m_limbs == _rhs.m_limbs);
+}
+
+bool operator!=(FixedInt const& _lhs, FixedInt const& _rhs)
+{
+    return !(_lhs == _rhs);
+}
+
+bool operator<(FixedInt const& _lhs, FixedInt const& _rhs)
+{
+    if (_lhs.m_negative != _rhs.m_negative) return _lhs.m_negative;
+    for (size_t i = FixedInt::LIMBS; i > 0; --i)
+    {
+        if (_lhs.m_limbs[i - 1] != _rhs.m_limbs[i - 1])
+        {
+            return _lhs.m_limbs[i - 1] < _rhs.m_limbs[i - 1];
+        }
+    }
+    return false;
+}
+
+bool operator>(FixedInt const& _lhs, FixedInt const& _rhs)
+{
+    return _rhs < _lhs;
+}
+
+bool operator<=(FixedInt const& _lhs, FixedInt const& _rhs)
+{
+    return !(_rhs < _lhs);
+}
+
+bool operator>=(FixedInt const& _lhs, FixedInt const& _rhs)
+{
+    return !(_lhs < _rhs);
+}
+
+// -------------------------------------------------------------------------- //
+
+}
+}
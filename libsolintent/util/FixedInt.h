@@ -0,0 +1,162 @@
+/**
+ * Solidity evaluates constant expressions over arbitrary-precision rationals.
+ * In practice, nearly every such value is an integer which fits within an EVM
+ * word. This module provides a fixed-width integer for this common case, so
+ * that constant folding does not pay for heap allocation and normalization.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Fixed-width 256-bit integer values.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/Types.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * A 256-bit integer with inline storage. The value is stored as four 64-bit
+ * limbs, in two's complement, with an additional sign bit. This allows a single
+ * type to span both the uint256 and int256 domains. That is, all values in the
+ * range [-(2^256 - 1), 2^256 - 1] are representable.
+ *
+ * Operations which leave this range return nullopt. This allows the caller to
+ * fall back to arbitrary-precision arithmetic.
+ */
+class FixedInt
+{
+public:
+    // The number of 64-bit limbs used to store the word.
+    static constexpr size_t LIMBS = 4;
+
+    /**
+     * Constructs the integer zero.
+     */
+    FixedInt() = default;
+
+    /**
+     * Constructs an integer from a machine word.
+     *
+     * _val: the value to store.
+     */
+    explicit FixedInt(int64_t _val);
+
+    /**
+     * Converts a rational to a FixedInt. If the rational is fractional, or if
+     * it is out of range, then nullopt is returned.
+     *
+     * _val: the value to convert.
+     */
+    static std::optional<FixedInt> fromRational(solidity::rational const& _val);
+
+    /**
+     * Converts this value back to an arbitrary-precision rational.
+     */
+    solidity::rational toRational() const;
+
+    /**
+     * Converts this value to a machine word, if it is in range.
+     */
+    std::optional<int64_t> toInt64() const;
+
+    /**
+     * Returns true if this value is strictly less than zero.
+     */
+    bool isNegative() const { return m_negative; }
+
+    /**
+     * Returns true if this value is equal to zero.
+     */
+    bool isZero() const;
+
+    /**
+     * Returns true if this value is within the int256 domain.
+     */
+    bool fitsSigned() const;
+
+    /**
+     * Returns true if this value is within the uint256 domain.
+     */
+    bool fitsUnsigned() const { return !m_negative; }
+
+    /**
+     * Checked arithmetic. Division truncates towards zero, and the remainder
+     * takes the sign of the dividend, as in Solidity. Division by zero yields
+     * nullopt.
+     */
+    std::optional<FixedInt> add(FixedInt const& _rhs) const;
+    std::optional<FixedInt> sub(FixedInt const& _rhs) const;
+    std::optional<FixedInt> mul(FixedInt const& _rhs) const;
+    std::optional<FixedInt> div(FixedInt const& _rhs) const;
+    std::optional<FixedInt> mod(FixedInt const& _rhs) const;
+
+    /**
+     * Returns the additive inverse of this value. As the range is symmetric,
+     * this operation is total.
+     */
+    FixedInt negate() const;
+
+    /**
+     * Produces a hash of this value, for use in hashed containers.
+     */
+    size_t hash() const;
+
+    friend bool operator==(FixedInt const& _lhs, FixedInt const& _rhs);
+    friend bool operator<(FixedInt const& _lhs, FixedInt const& _rhs);
+
+private:
+    using Limbs = std::array<uint64_t, LIMBS>;
+
+    /**
+     * Constructs a value from its raw encoding. This assumes that the encoding
+     * is in range.
+     */
+    FixedInt(Limbs _limbs, bool _negative);
+
+    /**
+     * Returns the absolute value of this integer, as an unsigned word.
+     */
+    Limbs magnitude() const;
+
+    /**
+     * Reconstructs a value from its sign and magnitude.
+     */
+    static FixedInt fromMagnitude(Limbs const& _mag, bool _negative);
+
+    /**
+     * Computes the quotient and remainder of two unsigned words. This assumes
+     * _den is non-zero.
+     */
+    static void divmod(
+        Limbs const& _num, Limbs const& _den, Limbs & _quot, Limbs & _rem
+    );
+
+    // The low 256 bits of the two's complement encoding.
+    Limbs m_limbs{{0, 0, 0, 0}};
+    // The sign bit, extending m_limbs to a 257-bit two's complement integer.
+    bool m_negative{false};
+};
+
+bool operator==(FixedInt const& _lhs, FixedInt const& _rhs);
+bool operator!=(FixedInt const& _lhs, FixedInt const& _rhs);
+bool operator<(FixedInt const& _lhs, FixedInt const& _rhs);
+bool operator>(FixedInt const& _lhs, FixedInt const& _rhs);
+bool operator<=(FixedInt const& _lhs, FixedInt const& _rhs);
+bool operator>=(FixedInt const& _lhs, FixedInt const& _rhs);
+
+// -------------------------------------------------------------------------- //
+
+}
+}
@@ -0,0 +1,279 @@
+/**
+ * Sources which never import one another can be compiled, and analyzed, in
+ * isolation. This module recovers the import graph of a corpus without parsing
+ * it, so that the corpus can be split into its weakly connected components.
+ * Each component can then be compiled and released in turn.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * A lightweight import graph over a set of sources.
+ */
+
+#include <libsolintent/util/ImportGraph.h>
+
+#include <boost/filesystem/path.hpp>
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+namespace
+{
+
+/**
+ * Returns true if _c may appear within an identifier.
+ */
+bool isIdentifierChar(char _c)
+{
+    return (_c >= 'a' && _c <= 'z') || (_c >= 'A' && _c <= 'Z')
+        || (_c >= '0' && _c <= '9') || _c == '_' || _c == '$';
+}
+
+/**
+ * Returns true if _prefix is a prefix of _str.
+ */
+bool startsWith(string const& _str, string const& _prefix)
+{
+    return _str.compare(0, _prefix.size(), _prefix) == 0;
+}
+
+/**
+ * Finds the representative of _i, compressing the path as it goes.
+ */
+size_t findRoot(vector<size_t> & _parents, size_t _i)
+{
+    while (_parents[_i] != _i)
+    {
+        _parents[_i] = _parents[_parents[_i]];
+        _i = _parents[_i];
+    }
+    return _i;
+}
+
+}
+
+// -------------------------------------------------------------------------- //
+
+ImportGraph::ImportGraph(vector<Remapping> _remappings, Reader _reader)
+    : m_remappings(move(_remappings))
+    , m_reader(move(_reader))
+{
+}
+
+void ImportGraph::addSource(string const& _name, string_view _source)
+{
+    // A source which was reached as an import is now part of the set.
+    m_external.erase(_name);
+
+    auto & imports = m_imports[_name];
+    for (auto const& path : scanImports(_source))
+    {
+        imports.push_back(resolve(path, _name));
+    }
+    follow(imports);
+}
+
+vector<vector<string>> ImportGraph::components() const
+{
+    // Sources in the set are numbered first, by name, and are followed by the
+    // sources outside of the set. A root is always the smallest member, so a
+    // component which reaches the set is rooted within the set.
+    vector<string const*> names;
+    names.reserve(m_imports.size() + m_external.size());
+    for (auto const& entry : m_imports) names.push_back(&entry.first);
+    size_t const INPUTS = names.size();
+    for (auto const& entry : m_external) names.push_back(&entry.first);
+
+    unordered_map<string, size_t> indices;
+    indices.reserve(names.size());
+    for (size_t j = 0; j < names.size(); ++j) indices.emplace(*names[j], j);
+
+    vector<size_t> parents(names.size());
+    iota(parents.begin(), parents.end(), 0);
+
+    auto const JOIN = [&](string const& _name, vector<string> const& _imports) {
+        size_t const I = indices.at(_name);
+        for (auto const& import : _imports)
+        {
+            auto const ITR = indices.find(import);
+            if (ITR == indices.end()) continue;
+
+            size_t const LHS = findRoot(parents, I);
+            size_t const RHS = findRoot(parents, ITR->second);
+            parents[max(LHS, RHS)] = min(LHS, RHS);
+        }
+    };
+    for (auto const& entry : m_imports) JOIN(entry.first, entry.second);
+    for (auto const& entry : m_external) JOIN(entry.first, entry.second);
+
+    // Roots are always the smallest member, so components come out in order.
+    vector<vector<string>> components;
+    vector<size_t> slots(names.size(), names.size());
+    for (size_t j = 0; j < INPUTS; ++j)
+    {
+        size_t const ROOT = findRoot(parents, j);
+        if (slots[ROOT] == names.size())
+        {
+            slots[ROOT] = components.size();
+            components.emplace_back();
+        }
+        components[slots[ROOT]].push_back(*names[j]);
+    }
+    return components;
+}
+
+void ImportGraph::follow(vector<string> const& _imports)
+{
+    // Each external source is recorded before it is read, so that it is read
+    // at most once, even if it cannot be read at all.
+    vector<string> worklist;
+    auto const ENQUEUE = [&](vector<string> const& _paths) {
+        for (auto const& path : _paths)
+        {
+            if (m_imports.count(path) > 0) continue;
+            if (m_external.emplace(path, vector<string>{}).second)
+            {
+                worklist.push_back(path);
+            }
+        }
+    };
+
+    ENQUEUE(_imports);
+    while (m_reader && !worklist.empty())
+    {
+        string const NAME = move(worklist.back());
+        worklist.pop_back();
+
+        auto const SOURCE = m_reader(NAME);
+        if (!SOURCE.has_value()) continue;
+
+        auto & imports = m_external[NAME];
+        for (auto const& path : scanImports(*SOURCE))
+        {
+            imports.push_back(resolve(path, NAME));
+        }
+        ENQUEUE(imports);
+    }
+}
+
+vector<string> ImportGraph::scanImports(string_view _source)
+{
+    vector<string> imports;
+
+    bool pending = false;
+    size_t i = 0;
+    while (i < _source.size())
+    {
+        char const NEXT_CHAR = _source[i];
+        char const PEEK = (i + 1 < _source.size()) ? _source[i + 1] : 0;
+        if (NEXT_CHAR == '/' && PEEK == '/')
+        {
+            size_t const END = _source.find('\n', i);
+            i = (END == string_view::npos) ? _source.size() : END + 1;
+        }
+        else if (NEXT_CHAR == '/' && PEEK == '*')
+        {
+            size_t const END = _source.find("*/", i + 2);
+            i = (END == string_view::npos) ? _source.size() : END + 2;
+        }
+        else if (NEXT_CHAR == '"' || NEXT_CHAR == '\'')
+        {
+            // Import paths are taken verbatim. Escapes are only skipped.
+            size_t const START = i + 1;
+            size_t j = START;
+            while (j < _source.size() && _source[j] != NEXT_CHAR)
+            {
+                j += (_source[j] == '\\') ? 2 : 1;
+            }
+            if (pending && j <= _source.size())
+            {
+                imports.emplace_back(_source.substr(START, j - START));
+                pending = false;
+            }
+            i = j + 1;
+        }
+        else if (isIdentifierChar(NEXT_CHAR))
+        {
+            size_t j = i;
+            while (j < _source.size() && isIdentifierChar(_source[j])) ++j;
+            if (_source.substr(i, j - i) == "import") pending = true;
+            i = j;
+        }
+        else
+        {
+            if (NEXT_CHAR == ';') pending = false;
+            ++i;
+        }
+    }
+
+    return imports;
+}
+
+string ImportGraph::resolve(string const& _path, string const& _reference) const
+{
+    using boost::filesystem::path;
+
+    // Relative imports are resolved against the importing source.
+    string absolute = _path;
+    path const IMPORT(_path);
+    if (!IMPORT.empty() && (*IMPORT.begin() == "." || *IMPORT.begin() == ".."))
+    {
+        path result(_reference);
+        result.remove_filename();
+        for (auto const& component : IMPORT)
+        {
+            if (component == "..")
+            {
+                // A `..` above the reference is kept, rather than dropped, as
+                // is a `..` above the root.
+                if (result.empty() || result.filename() == "..")
+                {
+                    result /= component;
+                }
+                else if (result.has_relative_path())
+                {
+                    result = result.parent_path();
+                }
+            }
+            else if (component != ".")
+            {
+                result /= component;
+            }
+        }
+        absolute = result.generic_string();
+    }
+
+    // The longest matching context wins, and then the longest matching prefix.
+    Remapping const* best = nullptr;
+    for (auto const& remapping : m_remappings)
+    {
+        if (!startsWith(_reference, remapping.context)) continue;
+        if (!startsWith(absolute, remapping.prefix)) continue;
+
+        if (best != nullptr)
+        {
+            if (remapping.context.size() < best->context.size()) continue;
+            if (remapping.context.size() == best->context.size()
+                && remapping.prefix.size() < best->prefix.size()) continue;
+        }
+        best = &remapping;
+    }
+    if (best == nullptr) return absolute;
+
+    return best->target + absolute.substr(best->prefix.size());
+}
+
+// -------------------------------------------------------------------------- //
+
+}
+}
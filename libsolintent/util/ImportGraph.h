@@ -0,0 +1,115 @@
+/**
+ * Sources which never import one another can be compiled, and analyzed, in
+ * isolation. This module recovers the import graph of a corpus without parsing
+ * it, so that the corpus can be split into its weakly connected components.
+ * Each component can then be compiled and released in turn.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * A lightweight import graph over a set of sources.
+ */
+
+#pragma once
+
+#include <libsolidity/interface/CompilerStack.h>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * Records the import edges between a fixed set of sources. Imports are resolved
+ * as in CompilerStack: relative paths are resolved against the importing
+ * source, and then remappings are applied. Sources outside of the set are not
+ * reported, as the compiler loads them on demand. However, they still connect
+ * the sources which import them, and their own imports are followed if they can
+ * be read.
+ */
+class ImportGraph
+{
+public:
+    using Remapping = solidity::CompilerStack::Remapping;
+
+    /**
+     * Returns the text of a source outside of the set, or nullopt if it cannot
+     * be read.
+     */
+    using Reader = std::function<
+        std::optional<std::string>(std::string const&)
+    >;
+
+    /**
+     * _remappings: the remappings applied to each import.
+     * _reader: reads sources outside of the set. If empty, then their imports
+     *          are not followed.
+     */
+    explicit ImportGraph(
+        std::vector<Remapping> _remappings = {}, Reader _reader = Reader()
+    );
+
+    /**
+     * Adds a source to the graph, along with its imports.
+     *
+     * _name: the name of the source, as given to the compiler.
+     * _source: the text of the source.
+     */
+    void addSource(std::string const& _name, std::string_view _source);
+
+    /**
+     * Returns the weakly connected components of the graph, restricted to the
+     * sources which were added. Each component is sorted by name, and the
+     * components are sorted by their first names.
+     */
+    std::vector<std::vector<std::string>> components() const;
+
+    /**
+     * Returns the path of each import directive in _source, in order. This is
+     * a lexical scan, so comments and string literals are respected, but the
+     * source need not be well-formed.
+     *
+     * _source: the text to scan.
+     */
+    static std::vector<std::string> scanImports(std::string_view _source);
+
+    /**
+     * Resolves an import path, as written in _reference, to a source name.
+     *
+     * _path: the path given by the import directive.
+     * _reference: the name of the importing source.
+     */
+    std::string resolve(
+        std::string const& _path, std::string const& _reference
+    ) const;
+
+private:
+    /**
+     * Reads and scans each source reachable from _imports which is neither in
+     * the set, nor already scanned.
+     */
+    void follow(std::vector<std::string> const& _imports);
+
+    // The remappings applied to each import.
+    std::vector<Remapping> m_remappings;
+    // Reads sources outside of the set.
+    Reader m_reader;
+    // Maps each source to the resolved paths of its imports.
+    std::map<std::string, std::vector<std::string>> m_imports;
+    // Maps each source outside of the set to the resolved paths of its imports.
+    std::map<std::string, std::vector<std::string>> m_external;
+};
+
+// -------------------------------------------------------------------------- //
+
+}
+}
@@ -0,0 +1,131 @@
+/**
+ * Every import is resolved against the set of allowed directories. Large
+ * projects issue thousands of imports against hundreds of directories, so both
+ * canonicalization and the directory check dominate import resolution. This
+ * module provides a prefix trie for the directory check, and a memoized
+ * canonicalization which is shared across a run.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Utilities to resolve and authorize import paths.
+ */
+
+#include <libsolintent/util/ImportPaths.h>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/system/error_code.hpp>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+namespace
+{
+
+/**
+ * Returns true if the component does not affect prefix matching.
+ */
+bool isSkipped(boost::filesystem::path const& _component)
+{
+    return _component.empty() || _component == ".";
+}
+
+}
+
+// -------------------------------------------------------------------------- //
+
+void PathTrie::insert(boost::filesystem::path const& _dir)
+{
+    Node* node = &m_root;
+    for (auto const& component : _dir)
+    {
+        if (isSkipped(component)) continue;
+
+        auto & child = node->children[component.string()];
+        if (!child) child = make_unique<Node>();
+        node = child.get();
+    }
+    node->terminal = true;
+    m_empty = false;
+}
+
+bool PathTrie::containsPrefixOf(boost::filesystem::path const& _path) const
+{
+    Node const* node = &m_root;
+    if (node->terminal) return true;
+
+    for (auto const& component : _path)
+    {
+        if (isSkipped(component)) continue;
+
+        auto const ITR = node->children.find(component.string());
+        if (ITR == node->children.end()) return false;
+
+        node = ITR->second.get();
+        if (node->terminal) return true;
+    }
+    return false;
+}
+
+bool PathTrie::empty() const
+{
+    return m_empty;
+}
+
+// -------------------------------------------------------------------------- //
+
+boost::filesystem::path const& CanonicalPathCache::canonical(
+    boost::filesystem::path const& _path
+)
+{
+    namespace fs = boost::filesystem;
+
+    string const KEY = _path.generic_string();
+    auto const ITR = m_cache.find(KEY);
+    if (ITR != m_cache.end()) return ITR->second;
+
+    // If the leaf is neither a link nor a relative step, then it is canonical
+    // relative to its (canonical) parent. Otherwise, the full path is resolved.
+    fs::path result;
+    auto const LEAF = _path.filename();
+    if (_path.has_parent_path() && !isSkipped(LEAF) && LEAF != "..")
+    {
+        // Elements of unordered_map are stable, so PARENT survives insertion.
+        auto const& PARENT = canonical(_path.parent_path());
+
+        boost::system::error_code ec;
+        auto const STATUS = fs::symlink_status(PARENT / LEAF, ec);
+        if (STATUS.type() != fs::symlink_file)
+        {
+            result = PARENT / LEAF;
+        }
+    }
+    if (result.empty())
+    {
+        result = fs::weakly_canonical(_path);
+    }
+
+    return m_cache.emplace(KEY, move(result)).first->second;
+}
+
+void CanonicalPathCache::clear()
+{
+    m_cache.clear();
+}
+
+size_t CanonicalPathCache::size() const
+{
+    return m_cache.size();
+}
+
+// -------------------------------------------------------------------------- //
+
+}
+}
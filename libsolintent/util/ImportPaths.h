@@ -0,0 +1,114 @@
+/**
+ * Every import is resolved against the set of allowed directories. Large
+ * projects issue thousands of imports against hundreds of directories, so both
+ * canonicalization and the directory check dominate import resolution. This
+ * module provides a prefix trie for the directory check, and a memoized
+ * canonicalization which is shared across a run.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Utilities to resolve and authorize import paths.
+ */
+
+#pragma once
+
+#include <boost/filesystem/path.hpp>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * A trie over path components. A path is matched if some inserted directory is
+ * a component-wise prefix of it. For example, /a/b matches /a/b/c.sol, but not
+ * /a/bc.sol or /a.
+ */
+class PathTrie
+{
+public:
+    /**
+     * Allows all paths beneath the given directory. Empty components and "."
+     * components are ignored.
+     *
+     * _dir: the directory to allow.
+     */
+    void insert(boost::filesystem::path const& _dir);
+
+    /**
+     * Returns true if some inserted directory is a prefix of _path. The check
+     * is purely lexical, so _path should already be canonical.
+     *
+     * _path: the path to check.
+     */
+    bool containsPrefixOf(boost::filesystem::path const& _path) const;
+
+    /**
+     * Returns true if no directory has been inserted.
+     */
+    bool empty() const;
+
+private:
+    /**
+     * A single path component. If terminal, then an inserted directory ends at
+     * this node.
+     */
+    struct Node
+    {
+        bool terminal = false;
+        std::map<std::string, std::unique_ptr<Node>> children;
+    };
+
+    // The root of the trie, corresponding to the empty path.
+    Node m_root;
+    // True if at least one directory has been inserted.
+    bool m_empty = true;
+};
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * Memoizes weakly_canonical. Canonicalization is also memoized by directory,
+ * so that a new file within a known directory costs a single lstat, rather than
+ * one per component.
+ *
+ * Note: the cache assumes the file system is not modified during a run.
+ */
+class CanonicalPathCache
+{
+public:
+    /**
+     * Returns the equivalent of weakly_canonical(_path). The reference is valid
+     * until the cache is cleared or destroyed.
+     *
+     * _path: the path to canonicalize.
+     */
+    boost::filesystem::path const& canonical(boost::filesystem::path const& _path);
+
+    /**
+     * Drops all cached paths.
+     */
+    void clear();
+
+    /**
+     * Returns the number of cached paths.
+     */
+    size_t size() const;
+
+private:
+    // Maps each path, in generic form, to its canonical path.
+    std::unordered_map<std::string, boost::filesystem::path> m_cache;
+};
+
+// -------------------------------------------------------------------------- //
+
+}
+}
@@ -0,0 +1,185 @@
+/**
+ * A corpus scan may run for hours. If the scan dies, then all completed work
+ * should survive it. This module records the result of each project in an
+ * append-only log, one record per line. Each record is written once its project
+ * is complete, so a crash loses at most the project in progress. On restart,
+ * the log is replayed, and projects with unchanged inputs are skipped. The log
+ * also serves as a results database, which may be queried after the scan.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * An append-only log of per-project results.
+ */
+
+#include <libsolintent/util/ResultsLog.h>
+
+#include <boost/filesystem/operations.hpp>
+#include <memory>
+#include <stdexcept>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+ResultsLog::ResultsLog(string _path): m_path(move(_path))
+{
+    namespace fs = boost::filesystem;
+
+    // Only whole lines are replayed. A partial tail is cut from the log, so
+    // that the next record starts on a fresh line.
+    uintmax_t intact = 0;
+    {
+        ifstream in(m_path, ios::binary);
+        string line;
+        while (getline(in, line))
+        {
+            if (in.eof()) break;
+            intact += line.size() + 1;
+            replay(line);
+        }
+    }
+    if (fs::exists(m_path) && fs::file_size(m_path) != intact)
+    {
+        fs::resize_file(m_path, intact);
+    }
+
+    m_out.open(m_path, ios::binary | ios::app);
+    if (!m_out)
+    {
+        throw runtime_error("Unable to open results log: " + m_path);
+    }
+}
+
+ResultsLog::Entry const* ResultsLog::find(string const& _project) const
+{
+    auto const ITR = m_entries.find(_project);
+    if (ITR == m_entries.end()) return nullptr;
+    return &ITR->second;
+}
+
+bool ResultsLog::isCurrent(string const& _project, string const& _digest) const
+{
+    auto const* ENTRY = find(_project);
+    return ENTRY != nullptr && ENTRY->complete && ENTRY->digest == _digest;
+}
+
+void ResultsLog::append(Entry _entry)
+{
+    Json::Value record(Json::objectValue);
+    record["project"] = _entry.project;
+    record["digest"] = _entry.digest;
+    record["complete"] = _entry.complete;
+    record["findings"] = _entry.findings;
+
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "";
+    m_out << Json::writeString(builder, record) << '\n';
+    m_out.flush();
+    if (!m_out)
+    {
+        throw runtime_error("Unable to write results log: " + m_path);
+    }
+
+    auto const KEY = _entry.project;
+    m_entries[KEY] = move(_entry);
+}
+
+map<string, ResultsLog::Entry> const& ResultsLog::entries() const
+{
+    return m_entries;
+}
+
+map<string, vector<ResultsLog::ProposedBound>> ResultsLog::proposedBounds() const
+{
+    map<string, vector<ProposedBound>> bounds;
+    for (auto const& entry : m_entries)
+    {
+        for (auto const& finding : entry.second.findings)
+        {
+            if (!finding.isObject() || !finding["bound"].isIntegral()) continue;
+
+            bounds[finding["rule"].asString()].push_back({
+                entry.first,
+                finding["source"].asString(),
+                finding["line"].asInt64(),
+                finding["column"].asInt64(),
+                finding["bound"].asInt64()
+            });
+        }
+    }
+    return bounds;
+}
+
+string ResultsLog::digest(
+    map<string, string_view> const& _sources, string_view _options
+)
+{
+    // 64-bit FNV-1a. The length of each field is mixed in, so that the fields
+    // of adjacent sources cannot be shifted into one another.
+    uint64_t hash = 0xcbf29ce484222325ull;
+    auto const mix = [&hash](string_view _data) {
+        for (unsigned char const NEXT_CHAR : _data)
+        {
+            hash = (hash ^ NEXT_CHAR) * 0x100000001b3ull;
+        }
+    };
+    auto const mixSize = [&mix](size_t _size) {
+        string const STR = to_string(_size) + ":";
+        mix(STR);
+    };
+
+    mixSize(_options.size());
+    mix(_options);
+    for (auto const& source : _sources)
+    {
+        mixSize(source.first.size());
+        mix(source.first);
+        mixSize(source.second.size());
+        mix(source.second);
+    }
+
+    static char const* const HEX = "0123456789abcdef";
+    string result(16, '0');
+    for (size_t i = 0; i < 16; ++i)
+    {
+        result[15 - i] = HEX[(hash >> (4 * i)) & 0xf];
+    }
+    return result;
+}
+
+bool ResultsLog::replay(string const& _line)
+{
+    Json::CharReaderBuilder builder;
+    unique_ptr<Json::CharReader> const READER(builder.newCharReader());
+
+    Json::Value record;
+    string errors;
+    char const* const BEGIN = _line.data();
+    if (!READER->parse(BEGIN, BEGIN + _line.size(), &record, &errors))
+    {
+        return false;
+    }
+    if (!record.isObject() || !record["project"].isString()) return false;
+
+    Entry entry;
+    entry.project = record["project"].asString();
+    entry.digest = record["digest"].asString();
+    entry.complete = record["complete"].asBool();
+    entry.findings = record["findings"];
+
+    auto const KEY = entry.project;
+    m_entries[KEY] = move(entry);
+    return true;
+}
+
+// -------------------------------------------------------------------------- //
+
+}
+}
@@ -0,0 +1,142 @@
+/**
+ * A corpus scan may run for hours. If the scan dies, then all completed work
+ * should survive it. This module records the result of each project in an
+ * append-only log, one record per line. Each record is written once its project
+ * is complete, so a crash loses at most the project in progress. On restart,
+ * the log is replayed, and projects with unchanged inputs are skipped. The log
+ * also serves as a results database, which may be queried after the scan.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * An append-only log of per-project results.
+ */
+
+#pragma once
+
+#include <json/json.h>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * Each line of the log is a JSON object of the form:
+ *   {"project":..., "digest":..., "complete":..., "findings":[...]}
+ * where each finding is a JSON Lines finding (see JsonLinesReporter). If the
+ * same project appears more than once, then the last record wins.
+ */
+class ResultsLog
+{
+public:
+    /**
+     * The outcome of analyzing a single project.
+     */
+    struct Entry
+    {
+        // The name of the project (i.e., its path).
+        std::string project;
+        // The digest of the project's inputs.
+        std::string digest;
+        // False if the project could not be analyzed.
+        bool complete;
+        // The findings of the project, as an array of objects.
+        Json::Value findings;
+    };
+
+    /**
+     * A single proposed bound, as recovered from the log.
+     */
+    struct ProposedBound
+    {
+        std::string project;
+        std::string source;
+        int64_t line;
+        int64_t column;
+        int64_t bound;
+    };
+
+    /**
+     * Opens the log at _path, creating it if required, and replays it. If the
+     * last record is incomplete (i.e., the writer died mid-record), then it is
+     * truncated. A runtime_error is raised if the log cannot be opened.
+     *
+     * _path: the path to the log.
+     */
+    explicit ResultsLog(std::string _path);
+
+    /**
+     * Returns the latest entry of _project, or nullptr if there is none.
+     *
+     * _project: the name of the project.
+     */
+    Entry const* find(std::string const& _project) const;
+
+    /**
+     * Returns true if _project was analyzed to completion with inputs matching
+     * _digest. Such a project need not be analyzed again.
+     *
+     * _project: the name of the project.
+     * _digest: the digest of the project's current inputs.
+     */
+    bool isCurrent(std::string const& _project, std::string const& _digest) const;
+
+    /**
+     * Appends an entry to the log, and then flushes the log.
+     *
+     * _entry: the entry to record.
+     */
+    void append(Entry _entry);
+
+    /**
+     * Returns the latest entry of each project, by project name.
+     */
+    std::map<std::string, Entry> const& entries() const;
+
+    /**
+     * Returns each proposed bound in the log, grouped by rule. Bounds are given
+     * in order of project, and then in order of discovery.
+     */
+    std::map<std::string, std::vector<ProposedBound>> proposedBounds() const;
+
+    /**
+     * Computes a digest over a set of named sources, and the options under
+     * which they are analyzed. The digest is sensitive to the names and the
+     * contents of the sources, and to the options.
+     *
+     * _sources: maps each source name to its contents.
+     * _options: a canonical description of the analysis options.
+     */
+    static std::string digest(
+        std::map<std::string, std::string_view> const& _sources,
+        std::string_view _options = std::string_view()
+    );
+
+private:
+    /**
+     * Interprets a single line of the log. Returns false if it is malformed.
+     */
+    bool replay(std::string const& _line);
+
+    // The path to the log.
+    std::string const m_path;
+    // The latest entry of each project.
+    std::map<std::string, Entry> m_entries;
+    // The log, opened for appending.
+    std::ofstream m_out;
+};
+
+// -------------------------------------------------------------------------- //
+
+}
+}
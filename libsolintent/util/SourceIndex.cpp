@@ -0,0 +1,126 @@
+/**
+ * Reports often cite thousands of locations within the same handful of
+ * sources. This module indexes each source once, so that any offset may be
+ * resolved to a line and column without rescanning the source text.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Line-offset tables for annotated sources.
+ */
+
+#include <libsolintent/util/SourceIndex.h>
+
+#include <liblangutil/CharStream.h>
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+LineIndex::LineIndex(string_view _source)
+    : m_source(_source)
+{
+    // Lines average well over 16 characters in practice.
+    m_starts.reserve(_source.size() / 16 + 1);
+    m_starts.push_back(0);
+
+    // The scan is delegated to memchr, which the C library vectorizes.
+    char const* const BEGIN = _source.data();
+    char const* const END = BEGIN + _source.size();
+    char const* cur = BEGIN;
+    while (cur < END)
+    {
+        auto const* NEWLINE = static_cast<char const*>(
+            memchr(cur, '\n', static_cast<size_t>(END - cur))
+        );
+        if (!NEWLINE) break;
+        cur = NEWLINE + 1;
+        m_starts.push_back(static_cast<size_t>(cur - BEGIN));
+    }
+}
+
+LineIndex::Position LineIndex::resolve(size_t _offset) const
+{
+    _offset = min(_offset, m_source.size());
+
+    // Finds the last line starting at or before _offset.
+    auto const NEXT = upper_bound(m_starts.begin(), m_starts.end(), _offset);
+    size_t const LINE = static_cast<size_t>(NEXT - m_starts.begin());
+    return { LINE, _offset - m_starts[LINE - 1] + 1 };
+}
+
+string_view LineIndex::line(size_t _line) const
+{
+    if (_line == 0 || _line > m_starts.size()) return string_view();
+
+    size_t const START = m_starts[_line - 1];
+    size_t end = (_line < m_starts.size()) ? m_starts[_line] : m_source.size();
+    if (end > START && m_source[end - 1] == '\n') --end;
+    if (end > START && m_source[end - 1] == '\r') --end;
+    return m_source.substr(START, end - START);
+}
+
+size_t LineIndex::lineCount() const
+{
+    return m_starts.size();
+}
+
+// -------------------------------------------------------------------------- //
+
+LineIndex const* SourceIndex::index(langutil::SourceLocation const& _loc)
+{
+    if (!_loc.source) return nullptr;
+
+    auto & entry = m_indices[_loc.source.get()];
+    if (!entry.second)
+    {
+        entry.first = _loc.source;
+        entry.second = make_unique<LineIndex>(_loc.source->source());
+    }
+    return entry.second.get();
+}
+
+LineIndex::Position SourceIndex::resolve(langutil::SourceLocation const& _loc)
+{
+    return resolveOffset(_loc, _loc.start);
+}
+
+LineIndex::Position SourceIndex::resolveEnd(
+    langutil::SourceLocation const& _loc
+)
+{
+    return resolveOffset(_loc, _loc.end);
+}
+
+void SourceIndex::clear()
+{
+    m_indices.clear();
+}
+
+LineIndex::Position SourceIndex::resolveOffset(
+    langutil::SourceLocation const& _loc, int _offset
+)
+{
+    // An AST imported from JSON has no source text, so its offsets cannot be
+    // placed on a line.
+    auto const* INDEX = index(_loc);
+    if (!INDEX || _offset < 0) return { 0, 0 };
+
+    size_t const SIZE = _loc.source->source().size();
+    size_t const OFFSET = static_cast<size_t>(_offset);
+    if (SIZE == 0 || SIZE < OFFSET) return { 0, 0 };
+    return INDEX->resolve(OFFSET);
+}
+
+// -------------------------------------------------------------------------- //
+
+}
+}
@@ -0,0 +1,137 @@
+/**
+ * Reports often cite thousands of locations within the same handful of
+ * sources. This module indexes each source once, so that any offset may be
+ * resolved to a line and column without rescanning the source text.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Line-offset tables for annotated sources.
+ */
+
+#pragma once
+
+#include <liblangutil/SourceLocation.h>
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * A table of line offsets for a single source. The table is built with a
+ * single scan of the source, and each query is then answered by binary search.
+ */
+class LineIndex
+{
+public:
+    /**
+     * A resolved position. Both lines and columns are counted from 1.
+     */
+    struct Position
+    {
+        size_t line;
+        size_t column;
+    };
+
+    /**
+     * Indexes the given source. The source must outlive this index.
+     * 
+     * _source: the text to index.
+     */
+    explicit LineIndex(std::string_view _source);
+
+    /**
+     * Resolves a character offset to its line and column. Offsets beyond the
+     * end of the source are clamped to the end of the source.
+     * 
+     * _offset: the offset to resolve.
+     */
+    Position resolve(size_t _offset) const;
+
+    /**
+     * Returns a view of the given line, excluding its line terminator.
+     * 
+     * _line: the line to fetch, counting from 1.
+     */
+    std::string_view line(size_t _line) const;
+
+    /**
+     * Returns the number of lines in the source.
+     */
+    size_t lineCount() const;
+
+private:
+    // The indexed source.
+    std::string_view m_source;
+    // The offset at which each line begins. The first line begins at 0.
+    std::vector<size_t> m_starts;
+};
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * Lazily maintains a LineIndex for each source seen by a reporter. This is not
+ * thread-safe. Each reporting thread should own its own SourceIndex.
+ */
+class SourceIndex
+{
+public:
+    /**
+     * Returns the LineIndex of the source behind this location. The index is
+     * built on first use. If the location is not annotated, then nullptr is
+     * returned.
+     * 
+     * _loc: a location within the source of interest.
+     */
+    LineIndex const* index(langutil::SourceLocation const& _loc);
+
+    /**
+     * Resolves the start of a location to its line and column. If the location
+     * is not annotated, or its source text is missing or shorter than the
+     * location, then {0, 0} is returned.
+     * 
+     * _loc: the location to resolve.
+     */
+    LineIndex::Position resolve(langutil::SourceLocation const& _loc);
+
+    /**
+     * Resolves the end of a location, as in resolve.
+     * 
+     * _loc: the location to resolve.
+     */
+    LineIndex::Position resolveEnd(langutil::SourceLocation const& _loc);
+
+    /**
+     * Drops all indices, along with the sources they keep alive.
+     */
+    void clear();
+
+private:
+    /**
+     * Resolves an offset within the source of _loc, as in resolve.
+     */
+    LineIndex::Position resolveOffset(
+        langutil::SourceLocation const& _loc, int _offset
+    );
+
+    // Maps each source to its index. The sources are kept alive by the map, so
+    // that the views held by each index remain valid.
+    std::unordered_map<
+        langutil::CharStream const*,
+        std::pair<std::shared_ptr<langutil::CharStream>, std::unique_ptr<LineIndex>>
+    > m_indices;
+};
+
+// -------------------------------------------------------------------------- //
+
+}
+}
@@ -6,6 +6,8 @@
 
 #include <libsolintent/util/SourceLocation.h>
 
+#include <liblangutil/CharStream.h>
+
 using namespace std;
 
 namespace dev
@@ -15,24 +17,80 @@ namespace solintent
 
 // -------------------------------------------------------------------------- //
 
+namespace
+{
+
+/**
+ * Visits each run of the snippet, after whitespace has been collapsed. Runs are
+ * views into the original source, with collapsed whitespace emitted as a
+ * single space.
+ * 
+ * _raw: the raw snippet
+ * _emit: the callback consuming each run
+ */
+template <typename Emit>
+void collapseWhitespace(string_view _raw, Emit _emit)
+{
+    size_t run_start = 0;
+    char last_char = 0;
+    for (size_t i = 0; i < _raw.size(); ++i)
+    {
+        char const NEXT_CHAR = _raw[i];
+        bool const IS_SPACE = (NEXT_CHAR == ' ' || NEXT_CHAR == '\n');
+        if (!IS_SPACE)
+        {
+            last_char = NEXT_CHAR;
+            continue;
+        }
+
+        // Flushes the run, and then emits a single space if it is not repeated.
+        _emit(_raw.substr(run_start, i - run_start));
+        if (last_char != ' ') _emit(string_view(" "));
+        run_start = i + 1;
+        last_char = ' ';
+    }
+    _emit(_raw.substr(run_start));
+}
+
+}
+
+// -------------------------------------------------------------------------- //
+
 string srclocToStr(langutil::SourceLocation const& _loc)
 {
-	string const& SRC = _loc.source->source();
-	string const RAW_RUN = SRC.substr(_loc.start, _loc.end - _loc.start);
+    auto const RAW_RUN = srclocToView(_loc);
 
     string run;
     run.reserve(RAW_RUN.size());
+    appendSrcloc(run, _loc);
+    return run;
+}
 
-    char last_char = 0;
-    for (auto next_char : RAW_RUN)
+string_view srclocToView(langutil::SourceLocation const& _loc)
+{
+    if (!_loc.source || _loc.start < 0 || _loc.end < _loc.start)
     {
-        if (next_char == '\n') next_char = ' ';
-        if (next_char == ' ' && last_char == ' ') continue;
-        run.push_back(next_char);
-        last_char = next_char;
+        return string_view();
     }
 
-    return run;
+    string const& SRC = _loc.source->source();
+    size_t const START = min<size_t>(_loc.start, SRC.size());
+    size_t const END = min<size_t>(_loc.end, SRC.size());
+    return string_view(SRC).substr(START, END - START);
+}
+
+void writeSrcloc(ostream & _out, langutil::SourceLocation const& _loc)
+{
+    collapseWhitespace(srclocToView(_loc), [&_out](string_view _part) {
+        _out.write(_part.data(), _part.size());
+    });
+}
+
+void appendSrcloc(string & _out, langutil::SourceLocation const& _loc)
+{
+    collapseWhitespace(srclocToView(_loc), [&_out](string_view _part) {
+        _out.append(_part.data(), _part.size());
+    });
 }
 
 // -------------------------------------------------------------------------- //
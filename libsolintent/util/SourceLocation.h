@@ -7,7 +7,9 @@
 #pragma once
 
 #include <liblangutil/SourceLocation.h>
+#include <ostream>
 #include <string>
+#include <string_view>
 
 namespace dev
 {
@@ -22,5 +24,32 @@ namespace solintent
  */
 std::string srclocToStr(langutil::SourceLocation const& _loc);
 
+/**
+ * Returns a view of the raw source text at this location. No copies are made,
+ * so the view is valid for as long as the location's source is alive. If the
+ * location is not annotated, then the view is empty.
+ * 
+ * _loc: the location to analyze.
+ */
+std::string_view srclocToView(langutil::SourceLocation const& _loc);
+
+/**
+ * Writes the string corresponding to this location directly to a stream. The
+ * output is identical to srclocToStr, but no intermediate string is built.
+ * 
+ * _out: the destination stream.
+ * _loc: the location to analyze.
+ */
+void writeSrcloc(std::ostream & _out, langutil::SourceLocation const& _loc);
+
+/**
+ * Appends the string corresponding to this location to an existing buffer. The
+ * output is identical to srclocToStr.
+ * 
+ * _out: the destination buffer.
+ * _loc: the location to analyze.
+ */
+void appendSrcloc(std::string & _out, langutil::SourceLocation const& _loc);
+
 }
 }
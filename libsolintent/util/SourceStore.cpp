@@ -0,0 +1,254 @@
+/**
+ * Large audits read thousands of vendored files. Reading each file into a
+ * string, and then copying that string into each consumer, multiplies the
+ * memory traffic of every byte. This module maps each file into memory exactly
+ * once, and then hands out views of the mapping.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * A memory-mapped store of source files.
+ */
+
+#include <libsolintent/util/SourceStore.h>
+
+#include <ctime>
+#include <mutex>
+#include <stdexcept>
+
+#ifdef _WIN32
+    #include <fstream>
+    #include <iterator>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+class SourceStore::Buffer
+{
+public:
+    /**
+     * Maps the file at _path. A runtime_error is raised on failure.
+     */
+    static unique_ptr<Buffer> fromFile(string const& _path);
+
+    /**
+     * Owns the given contents directly.
+     */
+    static unique_ptr<Buffer> fromString(string _contents);
+
+    Buffer() = default;
+    ~Buffer();
+
+    Buffer(Buffer const&) = delete;
+    Buffer & operator=(Buffer const&) = delete;
+
+    /**
+     * Returns true if the file at _path is unchanged since it was mapped.
+     */
+    bool isCurrent(string const& _path) const;
+
+    string_view view() const;
+
+private:
+    // The mapped region, if the contents are mapped.
+    void* m_addr = nullptr;
+    // The length of the mapped region.
+    size_t m_size = 0;
+    // The modification time of the file when it was mapped, to the nanosecond
+    // where the platform allows.
+    timespec m_mtime{0, 0};
+    // The contents, if they are not mapped.
+    string m_owned;
+};
+
+// -------------------------------------------------------------------------- //
+
+#ifdef _WIN32
+
+unique_ptr<SourceStore::Buffer> SourceStore::Buffer::fromFile(
+    string const& _path
+)
+{
+    ifstream in(_path, ios::binary);
+    if (!in) throw runtime_error("Unable to open " + _path + ".");
+
+    auto buffer = make_unique<Buffer>();
+    buffer->m_owned.assign(
+        istreambuf_iterator<char>(in), istreambuf_iterator<char>()
+    );
+    return buffer;
+}
+
+bool SourceStore::Buffer::isCurrent(string const&) const
+{
+    return false;
+}
+
+SourceStore::Buffer::~Buffer()
+{
+}
+
+#else
+
+namespace
+{
+
+/**
+ * Returns the modification time recorded by _info.
+ */
+timespec mtimeOf(struct stat const& _info)
+{
+#ifdef __APPLE__
+    return _info.st_mtimespec;
+#else
+    return _info.st_mtim;
+#endif
+}
+
+}
+
+unique_ptr<SourceStore::Buffer> SourceStore::Buffer::fromFile(
+    string const& _path
+)
+{
+    int const FD = ::open(_path.c_str(), O_RDONLY);
+    if (FD < 0) throw runtime_error("Unable to open " + _path + ".");
+
+    struct stat info;
+    if (::fstat(FD, &info) != 0 || !S_ISREG(info.st_mode))
+    {
+        ::close(FD);
+        throw runtime_error("Unable to stat " + _path + ".");
+    }
+
+    auto buffer = make_unique<Buffer>();
+    buffer->m_size = static_cast<size_t>(info.st_size);
+    buffer->m_mtime = mtimeOf(info);
+
+    // Empty files cannot be mapped, though their view is trivially empty.
+    if (buffer->m_size > 0)
+    {
+        void* addr = ::mmap(
+            nullptr, buffer->m_size, PROT_READ, MAP_PRIVATE, FD, 0
+        );
+        if (addr == MAP_FAILED)
+        {
+            ::close(FD);
+            throw runtime_error("Unable to map " + _path + ".");
+        }
+        ::madvise(addr, buffer->m_size, MADV_SEQUENTIAL);
+        buffer->m_addr = addr;
+    }
+
+    // The mapping remains valid once the descriptor is closed.
+    ::close(FD);
+    return buffer;
+}
+
+bool SourceStore::Buffer::isCurrent(string const& _path) const
+{
+    if (m_addr == nullptr && !m_owned.empty()) return false;
+
+    struct stat info;
+    if (::stat(_path.c_str(), &info) != 0) return false;
+    // A second-granularity timestamp would miss edits of the same size within
+    // one second.
+    auto const MTIME = mtimeOf(info);
+    return static_cast<size_t>(info.st_size) == m_size
+        && MTIME.tv_sec == m_mtime.tv_sec
+        && MTIME.tv_nsec == m_mtime.tv_nsec;
+}
+
+SourceStore::Buffer::~Buffer()
+{
+    if (m_addr != nullptr) ::munmap(m_addr, m_size);
+}
+
+#endif
+
+unique_ptr<SourceStore::Buffer> SourceStore::Buffer::fromString(
+    string _contents
+)
+{
+    auto buffer = make_unique<Buffer>();
+    buffer->m_owned = move(_contents);
+    return buffer;
+}
+
+string_view SourceStore::Buffer::view() const
+{
+    if (m_addr == nullptr) return m_owned;
+    return string_view(static_cast<char const*>(m_addr), m_size);
+}
+
+// -------------------------------------------------------------------------- //
+
+SourceStore::SourceStore()
+{
+}
+
+SourceStore::~SourceStore()
+{
+}
+
+string_view SourceStore::load(string const& _path)
+{
+    lock_guard<mutex> const LOCK(m_mutex);
+    auto itr = m_buffers.find(_path);
+    if (itr != m_buffers.end() && itr->second->isCurrent(_path))
+    {
+        return itr->second->view();
+    }
+
+    auto buffer = Buffer::fromFile(_path);
+    auto const VIEW = buffer->view();
+    replace(_path, move(buffer));
+    return VIEW;
+}
+
+string_view SourceStore::adopt(string const& _name, string _contents)
+{
+    lock_guard<mutex> const LOCK(m_mutex);
+    auto buffer = Buffer::fromString(move(_contents));
+    auto const VIEW = buffer->view();
+    replace(_name, move(buffer));
+    return VIEW;
+}
+
+void SourceStore::release(string const& _name)
+{
+    lock_guard<mutex> const LOCK(m_mutex);
+    m_buffers.erase(_name);
+    m_retired.erase(_name);
+}
+
+void SourceStore::replace(string const& _name, unique_ptr<Buffer> _buffer)
+{
+    auto & current = m_buffers[_name];
+    if (current) m_retired[_name].push_back(move(current));
+    current = move(_buffer);
+}
+
+size_t SourceStore::size() const
+{
+    lock_guard<mutex> const LOCK(m_mutex);
+    return m_buffers.size();
+}
+
+// -------------------------------------------------------------------------- //
+
+}
+}
@@ -0,0 +1,111 @@
+/**
+ * Large audits read thousands of vendored files. Reading each file into a
+ * string, and then copying that string into each consumer, multiplies the
+ * memory traffic of every byte. This module maps each file into memory exactly
+ * once, and then hands out views of the mapping.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * A memory-mapped store of source files.
+ */
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * Owns the contents of each source file. Files are memory-mapped where the
+ * platform allows, so that their pages are shared with the page cache. Views
+ * returned by the store remain valid until the source is released, or the store
+ * is destroyed.
+ *
+ * A store may outlive a single compilation. Loading an unmodified file a second
+ * time returns the existing mapping, so that batch runs reuse resident pages. A
+ * file which is modified is mapped again, though its earlier mapping is kept
+ * until release, so that earlier views are not left dangling. Paths are used
+ * as given, so callers should canonicalize them to avoid mapping a file twice.
+ *
+ * A store may be shared between threads. However, a source must not be released
+ * by one thread while another thread holds a view of it.
+ */
+class SourceStore
+{
+public:
+    SourceStore();
+    ~SourceStore();
+
+    SourceStore(SourceStore const&) = delete;
+    SourceStore & operator=(SourceStore const&) = delete;
+
+    /**
+     * Returns a view of the file at the given path, loading it if required. A
+     * runtime_error is raised if the file cannot be read.
+     *
+     * _path: the path of the file to load.
+     */
+    std::string_view load(std::string const& _path);
+
+    /**
+     * Takes ownership of a source which does not live on disk (i.e., stdin).
+     * Any source previously stored under this name is replaced, though it is
+     * kept until release.
+     *
+     * _name: the name under which the source is stored.
+     * _contents: the text of the source.
+     */
+    std::string_view adopt(std::string const& _name, std::string _contents);
+
+    /**
+     * Releases the given source, if it is stored, along with any earlier
+     * versions of it. All views of it are then invalid.
+     *
+     * _name: the path or name of the source.
+     */
+    void release(std::string const& _name);
+
+    /**
+     * Returns the number of sources currently held, excluding earlier versions.
+     */
+    size_t size() const;
+
+private:
+    /**
+     * A single source. Exactly one of m_addr and m_owned holds the contents.
+     */
+    class Buffer;
+
+    /**
+     * Replaces the contents stored under _name, keeping any earlier contents
+     * until release. Assumes m_mutex is held.
+     */
+    void replace(std::string const& _name, std::unique_ptr<Buffer> _buffer);
+
+    // Guards m_buffers and m_retired.
+    mutable std::mutex m_mutex;
+    // Maps each path (or name) to its contents.
+    std::unordered_map<std::string, std::unique_ptr<Buffer>> m_buffers;
+    // Maps each path (or name) to its earlier contents, which may still be
+    // viewed.
+    std::unordered_map<
+        std::string, std::vector<std::unique_ptr<Buffer>>
+    > m_retired;
+};
+
+// -------------------------------------------------------------------------- //
+
+}
+}
@@ -0,0 +1,168 @@
+/**
+ * Abduction runs each pattern against each suspect. The cost of a job varies
+ * widely (a loop over a large contract dwarfs a loop over a small one), so a
+ * static split of the jobs leaves threads idle. This module provides a thread
+ * pool in which each thread owns a queue of jobs, and an idle thread steals from
+ * the queues of its peers.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * A work-stealing thread pool.
+ */
+
+#include <libsolintent/util/WorkStealingPool.h>
+
+#include <algorithm>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+WorkStealingPool::WorkStealingPool(size_t _workers)
+{
+    if (_workers == 0)
+    {
+        _workers = max<size_t>(thread::hardware_concurrency(), 1);
+    }
+
+    for (size_t i = 0; i < _workers; ++i)
+    {
+        m_queues.push_back(make_unique<Queue>());
+    }
+    for (size_t i = 1; i < _workers; ++i)
+    {
+        m_threads.emplace_back([this, i] { work(i); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        lock_guard<mutex> const LOCK(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (auto & worker : m_threads) worker.join();
+}
+
+size_t WorkStealingPool::size() const
+{
+    return m_queues.size();
+}
+
+void WorkStealingPool::parallelFor(size_t _count, Job const& _job)
+{
+    if (_count == 0) return;
+
+    // The job and count are published before any index, so a straggler from a
+    // previous call which finds an index also finds the right job.
+    m_job = &_job;
+    m_remaining = _count;
+
+    size_t const WORKERS = m_queues.size();
+    for (size_t i = 0; i < WORKERS; ++i)
+    {
+        auto & queue = *m_queues[i];
+        lock_guard<mutex> const LOCK(queue.mutex);
+        for (size_t j = i * _count / WORKERS; j < (i + 1) * _count / WORKERS; ++j)
+        {
+            queue.jobs.push_back(j);
+        }
+    }
+
+    {
+        lock_guard<mutex> const LOCK(m_mutex);
+        ++m_epoch;
+    }
+    m_wake.notify_all();
+
+    drain(0);
+
+    exception_ptr error;
+    {
+        unique_lock<mutex> lock(m_mutex);
+        m_done.wait(lock, [this] { return m_remaining == 0; });
+        swap(error, m_error);
+    }
+    if (error) rethrow_exception(error);
+}
+
+void WorkStealingPool::work(size_t _worker)
+{
+    size_t seen = 0;
+    while (true)
+    {
+        {
+            unique_lock<mutex> lock(m_mutex);
+            m_wake.wait(lock, [&] { return m_stopping || m_epoch != seen; });
+            if (m_stopping) return;
+            seen = m_epoch;
+        }
+        drain(_worker);
+    }
+}
+
+void WorkStealingPool::drain(size_t _worker)
+{
+    while (auto const NEXT = take(_worker))
+    {
+        try
+        {
+            (*m_job)(_worker, NEXT.value());
+        }
+        catch (...)
+        {
+            lock_guard<mutex> const LOCK(m_mutex);
+            if (!m_error) m_error = current_exception();
+        }
+
+        if (--m_remaining == 0)
+        {
+            // Taking the lock ensures the caller is either waiting, or has yet
+            // to check m_remaining.
+            lock_guard<mutex> const LOCK(m_mutex);
+            m_done.notify_all();
+        }
+    }
+}
+
+optional<size_t> WorkStealingPool::take(size_t _worker)
+{
+    {
+        auto & own = *m_queues[_worker];
+        lock_guard<mutex> const LOCK(own.mutex);
+        if (!own.jobs.empty())
+        {
+            size_t const NEXT = own.jobs.front();
+            own.jobs.pop_front();
+            return NEXT;
+        }
+    }
+
+    size_t const WORKERS = m_queues.size();
+    for (size_t i = 1; i < WORKERS; ++i)
+    {
+        auto & victim = *m_queues[(_worker + i) % WORKERS];
+        lock_guard<mutex> const LOCK(victim.mutex);
+        if (!victim.jobs.empty())
+        {
+            size_t const NEXT = victim.jobs.back();
+            victim.jobs.pop_back();
+            return NEXT;
+        }
+    }
+
+    return nullopt;
+}
+
+// -------------------------------------------------------------------------- //
+
+}
+}
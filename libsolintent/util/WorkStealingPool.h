@@ -0,0 +1,131 @@
+/**
+ * Abduction runs each pattern against each suspect. The cost of a job varies
+ * widely (a loop over a large contract dwarfs a loop over a small one), so a
+ * static split of the jobs leaves threads idle. This module provides a thread
+ * pool in which each thread owns a queue of jobs, and an idle thread steals from
+ * the queues of its peers.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * A work-stealing thread pool.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * A fixed set of workers which run indexed jobs. The calling thread is worker
+ * 0, so a pool of size 1 runs every job inline, without spawning any threads.
+ *
+ * The jobs of a call are split into contiguous blocks, one per worker. Each
+ * worker runs its block from the front, while thieves take from the back. This
+ * way, neighbouring jobs tend to run on the same thread.
+ */
+class WorkStealingPool
+{
+public:
+    /**
+     * A single job. The first argument is the worker running the job, which
+     * allows each worker to hold its own scratch state. The second argument is
+     * the index of the job.
+     */
+    using Job = std::function<void(size_t, size_t)>;
+
+    /**
+     * _workers: the number of workers, including the calling thread. If zero,
+     *           then one worker is used per hardware thread.
+     */
+    explicit WorkStealingPool(size_t _workers = 0);
+
+    ~WorkStealingPool();
+
+    WorkStealingPool(WorkStealingPool const&) = delete;
+    WorkStealingPool & operator=(WorkStealingPool const&) = delete;
+
+    /**
+     * Returns the number of workers, including the calling thread.
+     */
+    size_t size() const;
+
+    /**
+     * Runs _job for each index in [0, _count), and then returns. If any job
+     * throws, then the remaining jobs still run, and the first exception is
+     * rethrown. Calls must not be nested.
+     *
+     * _count: the number of jobs.
+     * _job: the body of each job.
+     */
+    void parallelFor(size_t _count, Job const& _job);
+
+private:
+    /**
+     * The jobs assigned to a single worker.
+     */
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<size_t> jobs;
+    };
+
+    /**
+     * The body of each spawned worker.
+     */
+    void work(size_t _worker);
+
+    /**
+     * Runs jobs as worker _worker until no job remains in any queue.
+     */
+    void drain(size_t _worker);
+
+    /**
+     * Takes the next job of _worker, or steals one from a peer.
+     */
+    std::optional<size_t> take(size_t _worker);
+
+    // The queue of each worker.
+    std::vector<std::unique_ptr<Queue>> m_queues;
+    // The spawned workers. Worker 0 is the calling thread.
+    std::vector<std::thread> m_threads;
+
+    // Guards the following fields.
+    std::mutex m_mutex;
+    // Signalled when a call begins, or the pool is stopped.
+    std::condition_variable m_wake;
+    // Signalled when the last job of a call completes.
+    std::condition_variable m_done;
+    // Counts the calls to parallelFor, so that workers can detect new jobs.
+    size_t m_epoch = 0;
+    // True once the pool is being destroyed.
+    bool m_stopping = false;
+    // The first exception raised by a job of the current call.
+    std::exception_ptr m_error;
+
+    // The body of the current call.
+    Job const* m_job = nullptr;
+    // The number of jobs of the current call which have yet to complete.
+    std::atomic<size_t> m_remaining{0};
+};
+
+// -------------------------------------------------------------------------- //
+
+}
+}
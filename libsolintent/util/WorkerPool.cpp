@@ -0,0 +1,296 @@
+/**
+ * A large audit is a long sequence of independent compilations. Running them in
+ * a single process serializes the corpus, and lets a single pathological input
+ * (e.g., a compiler assertion, or an exhausted stack) abort the entire run. This
+ * module shards the work across forked workers. Results are streamed back over
+ * pipes, and are merged in task order, so that the output does not depend on
+ * scheduling. A worker which dies is replaced, and its shard is resumed.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * A pool of worker processes with a deterministic merge.
+ */
+
+#include <libsolintent/util/WorkerPool.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+#ifndef _WIN32
+    #include <cerrno>
+    #include <poll.h>
+    #include <sys/types.h>
+    #include <sys/wait.h>
+    #include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+WorkerPool::WorkerPool(size_t _workers, size_t _retries)
+    : m_workers(max<size_t>(_workers, 1))
+    , m_retries(_retries)
+{
+}
+
+size_t WorkerPool::restarts() const
+{
+    return m_restarts;
+}
+
+// -------------------------------------------------------------------------- //
+
+#ifdef _WIN32
+
+void WorkerPool::run(size_t _tasks, Task const& _task, Sink const& _sink)
+{
+    for (size_t i = 0; i < _tasks; ++i)
+    {
+        optional<string> result;
+        try
+        {
+            result = _task(i);
+        }
+        catch (exception const&)
+        {
+        }
+        _sink(i, result);
+    }
+}
+
+#else
+
+namespace
+{
+
+// Each frame is the task, the payload length, and then the payload.
+size_t const HEADER_SIZE = 2 * sizeof(uint64_t);
+
+/**
+ * Writes all of _data to _fd. Returns false on failure.
+ */
+bool writeAll(int _fd, char const* _data, size_t _size)
+{
+    while (_size > 0)
+    {
+        ssize_t const WRITTEN = ::write(_fd, _data, _size);
+        if (WRITTEN < 0)
+        {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        _data += WRITTEN;
+        _size -= static_cast<size_t>(WRITTEN);
+    }
+    return true;
+}
+
+/**
+ * The body of a worker process. Never returns.
+ */
+[[noreturn]] void work(
+    int _fd, vector<size_t> const& _shard, WorkerPool::Task const& _task
+)
+{
+    try
+    {
+        for (size_t const TASK : _shard)
+        {
+            string const PAYLOAD = _task(TASK);
+
+            uint64_t header[2] = { TASK, PAYLOAD.size() };
+            bool const OK =
+                writeAll(_fd, reinterpret_cast<char const*>(header), HEADER_SIZE)
+                && writeAll(_fd, PAYLOAD.data(), PAYLOAD.size());
+            if (!OK) _exit(1);
+        }
+    }
+    catch (...)
+    {
+        _exit(1);
+    }
+    _exit(0);
+}
+
+/**
+ * The parent's view of a single worker.
+ */
+struct Worker
+{
+    // The process of the worker.
+    pid_t pid;
+    // The read end of the worker's pipe.
+    int fd;
+    // The tasks assigned to the worker, in order.
+    vector<size_t> shard;
+    // The number of tasks in the shard received so far.
+    size_t received = 0;
+    // Bytes received which do not yet form a full frame.
+    string pending;
+};
+
+}
+
+void WorkerPool::run(size_t _tasks, Task const& _task, Sink const& _sink)
+{
+    // Small shards balance the load, while large shards amortize each fork.
+    size_t const SHARD_SIZE = max<size_t>(1, _tasks / (m_workers * 4));
+
+    deque<vector<size_t>> shards;
+    for (size_t i = 0; i < _tasks; i += SHARD_SIZE)
+    {
+        vector<size_t> shard;
+        for (size_t j = i; j < min(_tasks, i + SHARD_SIZE); ++j)
+        {
+            shard.push_back(j);
+        }
+        shards.push_back(move(shard));
+    }
+
+    // Results are held until every earlier task has been consumed.
+    vector<optional<string>> results(_tasks);
+    vector<bool> finished(_tasks, false);
+    size_t next = 0;
+    auto const complete = [&](size_t _i, optional<string> _result) {
+        results[_i] = move(_result);
+        finished[_i] = true;
+        while (next < _tasks && finished[next])
+        {
+            _sink(next, results[next]);
+            results[next].reset();
+            ++next;
+        }
+    };
+
+    map<size_t, size_t> failures;
+    vector<Worker> workers;
+    while (!shards.empty() || !workers.empty())
+    {
+        while (!shards.empty() && workers.size() < m_workers)
+        {
+            int fds[2];
+            if (pipe(fds) != 0)
+            {
+                throw runtime_error("Unable to create worker pipe.");
+            }
+
+            auto shard = move(shards.front());
+            shards.pop_front();
+
+            pid_t const PID = fork();
+            if (PID < 0)
+            {
+                close(fds[0]);
+                close(fds[1]);
+                throw runtime_error("Unable to fork worker.");
+            }
+            else if (PID == 0)
+            {
+                close(fds[0]);
+                for (auto const& worker : workers) close(worker.fd);
+                work(fds[1], shard, _task);
+            }
+
+            close(fds[1]);
+            workers.push_back({ PID, fds[0], move(shard), 0, {} });
+        }
+
+        vector<pollfd> polls;
+        for (auto const& worker : workers)
+        {
+            polls.push_back({ worker.fd, POLLIN, 0 });
+        }
+        if (poll(polls.data(), polls.size(), -1) < 0)
+        {
+            if (errno == EINTR) continue;
+            throw runtime_error("Unable to poll workers.");
+        }
+
+        // Workers are visited in reverse, so that exited workers may be erased.
+        for (size_t i = workers.size(); i-- > 0;)
+        {
+            if (polls[i].revents == 0) continue;
+
+            auto & worker = workers[i];
+            char chunk[1 << 16];
+            ssize_t const READ = ::read(worker.fd, chunk, sizeof(chunk));
+            if (READ < 0 && errno == EINTR) continue;
+
+            if (READ > 0)
+            {
+                worker.pending.append(chunk, static_cast<size_t>(READ));
+
+                size_t offset = 0;
+                while (worker.pending.size() - offset >= HEADER_SIZE)
+                {
+                    uint64_t header[2];
+                    memcpy(header, worker.pending.data() + offset, HEADER_SIZE);
+
+                    size_t const END = offset + HEADER_SIZE + header[1];
+                    if (worker.pending.size() < END) break;
+
+                    complete(header[0], worker.pending.substr(
+                        offset + HEADER_SIZE, header[1]
+                    ));
+                    ++worker.received;
+                    offset = END;
+                }
+                worker.pending.erase(0, offset);
+                continue;
+            }
+
+            // The pipe is closed, so the worker has exited.
+            close(worker.fd);
+            int status = 0;
+            while (waitpid(worker.pid, &status, 0) < 0 && errno == EINTR);
+
+            bool const CLEAN = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+            if (!CLEAN || worker.received < worker.shard.size())
+            {
+                ++m_restarts;
+
+                auto const BEGIN = worker.shard.begin() + worker.received;
+                if (BEGIN != worker.shard.end())
+                {
+                    size_t const BLAMED = *BEGIN;
+                    if (BEGIN + 1 != worker.shard.end())
+                    {
+                        shards.emplace_front(BEGIN + 1, worker.shard.end());
+                    }
+
+                    if (++failures[BLAMED] > m_retries)
+                    {
+                        complete(BLAMED, nullopt);
+                    }
+                    else
+                    {
+                        shards.push_front({ BLAMED });
+                    }
+                }
+            }
+
+            workers.erase(workers.begin() + i);
+        }
+    }
+}
+
+#endif
+
+// -------------------------------------------------------------------------- //
+
+}
+}
@@ -0,0 +1,90 @@
+/**
+ * A large audit is a long sequence of independent compilations. Running them in
+ * a single process serializes the corpus, and lets a single pathological input
+ * (e.g., a compiler assertion, or an exhausted stack) abort the entire run. This
+ * module shards the work across forked workers. Results are streamed back over
+ * pipes, and are merged in task order, so that the output does not depend on
+ * scheduling. A worker which dies is replaced, and its shard is resumed.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * A pool of worker processes with a deterministic merge.
+ */
+
+#pragma once
+
+#include <functional>
+#include <optional>
+#include <string>
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * Runs a fixed set of tasks, numbered 0 to n - 1, across worker processes. Each
+ * task produces an opaque payload, which is handed to a sink in the parent. The
+ * sink sees every task exactly once, and in order.
+ *
+ * If a worker exits before finishing its shard, then the first unfinished task
+ * is blamed. The blamed task is retried alone, up to the retry limit, and is
+ * then reported as failed. The rest of the shard is rescheduled, so a single
+ * crash never loses the work of its neighbours.
+ *
+ * Note: workers are forked, so any buffered output in the parent must be flushed
+ * before run is called. Otherwise, the buffer is duplicated into each worker.
+ * On platforms without fork, all tasks are run inline.
+ */
+class WorkerPool
+{
+public:
+    /**
+     * Computes the payload of the given task. This is called in a worker.
+     */
+    using Task = std::function<std::string(size_t)>;
+
+    /**
+     * Consumes the payload of the given task, or nullopt if the task failed.
+     * This is called in the parent.
+     */
+    using Sink = std::function<void(size_t, std::optional<std::string> const&)>;
+
+    /**
+     * _workers: the maximum number of concurrent workers.
+     * _retries: the number of times a failing task is retried.
+     */
+    explicit WorkerPool(size_t _workers, size_t _retries = 1);
+
+    /**
+     * Runs each task, and then passes its result to the sink. Returns once all
+     * tasks have been consumed.
+     *
+     * _tasks: the number of tasks.
+     * _task: computes the payload of each task.
+     * _sink: consumes the payload of each task.
+     */
+    void run(size_t _tasks, Task const& _task, Sink const& _sink);
+
+    /**
+     * Returns the number of workers which have been replaced after dying.
+     */
+    size_t restarts() const;
+
+private:
+    // The maximum number of concurrent workers.
+    size_t const m_workers;
+    // The number of times a failing task is retried.
+    size_t const m_retries;
+    // The number of workers replaced so far.
+    size_t m_restarts = 0;
+};
+
+// -------------------------------------------------------------------------- //
+
+}
+}
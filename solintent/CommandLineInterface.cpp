@@ -29,6 +29,8 @@
 
 #include <solintent/patterns/DynamicArraysAsFixedContainers.h>
 
+#include <solintent/report/Reporter.h>
+
 #include <libsolintent/static/AnalysisEngine.h>
 #include <libsolintent/static/BoundChecker.h>
 #include <libsolintent/static/CondChecker.h>
@@ -36,7 +38,14 @@
 #include <libsolintent/static/FunctionChecker.h>
 #include <libsolintent/static/StatementChecker.h>
 #include <libsolintent/static/ImplicitObligation.h>
+#include <libsolintent/util/BoundedQueue.h>
+#include <libsolintent/util/ImportGraph.h>
+#include <libsolintent/util/ImportPaths.h>
+#include <libsolintent/util/ResultsLog.h>
+#include <libsolintent/util/SourceIndex.h>
 #include <libsolintent/util/SourceLocation.h>
+#include <libsolintent/util/WorkerPool.h>
+#include <libsolintent/util/WorkStealingPool.h>
 
 #include <libsolidity/interface/Version.h>
 #include <libsolidity/parsing/Parser.h>
@@ -65,12 +74,17 @@
 	#define isatty _isatty
 	#define fileno _fileno
 #else // unix
+	#include <sys/resource.h>
 	#include <unistd.h>
 #endif
 
+#include <atomic>
 #include <string>
 #include <iostream>
 #include <fstream>
+#include <sstream>
+#include <optional>
+#include <thread>
 
 #if !defined(STDERR_FILENO)
 	#define STDERR_FILENO 2
@@ -87,7 +101,9 @@ namespace solintent
 
 // -------------------------------------------------------------------------- //
 
-bool g_hasOutput = false;
+// Diagnostics are written from each stage of the batch pipeline, so the flag is
+// shared between threads.
+std::atomic<bool> g_hasOutput{false};
 
 std::ostream& sout()
 {
@@ -131,6 +147,14 @@ static string const g_strVersion = "version";
 static string const g_strIgnoreMissingFiles = "ignore-missing";
 static string const g_strColor = "color";
 static string const g_strNoColor = "no-color";
+static string const g_strFormat = "format";
+static string const g_strImportAst = "import-ast";
+static string const g_strPartition = "partition";
+static string const g_strJobs = "jobs";
+static string const g_strBatch = "batch";
+static string const g_strResultsLog = "results-log";
+static string const g_strQueryBounds = "query-bounds";
+static string const g_strThreads = "threads";
 
 static string const g_argErrorRecovery = g_strErrorRecovery;
 static string const g_argHelp = g_strHelp;
@@ -144,6 +168,33 @@ static string const g_stdinFileName = g_stdinFileNameStr;
 static string const g_argIgnoreMissingFiles = g_strIgnoreMissingFiles;
 static string const g_argColor = g_strColor;
 static string const g_argNoColor = g_strNoColor;
+static string const g_argFormat = g_strFormat;
+static string const g_argImportAst = g_strImportAst;
+static string const g_argPartition = g_strPartition;
+static string const g_argJobs = g_strJobs;
+static string const g_argBatch = g_strBatch;
+static string const g_argResultsLog = g_strResultsLog;
+static string const g_argQueryBounds = g_strQueryBounds;
+static string const g_argThreads = g_strThreads;
+
+static Reporter::Rule const g_gasLoopRule{
+	"GasConstraintOnLoopObligation",
+	"All loops must consume a finite amount of gas."
+};
+
+/**
+ * Returns the high-water mark of resident memory, or 0 if it is unavailable.
+ */
+static size_t peakResidentKiB()
+{
+#ifdef _WIN32
+	return 0;
+#else
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+	return static_cast<size_t>(usage.ru_maxrss);
+#endif
+}
 
 static void version()
 {
@@ -214,20 +265,33 @@ bool CommandLineInterface::readInputFilesAndConfigureRemappings()
 					continue;
 				}
 
-				m_sourceCodes[infile.generic_string()] = dev::readFileAsString(
-					infile.string()
-				);
+				// Sources are stored by canonical path, as in the read callback,
+				// so that an input which is also imported is mapped once.
+				auto const& CANONICAL = m_canonicalPaths.canonical(infile);
+				try
+				{
+					m_sourceCodes[infile.generic_string()] = m_sources.load(
+						CANONICAL.string()
+					);
+				}
+				catch (std::exception const& _exception)
+				{
+					serr() << _exception.what() << endl;
+					return false;
+				}
 
-				path = boost::filesystem::canonical(infile).string();
+				path = CANONICAL.string();
 			}
-			m_allowedDirectories.push_back(
+			m_allowedDirectories.insert(
 				boost::filesystem::path(path).remove_filename()
 			);
 		}
 	}
 	if (addStdin)
 	{
-		m_sourceCodes[g_stdinFileName] = dev::readStandardInput();
+		m_sourceCodes[g_stdinFileName] = m_sources.adopt(
+			g_stdinFileName, dev::readStandardInput()
+		);
 	}
 	if (m_sourceCodes.size() == 0)
 	{
@@ -240,6 +304,89 @@ bool CommandLineInterface::readInputFilesAndConfigureRemappings()
 	return true;
 }
 
+bool CommandLineInterface::readBatchRemappings()
+{
+	if (!m_args.count(g_argInputFile)) return true;
+
+	for (string const& arg: m_args[g_argInputFile].as<vector<string>>())
+	{
+		if (find(arg.begin(), arg.end(), '=') == arg.end())
+		{
+			serr() << "Input files cannot be combined with " << g_argBatch
+			       << ": \"" << arg << "\"." << endl;
+			return false;
+		}
+
+		auto remapping = solidity::CompilerStack::parseRemapping(arg);
+		if (!remapping)
+		{
+			serr() << "Invalid remapping: \"" << arg << "\"." << endl;
+			return false;
+		}
+		m_remappings.emplace_back(std::move(*remapping));
+	}
+	return true;
+}
+
+// -------------------------------------------------------------------------- //
+
+bool CommandLineInterface::parseAstFromInput(map<string, Json::Value> & _asts)
+{
+	Json::CharReaderBuilder builder;
+	Json::CharReaderBuilder::strictMode(&builder.settings_);
+	unique_ptr<Json::CharReader> const READER(builder.newCharReader());
+
+	for (auto const& input: m_sourceCodes)
+	{
+		// Parses directly from the stored view, rather than from a copy.
+		Json::Value root;
+		string errors;
+		char const* begin = input.second.data();
+		char const* end = begin + input.second.size();
+		if (!READER->parse(begin, end, &root, &errors))
+		{
+			serr() << "Unable to parse " << input.first << " as JSON: "
+			       << errors << endl;
+			return false;
+		}
+		if (!root.isObject() || !root["sources"].isObject())
+		{
+			serr() << "Expected a \"sources\" object in " << input.first
+			       << "." << endl;
+			return false;
+		}
+
+		// Combined JSON uses "AST", whereas standard JSON uses "ast".
+		Json::Value & sources = root["sources"];
+		for (auto const& name: sources.getMemberNames())
+		{
+			Json::Value & source = sources[name];
+			string const KEY = source.isMember("ast") ? "ast" : "AST";
+			if (source[KEY]["nodeType"].asString() != "SourceUnit")
+			{
+				serr() << "Expected a SourceUnit for " << name << " in "
+				       << input.first << "." << endl;
+				return false;
+			}
+			if (_asts.count(name))
+			{
+				serr() << "Source " << name << " is imported twice." << endl;
+				return false;
+			}
+			_asts.emplace(name, move(source[KEY]));
+		}
+	}
+
+	// The source text is not part of the AST, so only the names are retained.
+	m_sourceCodes.clear();
+	for (auto const& ast: _asts)
+	{
+		m_sourceCodes[ast.first] = string_view();
+	}
+
+	return true;
+}
+
 // -------------------------------------------------------------------------- //
 
 bool CommandLineInterface::parseLibraryOption(string const& _input)
@@ -401,6 +548,56 @@ bool CommandLineInterface::parseArguments(int _argc, char** _argv)
 			"Explicitly disable colored output, disabling terminal "
 			"auto-detection."
 		)
+		(
+			g_argFormat.c_str(),
+			po::value<string>()->value_name("fmt")->default_value("text"),
+			"Set the output format. One of text, jsonl (JSON Lines) or sarif."
+		)
+		(
+			g_argImportAst.c_str(),
+			"Import ASTs to be analyzed, rather than source files. The input "
+			"must be the JSON output of solc, either from --combined-json ast "
+			"or from --standard-json."
+		)
+		(
+			g_argPartition.c_str(),
+			"Compile and analyze each connected component of the import graph "
+			"separately, so that peak memory is bounded by the largest "
+			"component rather than by all inputs."
+		)
+		(
+			g_argJobs.c_str(),
+			po::value<unsigned>()->value_name("n")->default_value(1),
+			"Analyze the connected components of the import graph across n "
+			"worker processes. A worker which crashes is restarted, and the "
+			"output is identical to that of a single process."
+		)
+		(
+			g_argThreads.c_str(),
+			po::value<unsigned>()->value_name("n")->default_value(0),
+			"Set the number of threads used for candidate search. If 0, then "
+			"one thread is used per core, and the cores are divided between "
+			"the workers of --jobs."
+		)
+		(
+			g_argBatch.c_str(),
+			po::value<string>()->value_name("path"),
+			"Analyze a batch of projects, recording each result in the results "
+			"log. The path is either a directory, whose subdirectories are the "
+			"projects, or a manifest listing one project directory per line. "
+			"Projects with unchanged inputs since their last run are skipped."
+		)
+		(
+			g_argResultsLog.c_str(),
+			po::value<string>()->value_name("file")->default_value(
+				"solintent-results.jsonl"
+			),
+			"Set the append-only results log used by batch mode."
+		)
+		(
+			g_argQueryBounds.c_str(),
+			"Print each proposed bound in the results log, by rule, and exit."
+		)
 		(g_argErrorRecovery.c_str(), "Enables additional parser error recovery.")
 		(g_argIgnoreMissingFiles.c_str(), "Ignore missing files.");
 
@@ -453,6 +650,37 @@ bool CommandLineInterface::parseArguments(int _argc, char** _argv)
 
 	po::notify(m_args);
 
+	if (m_args.count(g_argImportAst) && m_args.count(g_argPartition))
+	{
+		serr() << "Option " << g_argImportAst << " and " << g_argPartition
+		       << " are mutualy exclusive." << endl;
+		return false;
+	}
+
+	if (m_args.count(g_argImportAst) && m_args[g_argJobs].as<unsigned>() > 1)
+	{
+		serr() << "Option " << g_argImportAst << " and " << g_argJobs
+		       << " are mutualy exclusive." << endl;
+		return false;
+	}
+
+	bool const SHARDED = m_args.count(g_argPartition)
+	                  || m_args[g_argJobs].as<unsigned>() > 1;
+	if (m_args.count(g_argBatch) && (m_args.count(g_argImportAst) || SHARDED))
+	{
+		serr() << "Option " << g_argBatch << " cannot be combined with "
+		       << g_argImportAst << ", " << g_argPartition << " or "
+		       << g_argJobs << "." << endl;
+		return false;
+	}
+
+	auto const FORMAT = m_args[g_argFormat].as<string>();
+	if (FORMAT != "text" && FORMAT != "jsonl" && FORMAT != "sarif")
+	{
+		serr() << "Unknown output format: \"" << FORMAT << "\"." << endl;
+		return false;
+	}
+
 	return true;
 }
 
@@ -460,7 +688,7 @@ bool CommandLineInterface::parseArguments(int _argc, char** _argv)
 
 bool CommandLineInterface::processInput()
 {
-	solidity::ReadCallback::Callback fileReader = [this](
+	m_fileReader = [this](
 		string const& _kind, string const& _path
 	)
 	{
@@ -475,40 +703,26 @@ bool CommandLineInterface::processInput()
 				));
 			}
 			auto path = boost::filesystem::path(_path);
-			auto canonicalPath = boost::filesystem::weakly_canonical(path);
-			bool isAllowed = false;
-			for (auto const& allowedDir: m_allowedDirectories)
-			{
-				// If dir is a prefix of boostPath, we are fine.
-				size_t const allowedDirDist = std::distance(
-					allowedDir.begin(), allowedDir.end()
-				);
-				size_t const cononicalPathDist = std::distance(
-					canonicalPath.begin(), canonicalPath.end()
-				);
-				bool const isEq = std::equal(
-					allowedDir.begin(), allowedDir.end(), canonicalPath.begin()
-				);
-				if ((allowedDirDist <= allowedDirDist) && isEq)
-				{
-					isAllowed = true;
-					break;
-				}
-			}
+			auto const& canonicalPath = m_canonicalPaths.canonical(path);
+			bool const isAllowed = m_allowedDirectories.containsPrefixOf(
+				canonicalPath
+			);
 			if (!isAllowed)
 				return solidity::ReadCallback::Result{
 					false, "File outside of allowed directories."
 				};
 
-			if (!boost::filesystem::exists(canonicalPath))
+			auto const STATUS = boost::filesystem::status(canonicalPath);
+			if (!boost::filesystem::exists(STATUS))
 				return solidity::ReadCallback::Result{false, "File not found."};
 
-			if (!boost::filesystem::is_regular_file(canonicalPath))
+			if (!boost::filesystem::is_regular_file(STATUS))
 				return solidity::ReadCallback::Result{false, "Not a valid file."};
 
-			auto contents = dev::readFileAsString(canonicalPath.string());
+			// The compiler owns its copy, so the store is the only other one.
+			auto contents = m_sources.load(canonicalPath.string());
 			m_sourceCodes[path.generic_string()] = contents;
-			return solidity::ReadCallback::Result{true, contents};
+			return solidity::ReadCallback::Result{true, string(contents)};
 		}
 		catch (Exception const& _exception)
 		{
@@ -517,6 +731,13 @@ bool CommandLineInterface::processInput()
 				false, CBMSG + boost::diagnostic_information(_exception)
 			};
 		}
+		catch (std::exception const& _exception)
+		{
+			string const CBMSG = "Exception in read callback: ";
+			return solidity::ReadCallback::Result{
+				false, CBMSG + _exception.what()
+			};
+		}
 		catch (...)
 		{
 			string const CBMSG = "Unknown exception in read callback.";
@@ -524,8 +745,6 @@ bool CommandLineInterface::processInput()
 		}
 	};
 
-	if (!readInputFilesAndConfigureRemappings()) return false;
-
 	if (m_args.count(g_argLibraries))
 	{
 		for (string const& library: m_args[g_argLibraries].as<vector<string>>())
@@ -534,7 +753,62 @@ bool CommandLineInterface::processInput()
 		}
 	}
 
-	m_compiler = make_unique<solidity::CompilerStack>(fileReader);
+	// In batch mode, the sources of each project are loaded in turn.
+	if (m_args.count(g_argQueryBounds)) return true;
+	if (m_args.count(g_argBatch)) return readBatchRemappings();
+
+	if (!readInputFilesAndConfigureRemappings()) return false;
+
+	if (m_args.count(g_argImportAst))
+	{
+		if (!parseAstFromInput(m_importedAsts)) return false;
+	}
+
+	if (m_args.count(g_argPartition) || m_args[g_argJobs].as<unsigned>() > 1)
+	{
+		// Compilation is deferred until each component is analyzed. Imports
+		// outside of the inputs are read as the compiler would read them, so
+		// that inputs which share a dependency are compiled together.
+		auto const KIND = solidity::ReadCallback::kindString(
+			solidity::ReadCallback::Kind::ReadFile
+		);
+		ImportGraph graph(
+			m_remappings,
+			[this, &KIND](string const& _name) -> optional<string> {
+				auto const RESULT = m_fileReader(KIND, _name);
+				if (!RESULT.success) return nullopt;
+				return RESULT.responseOrErrorMessage;
+			}
+		);
+
+		// The read callback records each source it reads, so the inputs are
+		// fixed up front.
+		vector<string> inputs;
+		for (auto const& sourceCode: m_sourceCodes)
+		{
+			inputs.push_back(sourceCode.first);
+		}
+		for (auto const& name: inputs)
+		{
+			graph.addSource(name, m_sourceCodes.at(name));
+		}
+		m_components = graph.components();
+		return true;
+	}
+
+	vector<string> names;
+	for (auto const& sourceCode: m_sourceCodes)
+	{
+		names.push_back(sourceCode.first);
+	}
+	return compile(names);
+}
+
+// -------------------------------------------------------------------------- //
+
+bool CommandLineInterface::compile(vector<string> const& _names)
+{
+	m_compiler = make_unique<solidity::CompilerStack>(m_fileReader);
 
 	auto formatter = make_unique<SourceReferenceFormatterHuman>(
 		serr(false), m_coloredOutput
@@ -542,11 +816,40 @@ bool CommandLineInterface::processInput()
 
 	try
 	{
+		if (m_args.count(g_argImportAst))
+		{
+			map<string, Json::Value> asts;
+			for (auto const& name: _names)
+			{
+				asts.emplace(name, move(m_importedAsts[name]));
+			}
+
+			m_compiler->setEVMVersion(m_evmVersion);
+			m_compiler->importASTs(asts);
+
+			// Imported ASTs are not annotated, so they are analyzed once more.
+			bool successful = m_compiler->analyze();
+
+			for (auto const& error: m_compiler->errors())
+			{
+				g_hasOutput = true;
+				formatter->printErrorInformation(*error);
+			}
+
+			return successful;
+		}
+
 		if (m_args.count(g_argInputFile))
 		{
 			m_compiler->setRemappings(m_remappings);
 		}
-		m_compiler->setSources(m_sourceCodes);
+		// This is the only copy of each source, and it is owned by the compiler.
+		map<string, string> sources;
+		for (auto const& name: _names)
+		{
+			sources.emplace(name, string(m_sourceCodes.at(name)));
+		}
+		m_compiler->setSources(sources);
 		if (m_args.count(g_argLibraries))
 		{
 			m_compiler->setLibraries(m_libraries);
@@ -643,6 +946,110 @@ bool CommandLineInterface::processInput()
 // -------------------------------------------------------------------------- //
 
 bool CommandLineInterface::actOnInput()
+{
+	if (m_args.count(g_argQueryBounds)) return queryResults();
+	if (m_args.count(g_argBatch)) return runBatch();
+
+	// Sources are indexed once, and then shared by all reports.
+	SourceIndex index;
+	auto const FORMAT = m_args[g_argFormat].as<string>();
+	auto reporter = makeReporter(FORMAT, sout(), index);
+
+	auto const JOBS = m_args[g_argJobs].as<unsigned>();
+	reporter->begin(g_gasLoopRule);
+	if (JOBS > 1)
+	{
+		// Workers are forked, so pending output must not be duplicated.
+		sout().flush();
+		serr().flush();
+
+		// Each component is analyzed into a fragment, prefixed by its number
+		// of findings. If the component fails to compile, then the prefix is
+		// "error" instead.
+		auto const TASK = [this, &FORMAT](size_t _i) {
+			if (!compile(m_components[_i]))
+			{
+				serr().flush();
+				return string("error\n");
+			}
+
+			SourceIndex localIndex;
+			ostringstream out;
+			auto fragment = makeReporter(FORMAT, out, localIndex);
+			fragment->beginFragment(g_gasLoopRule);
+			analyze(*fragment, localIndex);
+			fragment->end();
+
+			serr().flush();
+			return to_string(fragment->count()) + "\n" + out.str();
+		};
+
+		// Fragments arrive in component order, so the output is deterministic.
+		auto const SINK = [this, &reporter](
+			size_t _i, optional<string> const& _payload
+		) {
+			if (!_payload.has_value())
+			{
+				serr() << "Analysis failed for the component of \""
+				       << m_components[_i].front() << "\"." << endl;
+				m_error = true;
+				return;
+			}
+
+			string_view const PAYLOAD = _payload.value();
+			size_t const SPLIT = PAYLOAD.find('\n');
+			string const HEAD(PAYLOAD.substr(0, SPLIT));
+			if (HEAD == "error")
+			{
+				m_error = true;
+				return;
+			}
+
+			reporter->splice(PAYLOAD.substr(SPLIT + 1), stoul(HEAD));
+			reporter->endContract();
+		};
+
+		WorkerPool pool(JOBS);
+		pool.run(m_components.size(), TASK, SINK);
+
+		serr() << m_components.size() << " components analyzed by " << JOBS
+		       << " workers. Workers restarted: " << pool.restarts() << "."
+		       << endl;
+	}
+	else if (!m_args.count(g_argPartition))
+	{
+		analyze(*reporter, index);
+	}
+	else
+	{
+		size_t largest = 0;
+		for (auto const& component: m_components)
+		{
+			largest = max(largest, component.size());
+			if (compile(component))
+			{
+				analyze(*reporter, index);
+			}
+			else
+			{
+				m_error = true;
+			}
+
+			// Releases the ASTs and sources of this component.
+			index.clear();
+			m_compiler.reset();
+		}
+
+		serr() << m_components.size() << " components analyzed. "
+		       << "Largest component: " << largest << " sources. "
+		       << "Peak memory: " << peakResidentKiB() << " KiB." << endl;
+	}
+	reporter->end();
+
+	return !m_error;
+}
+
+void CommandLineInterface::analyze(Reporter & _reporter, SourceIndex & _index)
 {
 	// Hard-coded analysis engine.
 	AnalysisEngine<
@@ -654,65 +1061,496 @@ bool CommandLineInterface::actOnInput()
 	> engine;
 
 	// Hard-coded obligation.
-	auto gas_loop_template = make_shared<GasConstraintOnLoops>();
-	auto daafc_pattern = make_shared<DynamicArraysAsFixedContainers>();
+	auto gas_loop_template = make_shared<GasConstraintOnLoops const>();
 	ImplicitObligation gas_loop_obligation(
-		"GasConstraintOnLoopObligation",
-		"All loops must consume a finite amount of gas.",
-		gas_loop_template,
-		engine
+		g_gasLoopRule.name, g_gasLoopRule.desc, gas_loop_template, engine
 	);
 
-
 	// Compilation.
 	vector<solidity::SourceUnit const*> asts;
-	for (auto const& sourceCode: m_sourceCodes)
+	for (auto const& sourceName: m_compiler->sourceNames())
 	{
-		solidity::SourceUnit const& ast = m_compiler->ast(sourceCode.first);
+		solidity::SourceUnit const& ast = m_compiler->ast(sourceName);
 		asts.push_back(&ast);
 	}
 
-	// Suspects.
-	gas_loop_obligation.computeSuspects(asts);
-	auto suspects = gas_loop_obligation.findSuspects();
-	if (!suspects.empty())
+	// Constants.
+	for (auto const& failure : engine.foldConstants(asts).failures())
+	{
+		auto const& LOC = failure.decl->location();
+		auto const POS = _index.resolve(LOC);
+		auto & out = serr();
+		out << "Unable to fold constant: [" << LOC.start << ":" << LOC.end << "] "
+		    << POS.line << ":" << POS.column << " ";
+		writeSrcloc(out, LOC);
+		out << "\n  " << failure.reason << "\n";
+	}
+
+	// Threads are started on first use, so that forked workers start their own.
+	if (!m_abductionPool)
 	{
-		sout() << suspects.size() << " suspicious loops detected." << endl;
-		for (auto suspect : suspects)
+		// Forked workers share the machine, so each takes its share of cores.
+		auto threads = m_args[g_argThreads].as<unsigned>();
+		auto const JOBS = m_args[g_argJobs].as<unsigned>();
+		if (threads == 0 && JOBS > 1)
 		{
-			size_t start = suspect.node->location().start;
-			size_t end = suspect.node->location().end;
-			auto const LINE = srclocToStr(suspect.node->location());
-			sout() << "[" << start << ":" << end << "] " << LINE << endl;
+			threads = max(1u, thread::hardware_concurrency() / JOBS);
 		}
+		m_abductionPool = make_unique<WorkStealingPool>(threads);
 	}
 
-	// Solutions
-	sout() << endl << "Beginning candidate search." << endl;
-	for (auto suspect : suspects)
+	// Patterns keep per-query state in their context, so one instance is shared
+	// by all workers.
+	vector<shared_ptr<StatementPattern const>> const PATTERNS{
+		make_shared<DynamicArraysAsFixedContainers const>()
+	};
+	size_t const PATTERN_COUNT = PATTERNS.size();
+
+	// Suspects and solutions are reported as soon as each contract is checked.
+	for (auto const* ast : asts)
 	{
-		// TODO: the obligation should handle this...
-		// TODO: remember contract...
-		auto statement = dynamic_cast<solidity::Statement const*>(suspect.node);
-		auto summary = engine.checkStatement(*statement);
-		auto locality = engine.checkContract(*suspect.contract);
-		auto solution = daafc_pattern->abductExplanation(
-			*summary, *locality
-		);
+		using solidity::ASTNode;
+		using solidity::ContractDefinition;
+		auto contracts = ASTNode::filteredNodes<ContractDefinition>(ast->nodes());
+		for (auto const* contract : contracts)
+		{
+			gas_loop_obligation.computeSuspects(*contract);
+			auto suspects = gas_loop_obligation.findSuspects();
+			if (suspects.empty()) continue;
+
+			// The analyzers memoize without locks, so suspects are summarized
+			// up front. The functions of the locality are summarized on demand,
+			// and these loads are serialized by the contract checker.
+			auto locality = engine.checkContract(*contract);
+			vector<SummaryPointer<StatementSummary>> summaries;
+			for (auto const& suspect : suspects)
+			{
+				// TODO: the obligation should handle this...
+				auto statement = dynamic_cast<solidity::Statement const*>(
+					suspect.node
+				);
+				summaries.push_back(engine.checkStatement(*statement));
+			}
+
+			// Each (suspect, pattern) pair is a job. Results are stored by job,
+			// so that the output does not depend on scheduling.
+			size_t const JOBS = suspects.size() * PATTERN_COUNT;
+			vector<optional<int64_t>> solutions(JOBS);
+			m_abductionPool->parallelFor(JOBS, [&](size_t, size_t _job) {
+				auto const& PATTERN = PATTERNS[_job % PATTERN_COUNT];
+				auto const& SUMMARY = summaries[_job / PATTERN_COUNT];
+				solutions[_job] = PATTERN->abductExplanation(*SUMMARY, *locality);
+			});
+
+			// The first pattern to propose a bound is reported.
+			for (size_t i = 0; i < suspects.size(); ++i)
+			{
+				optional<int64_t> solution;
+				for (size_t j = 0; j < PATTERN_COUNT && !solution; ++j)
+				{
+					solution = solutions[i * PATTERN_COUNT + j];
+				}
+				_reporter.report({ suspects[i], solution });
+			}
+			_reporter.endContract();
+		}
+	}
+}
+
+// -------------------------------------------------------------------------- //
+
+bool CommandLineInterface::listProjects(
+	vector<boost::filesystem::path> & _projects
+)
+{
+	namespace fs = boost::filesystem;
+
+	fs::path const BATCH(m_args[g_argBatch].as<string>());
+	try
+	{
+		if (fs::is_directory(BATCH))
+		{
+			for (auto const& entry: fs::directory_iterator(BATCH))
+			{
+				if (fs::is_directory(entry.status()))
+				{
+					_projects.push_back(entry.path());
+				}
+			}
+		}
+		else if (fs::is_regular_file(BATCH))
+		{
+			// Manifest entries are relative to the manifest.
+			ifstream manifest(BATCH.string());
+			string line;
+			while (getline(manifest, line))
+			{
+				boost::trim(line);
+				if (line.empty() || line[0] == '#') continue;
+				_projects.push_back(fs::absolute(line, BATCH.parent_path()));
+			}
+		}
+		else
+		{
+			serr() << BATCH << " is not a directory or manifest." << endl;
+			return false;
+		}
+	}
+	catch (fs::filesystem_error const& _exception)
+	{
+		serr() << _exception.what() << endl;
+		return false;
+	}
+
+	sort(_projects.begin(), _projects.end());
+	return true;
+}
+
+/**
+ * A project of a batch, as it moves through the pipeline.
+ */
+struct BatchProject
+{
+	// The name of the project.
+	string name;
+	// The canonical directory of the project.
+	boost::filesystem::path root;
+	// The path of each source, as loaded into the source store.
+	vector<string> paths;
+	// Maps each source name to its contents.
+	map<string, string_view> sources;
+	// The digest of the sources, their imports, and the analysis options.
+	string digest;
+	// Set if the sources could not be loaded.
+	string error;
+	// True if the project is unchanged since its last complete run.
+	bool unchanged = false;
+	// True if the project was analyzed to completion.
+	bool complete = false;
+	// The findings of the project, in JSON Lines.
+	string findings;
+};
+
+bool CommandLineInterface::runBatch()
+{
+	namespace fs = boost::filesystem;
+
+	vector<fs::path> projects;
+	if (!listProjects(projects)) return false;
+
+	unique_ptr<ResultsLog> log;
+	try
+	{
+		log = make_unique<ResultsLog>(m_args[g_argResultsLog].as<string>());
+	}
+	catch (std::exception const& _exception)
+	{
+		serr() << _exception.what() << endl;
+		return false;
+	}
+
+	// The log belongs to the writer, so skipping is decided from a snapshot.
+	map<string, string> completed;
+	for (auto const& entry: log->entries())
+	{
+		if (entry.second.complete)
+		{
+			completed[entry.first] = entry.second.digest;
+		}
+	}
+
+	// The batch runs as a pipeline: load, then compile and analyze, and then
+	// record. The compiler resets global type state, so compilation and
+	// analysis must share a thread. Loading and recording overlap with them.
+	// Each queue holds at most QUEUE_DEPTH projects, so a slow stage stalls the
+	// stages before it, rather than letting loaded sources pile up.
+	size_t const QUEUE_DEPTH = 2;
+	BoundedQueue<BatchProject> loaded(QUEUE_DEPTH);
+	BoundedQueue<BatchProject> analyzed(QUEUE_DEPTH);
+
+	string const OPTIONS = analysisOptions();
+	thread loader([&] {
+		for (auto const& project: projects)
+		{
+			BatchProject next;
+			next.name = project.generic_string();
+
+			// Sources outside of the project are part of its inputs, so the
+			// import closure is read as the compiler would read it. These are
+			// copies, since the compiler does not share them with the store.
+			map<string, string> imports;
+			try
+			{
+				next.root = fs::canonical(project);
+
+				fs::recursive_directory_iterator itr(project);
+				for (; itr != fs::recursive_directory_iterator(); ++itr)
+				{
+					if (!fs::is_regular_file(itr->status())) continue;
+					if (itr->path().extension() != ".sol") continue;
+
+					// Stored by canonical path, as in the read callback.
+					next.paths.push_back(fs::canonical(itr->path()).string());
+					next.sources[itr->path().generic_string()] = m_sources.load(
+						next.paths.back()
+					);
+				}
+
+				PathTrie allowed;
+				allowed.insert(next.root);
+				for (auto const& remapping: m_remappings)
+				{
+					allowed.insert(fs::path(remapping.target).remove_filename());
+				}
+
+				auto const& SOURCES = next.sources;
+				ImportGraph graph(
+					m_remappings,
+					[&](string const& _name) -> optional<string> {
+						// Sources of the project are scanned when added.
+						if (SOURCES.count(_name) > 0) return nullopt;
+						try
+						{
+							auto const PATH = fs::canonical(_name);
+							if (!allowed.containsPrefixOf(PATH)) return nullopt;
+							if (!fs::is_regular_file(PATH)) return nullopt;
+							return imports[_name] = readFileAsString(
+								PATH.string()
+							);
+						}
+						catch (fs::filesystem_error const&)
+						{
+							return nullopt;
+						}
+					}
+				);
+				for (auto const& source: SOURCES)
+				{
+					graph.addSource(source.first, source.second);
+				}
+			}
+			catch (std::exception const& _exception)
+			{
+				next.error = _exception.what();
+			}
+
+			// Hashing also faults in each page ahead of the compiler.
+			map<string, string_view> inputs(
+				next.sources.begin(), next.sources.end()
+			);
+			inputs.insert(imports.begin(), imports.end());
+			next.digest = ResultsLog::digest(inputs, OPTIONS);
+			auto const ITR = completed.find(next.name);
+			next.unchanged = next.error.empty()
+			              && ITR != completed.end()
+			              && ITR->second == next.digest;
+
+			if (!loaded.push(move(next))) break;
+		}
+		loaded.close();
+	});
+
+	string logError;
+	thread writer([&] {
+		Json::CharReaderBuilder builder;
+		unique_ptr<Json::CharReader> const READER(builder.newCharReader());
 
-		if (solution.has_value())
+		while (auto next = analyzed.pop())
 		{
-			size_t start = statement->location().start;
-			size_t end = statement->location().end;
-			sout() << "[" << start << ":" << end << "] "
-			       << "Propossed array bound: " << solution.value()
-				   << endl;;
+			if (next->error.empty() && !next->unchanged)
+			{
+				ResultsLog::Entry entry{
+					next->name, next->digest, next->complete, Json::arrayValue
+				};
+
+				istringstream in(next->findings);
+				string line;
+				while (getline(in, line))
+				{
+					Json::Value finding;
+					string errors;
+					char const* const END = line.data() + line.size();
+					if (!READER->parse(line.data(), END, &finding, &errors))
+					{
+						// The finding is dropped, so the run is incomplete. The
+						// message is written at once, as other stages also log.
+						serr() << (
+							next->name + ": unable to record finding: " + errors
+						) << flush;
+						entry.complete = false;
+						continue;
+					}
+					entry.findings.append(finding);
+				}
+
+				try
+				{
+					log->append(move(entry));
+				}
+				catch (std::exception const& _exception)
+				{
+					logError = _exception.what();
+					analyzed.close();
+					break;
+				}
+			}
+
+			for (auto const& path: next->paths) m_sources.release(path);
+		}
+	});
+
+	size_t skipped = 0;
+	try
+	{
+		while (auto next = loaded.pop())
+		{
+			if (!next->error.empty())
+			{
+				serr() << next->name << ": " << next->error << endl;
+				m_error = true;
+			}
+			else if (next->unchanged)
+			{
+				++skipped;
+			}
+			else
+			{
+				analyzeProject(*next);
+			}
+
+			if (!analyzed.push(move(*next))) break;
 		}
 	}
+	catch (...)
+	{
+		loaded.close();
+		analyzed.close();
+		loader.join();
+		writer.join();
+		throw;
+	}
+
+	loaded.close();
+	analyzed.close();
+	loader.join();
+	writer.join();
+
+	if (!logError.empty())
+	{
+		serr() << logError << endl;
+		return false;
+	}
+
+	serr() << projects.size() - skipped << " projects analyzed. " << skipped
+	       << " projects unchanged. Results: "
+	       << m_args[g_argResultsLog].as<string>() << endl;
 
 	return !m_error;
 }
 
+string CommandLineInterface::analysisOptions() const
+{
+	// Each option is written as name=value, in a fixed order.
+	ostringstream out;
+	out << "version=" << dev::solidity::VersionString;
+	out << ";evm-version=" << m_evmVersion.name();
+	out << ";revert-strings=" << static_cast<int>(m_revertStrings);
+	out << ";" << g_strErrorRecovery << "=" << m_args.count(g_argErrorRecovery);
+	out << ";" << g_strOptimize << "=" << m_args.count(g_argOptimize);
+	out << ";" << g_strOptimizeRuns << "="
+	    << m_args[g_argOptimizeRuns].as<unsigned>();
+	out << ";" << g_strNoOptimizeYul << "=" << m_args.count(g_strNoOptimizeYul);
+	for (auto const& remapping: m_remappings)
+	{
+		out << ";remapping=" << remapping.context.size() << ":"
+		    << remapping.context << remapping.prefix.size() << ":"
+		    << remapping.prefix << remapping.target.size() << ":"
+		    << remapping.target;
+	}
+	if (m_args.count(g_argLibraries))
+	{
+		for (auto const& library: m_libraries)
+		{
+			out << ";library=" << library.first << ":" << library.second.hex();
+		}
+	}
+	return out.str();
+}
+
+void CommandLineInterface::analyzeProject(BatchProject & _project)
+{
+	m_sourceCodes = move(_project.sources);
+	m_allowedDirectories = PathTrie();
+	m_allowedDirectories.insert(_project.root);
+	for (auto const& remapping: m_remappings)
+	{
+		// As with input files, the target of a remapping may be read from.
+		m_allowedDirectories.insert(
+			boost::filesystem::path(remapping.target).remove_filename()
+		);
+	}
+
+	vector<string> names;
+	for (auto const& sourceCode: m_sourceCodes)
+	{
+		names.push_back(sourceCode.first);
+	}
+
+	// Findings are taken from the JSON Lines format, so that the log agrees
+	// with --format jsonl.
+	size_t count = 0;
+	if (compile(names))
+	{
+		SourceIndex index;
+		ostringstream out;
+		JsonLinesReporter reporter(out, index);
+		reporter.beginFragment(g_gasLoopRule);
+		analyze(reporter, index);
+		reporter.end();
+
+		_project.findings = out.str();
+		_project.complete = true;
+		count = reporter.count();
+	}
+	else
+	{
+		m_error = true;
+	}
+
+	serr() << _project.name << ": " << count << " suspects"
+	       << (_project.complete ? "." : ", incomplete.") << endl;
+
+	// Views of the sources must not outlive this stage.
+	m_compiler.reset();
+	m_sourceCodes.clear();
+}
+
+bool CommandLineInterface::queryResults()
+{
+	unique_ptr<ResultsLog> log;
+	try
+	{
+		log = make_unique<ResultsLog>(m_args[g_argResultsLog].as<string>());
+	}
+	catch (std::exception const& _exception)
+	{
+		serr() << _exception.what() << endl;
+		return false;
+	}
+
+	for (auto const& rule: log->proposedBounds())
+	{
+		sout() << rule.first << ":" << endl;
+		for (auto const& bound: rule.second)
+		{
+			sout() << "    " << bound.project << " " << bound.source << ":"
+			       << bound.line << ":" << bound.column
+			       << " Proposed array bound: " << bound.bound << endl;
+		}
+	}
+	return true;
+}
+
 // -------------------------------------------------------------------------- //
 
 }
@@ -25,12 +25,18 @@
 #pragma once
 
 #include <libsolidity/interface/CompilerStack.h>
+#include <libsolintent/util/ImportPaths.h>
+#include <libsolintent/util/SourceStore.h>
+#include <libsolintent/util/WorkStealingPool.h>
 #include <liblangutil/EVMVersion.h>
 
+#include <json/json.h>
+
 #include <boost/program_options.hpp>
 #include <boost/filesystem/path.hpp>
 
 #include <memory>
+#include <string_view>
 
 namespace dev
 {
@@ -39,6 +45,9 @@ namespace solintent
 
 // Forward Declaration
 enum class DocumentationType: uint8_t;
+class Reporter;
+class SourceIndex;
+struct BatchProject;
 
 /**
  * Encapsulates state for the command line interface.
@@ -74,6 +83,72 @@ private:
 	 */
 	bool readInputFilesAndConfigureRemappings();
 
+	/**
+	 * Populates m_remappings in batch mode, where the sources of each project
+	 * are found on demand. Every input argument must then be a remapping.
+	 */
+	bool readBatchRemappings();
+
+	/**
+	 * Interprets each input file as the JSON output of solc, and extracts the
+	 * AST of each source. On success, m_sourceCodes is replaced by the names of
+	 * the imported sources.
+	 *
+	 * _asts: populated with the AST of each source, by source name.
+	 */
+	bool parseAstFromInput(std::map<std::string, Json::Value> & _asts);
+
+	/**
+	 * Compiles the given sources with a fresh compiler, replacing m_compiler.
+	 * Errors are printed, and false is returned if analysis cannot proceed.
+	 *
+	 * _names: the sources to compile, as named in m_sourceCodes.
+	 */
+	bool compile(std::vector<std::string> const& _names);
+
+	/**
+	 * Runs the analysis on every source held by m_compiler. All analyzer state
+	 * is released on return.
+	 *
+	 * _reporter: receives each finding.
+	 * _index: used to resolve source locations.
+	 */
+	void analyze(Reporter & _reporter, SourceIndex & _index);
+
+	/**
+	 * Lists the projects of a batch, in order.
+	 *
+	 * _projects: populated with the directory of each project.
+	 */
+	bool listProjects(std::vector<boost::filesystem::path> & _projects);
+
+	/**
+	 * Analyzes each project of a batch, and then records its results in the
+	 * results log. Projects whose inputs are unchanged since their last
+	 * complete run are skipped. Loading, analysis and recording are pipelined
+	 * across threads.
+	 */
+	bool runBatch();
+
+	/**
+	 * The analysis stage of the batch pipeline. The findings of the project are
+	 * recorded in JSON Lines, and its sources are handed to the compiler.
+	 *
+	 * _project: the project to analyze.
+	 */
+	void analyzeProject(BatchProject & _project);
+
+	/**
+	 * Returns a canonical description of the options which affect the findings
+	 * of a project, so that a change to them invalidates earlier results.
+	 */
+	std::string analysisOptions() const;
+
+	/**
+	 * Prints each proposed bound in the results log.
+	 */
+	bool queryResults();
+
 	/**
 	 * Tries to read from the file @a _input or interprets _input literally if
 	 * that fails. It then tries to parse the contents and appends to
@@ -96,16 +171,29 @@ private:
 
 	// Compiler arguments variable map.
 	boost::program_options::variables_map m_args;
-	// Map of input files to source code strings.
-	std::map<std::string, std::string> m_sourceCodes;
+	// Owns the contents of each source file.
+	SourceStore m_sources;
+	// Map of input files to views of their source code, as held by m_sources.
+	std::map<std::string, std::string_view> m_sourceCodes;
 	// List of remappings.
 	std::vector<solidity::CompilerStack::Remapping> m_remappings;
-	// List of allowed directories to read files from.
-	std::vector<boost::filesystem::path> m_allowedDirectories;
+	// Trie of allowed directories to read files from.
+	PathTrie m_allowedDirectories;
+	// Canonical form of each path resolved during this run.
+	CanonicalPathCache m_canonicalPaths;
 	// Map of library names to addresses.
 	std::map<std::string, h160> m_libraries;
+	// Reads imported files on behalf of the compiler.
+	solidity::ReadCallback::Callback m_fileReader;
+	// The ASTs to import, if the input is solc JSON.
+	std::map<std::string, Json::Value> m_importedAsts;
+	// If partitioning or sharding, the weakly connected components of the import
+	// graph.
+	std::vector<std::vector<std::string>> m_components;
 	// Solidity compiler stack.
 	std::unique_ptr<solidity::CompilerStack> m_compiler;
+	// Runs candidate search, once started by analyze.
+	std::unique_ptr<WorkStealingPool> m_abductionPool;
 	// EVM version to use.
 	langutil::EVMVersion m_evmVersion;
 	// How to handle revert strings.
@@ -29,108 +29,65 @@ GasConstraintOnLoops::GasConstraintOnLoops()
 {
 }
 
-// -------------------------------------------------------------------------- //
-
-void GasConstraintOnLoops::acceptIR(ContractSummary const& _ir)
+SyntacticFeatures GasConstraintOnLoops::requiredFeatures() const
 {
+    // Suspects are loops bounded by an array length.
+    using Feature = SyntacticFeatures::Feature;
+    return { Feature::Loop, Feature::Length };
 }
 
-void GasConstraintOnLoops::acceptIR(FunctionSummary const& _ir)
-{
-}
-
-void GasConstraintOnLoops::acceptIR(TreeBlockSummary const& _ir)
-{
-}
+// -------------------------------------------------------------------------- //
 
-void GasConstraintOnLoops::acceptIR(LoopSummary const& _ir)
+void GasConstraintOnLoops::inspect(
+    LoopSummary const& _ir, Context & _ctx
+) const
 {
     if (_ir.deltas().size() != 1) return;
 
-    auto const& condExpr = _ir.terminationCondition();
     auto const& delta = _ir.deltas().front().get();
-
     if (delta.trend() <= 0) return;
-    if (condExpr.free().size() != 2) return;
 
     // TODO: remove cast.
-
-    auto const* cond = dynamic_cast<Comparison const*>(&condExpr);
-    if (!cond) return;
-
-    auto const* lhs = dynamic_cast<NumericVariable const*>(cond->lhs().get());
-    if (!lhs) return;
-
-    auto const* rhs = dynamic_cast<NumericVariable const*>(cond->rhs().get());
-    if (!rhs) return;
-
     auto const* count = dynamic_cast<NumericVariable const*>(&delta);
     if (!count) return;
 
-    Comparison::Condition reqcond;
-    set<ExpressionSummary::Source> tags;
-    if (count->symb() == lhs->symb())
-    {
-        reqcond = Comparison::Condition::LessThan;
-        if (rhs->tags().has_value())
-        {
-            tags = rhs->tags().value();
-        }
-    }
-    else if (count->symb() == rhs->symb())
+    auto const COND = CanonicalCondition::of(_ir.terminationCondition());
+    if (!COND) return;
+
+    // The verdict depends on whether the counter is the bounded variable. This
+    // is decided by declaration, as a counter may shadow a variable of the same
+    // name, whereas the key must remain stable across compilations.
+    auto const PATH = pathOf(*count);
+    bool const COUNTS_LHS = PATH.has_value() && (pathOf(COND->lhs()) == PATH);
+    string const KEY = COND->key() + (COUNTS_LHS ? "@lhs" : "@other");
+
+    auto verdict = m_verdicts.find(KEY);
+    if (!verdict.has_value())
     {
-        reqcond = Comparison::Condition::GreaterThan;
-        if (lhs->tags().has_value())
+        // The counter must be bounded above by the length of an array.
+        bool suspect = false;
+        if (COND->cond() == Comparison::Condition::LessThan && COND->rhs())
         {
-            tags = lhs->tags().value();
+            if (COUNTS_LHS)
+            {
+                auto const TAGS = COND->rhs()->symbolTags();
+                auto const LENGTH = ExpressionSummary::Source::Length;
+                suspect = (TAGS.find(LENGTH) != TAGS.end());
+            }
         }
+
+        verdict = TerminationCache::Verdict{
+            suspect, TerminationCache::boundOf(*COND)
+        };
+        m_verdicts.insert(KEY, *verdict);
     }
 
-    if (reqcond == cond->cond())
+    if (verdict->suspect)
     {
-        if (tags.find(ExpressionSummary::Source::Length) != tags.end())
-        {
-            raiseAlarm();
-        }
+        _ctx.raiseAlarm();
     }
 }
 
-void GasConstraintOnLoops::acceptIR(NumericExprStatement const& _ir)
-{
-}
-
-void GasConstraintOnLoops::acceptIR(BooleanExprStatement const& _ir)
-{
-}
-
-void GasConstraintOnLoops::acceptIR(FreshVarSummary const& _ir)
-{
-}
-
-void GasConstraintOnLoops::acceptIR(NumericConstant const& _ir)
-{
-}
-
-void GasConstraintOnLoops::acceptIR(NumericVariable const& _ir)
-{
-}
-
-void GasConstraintOnLoops::acceptIR(BooleanConstant const& _ir)
-{
-}
-
-void GasConstraintOnLoops::acceptIR(BooleanVariable const& _ir)
-{
-}
-
-void GasConstraintOnLoops::acceptIR(Comparison const& _ir)
-{
-}
-
-void GasConstraintOnLoops::acceptIR(PushCall const& _ir)
-{
-}
-
 // -------------------------------------------------------------------------- //
 
 }
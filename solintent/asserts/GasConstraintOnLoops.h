@@ -14,6 +14,7 @@
 #pragma once
 
 #include <libsolintent/static/ImplicitObligation.h>
+#include <libsolintent/static/TerminationCondition.h>
 
 namespace dev
 {
@@ -26,22 +27,14 @@ public:
     GasConstraintOnLoops();
     ~GasConstraintOnLoops() = default;
 
+    SyntacticFeatures requiredFeatures() const override;
+
 protected:
-    void acceptIR(ContractSummary const& _ir) override;
-    void acceptIR(FunctionSummary const& _ir) override;
-
-    void acceptIR(TreeBlockSummary const& _ir) override;
-    void acceptIR(LoopSummary const& _ir) override;
-    void acceptIR(NumericExprStatement const& _ir) override;
-    void acceptIR(BooleanExprStatement const& _ir) override;
-    void acceptIR(FreshVarSummary const& _ir) override;
-
-    void acceptIR(NumericConstant const& _ir) override;
-    void acceptIR(NumericVariable const& _ir) override;
-    void acceptIR(BooleanConstant const& _ir) override;
-    void acceptIR(BooleanVariable const& _ir) override;
-    void acceptIR(Comparison const& _ir) override;
-    void acceptIR(PushCall const& _ir) override;
+    void inspect(LoopSummary const& _ir, Context & _ctx) const override;
+
+private:
+    // Verdicts by loop shape, shared by every query of this template.
+    mutable TerminationCache m_verdicts;
 };
 
 }
@@ -12,6 +12,9 @@
 #include <solintent/patterns/DynamicArraysAsFixedContainers.h>
 
 #include <libsolintent/ir/StatementSummary.h>
+#include <libsolintent/ir/StructuralSummary.h>
+
+using namespace std;
 
 namespace dev
 {
@@ -20,57 +23,90 @@ namespace solintent
 
 // -------------------------------------------------------------------------- //
 
-void DynamicArraysAsFixedContainers::aggregate()
+unique_ptr<detail::ProgramPattern::State>
+    DynamicArraysAsFixedContainers::makeState() const
 {
-    setSolution(m_count);
-    m_count = 0;
+    return make_unique<Scratch>();
 }
 
 // -------------------------------------------------------------------------- //
 
-void DynamicArraysAsFixedContainers::clearObligation()
+optional<vector<solidity::VariableDeclaration const*>>
+    DynamicArraysAsFixedContainers::relevantState(Context &) const
 {
-    m_obligation = nullptr;
+    // Push sites are found through the write index of the locality, so no
+    // function needs to be searched.
+    return vector<solidity::VariableDeclaration const*>{};
 }
 
 // -------------------------------------------------------------------------- //
 
-void DynamicArraysAsFixedContainers::setObligation(LoopSummary const& _ir)
+void DynamicArraysAsFixedContainers::aggregate(Context & _ctx) const
 {
-    // TODO: preprocessing could be nice
-    m_obligation = (&_ir);
+    _ctx.setSolution(_ctx.state<Scratch>().count);
 }
 
 // -------------------------------------------------------------------------- //
 
-void DynamicArraysAsFixedContainers::abductFrom(NumericExprStatement const& _ir)
+void DynamicArraysAsFixedContainers::clearObligation(Context & _ctx) const
 {
-    // TODO... use the right format... also no casts...
-    auto expr = dynamic_cast<solidity::ExpressionStatement const*>(&_ir.expr());
-    auto func = dynamic_cast<solidity::FunctionCall const*>(&expr->expression());
-    if (!func) return;
-    auto memb1 = dynamic_cast<solidity::MemberAccess const*>(&func->expression());
-    auto var1 = dynamic_cast<solidity::Identifier const*>(&memb1->expression());
-
-    auto stmt = dynamic_cast<solidity::ForStatement const*>(&m_obligation->expr());
+    auto & scratch = _ctx.state<Scratch>();
+    scratch.obligation = nullptr;
+    scratch.array = nullptr;
+}
+
+// -------------------------------------------------------------------------- //
+
+void DynamicArraysAsFixedContainers::setObligation(
+    LoopSummary const& _ir, Context & _ctx
+) const
+{
+    auto & scratch = _ctx.state<Scratch>();
+    scratch.obligation = (&_ir);
+
+    // Resolves the state array whose length bounds the loop.
+    // TODO: no casts...
+    auto stmt = dynamic_cast<solidity::ForStatement const*>(&_ir.expr());
+    if (!stmt) return;
     auto cond = dynamic_cast<solidity::BinaryOperation const*>(stmt->condition());
-    auto lhs = dynamic_cast<solidity::Identifier const*>(&cond->leftExpression());
-    auto rhs = dynamic_cast<solidity::Identifier const*>(&cond->rightExpression());
+    if (!cond) return;
 
-    solidity::MemberAccess const* memb2;
-    if (!lhs)
+    for (auto const* side : { &cond->leftExpression(), &cond->rightExpression() })
     {
-        memb2  = dynamic_cast<solidity::MemberAccess const*>(&cond->leftExpression());
+        auto memb = dynamic_cast<solidity::MemberAccess const*>(side);
+        if (!memb || memb->memberName() != "length") continue;
+
+        auto var = dynamic_cast<solidity::Identifier const*>(&memb->expression());
+        if (!var) continue;
+
+        auto decl = dynamic_cast<solidity::VariableDeclaration const*>(
+            var->annotation().referencedDeclaration
+        );
+        if (decl && decl->isStateVariable())
+        {
+            scratch.array = decl;
+            return;
+        }
     }
-    else
-    {
-        memb2  = dynamic_cast<solidity::MemberAccess const*>(&cond->rightExpression());
-    }
-    auto var2 = dynamic_cast<solidity::Identifier const*>(&memb2->expression());
+}
+
+// -------------------------------------------------------------------------- //
+
+void DynamicArraysAsFixedContainers::abductFrom(
+    ContractSummary const& _ir, Context & _ctx
+) const
+{
+    auto & scratch = _ctx.state<Scratch>();
+    if (!scratch.array) return;
 
-    if (var1->name() == var2->name())
+    // Only pushes to the array itself are counted, not pushes to its elements.
+    for (auto const& site : _ir.writes().sitesOf(*scratch.array))
     {
-        ++m_count;
+        if (site.kind != StateWriteIndex::Kind::Push) continue;
+        if (dynamic_cast<solidity::Identifier const*>(site.target))
+        {
+            ++scratch.count;
+        }
     }
 }
 
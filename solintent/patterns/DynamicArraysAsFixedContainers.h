@@ -25,20 +25,32 @@ class DynamicArraysAsFixedContainers: public StatementPattern
 public:
     ~DynamicArraysAsFixedContainers() = default;
 
-    void aggregate() override;
-
 protected:
-    void clearObligation() override;
+    /**
+     * The per-query scratch space of this pattern.
+     */
+    struct Scratch: State
+    {
+        // Counts the number of push calls.
+        int64_t count = 0;
+        // A reference to the current obligation.
+        LoopSummary const* obligation = nullptr;
+        // The state array whose length bounds the obligation, if resolved.
+        solidity::VariableDeclaration const* array = nullptr;
+    };
+
+    std::unique_ptr<State> makeState() const override;
+
+    std::optional<std::vector<solidity::VariableDeclaration const*>>
+        relevantState(Context & _ctx) const override;
+
+    void aggregate(Context & _ctx) const override;
 
-    void setObligation(LoopSummary const& _ir) override;
+    void clearObligation(Context & _ctx) const override;
 
-    void abductFrom(NumericExprStatement const& _ir) override;
+    void setObligation(LoopSummary const& _ir, Context & _ctx) const override;
 
-private:
-    // Counts the number of push calls.
-    int64_t m_count = 0;
-    // A reference to the current obligation.
-    LoopSummary const* m_obligation;
+    void abductFrom(ContractSummary const& _ir, Context & _ctx) const override;
 };
 
 }
@@ -0,0 +1,367 @@
+/**
+ * Findings are consumed both by people, and by downstream tooling. This module
+ * provides a reporter for each audience. A reporter accumulates its output in
+ * memory, and then writes it out once per contract. This way, results appear as
+ * soon as each contract is inspected, without a system call per line.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Buffered reporters for human-readable and machine-readable output.
+ */
+
+#include <solintent/report/Reporter.h>
+
+#include <libsolintent/util/SourceLocation.h>
+#include <libsolidity/ast/AST.h>
+#include <algorithm>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+namespace
+{
+
+/**
+ * Appends the escaped form of _str to _out, without surrounding quotes.
+ */
+void escapeJson(string & _out, string_view _str)
+{
+    static char const* const HEX = "0123456789abcdef";
+
+    size_t run_start = 0;
+    for (size_t i = 0; i < _str.size(); ++i)
+    {
+        unsigned char const NEXT_CHAR = _str[i];
+        if (NEXT_CHAR >= 0x20 && NEXT_CHAR != '"' && NEXT_CHAR != '\\')
+        {
+            continue;
+        }
+
+        _out.append(_str.data() + run_start, i - run_start);
+        run_start = i + 1;
+        switch (NEXT_CHAR)
+        {
+        case '"': _out.append("\\\""); break;
+        case '\\': _out.append("\\\\"); break;
+        case '\n': _out.append("\\n"); break;
+        case '\r': _out.append("\\r"); break;
+        case '\t': _out.append("\\t"); break;
+        default:
+            _out.append("\\u00");
+            _out.push_back(HEX[NEXT_CHAR >> 4]);
+            _out.push_back(HEX[NEXT_CHAR & 0xf]);
+            break;
+        }
+    }
+    _out.append(_str.data() + run_start, _str.size() - run_start);
+}
+
+/**
+ * Returns the name of the source behind a location, or an empty view if the
+ * location is not annotated.
+ */
+string_view sourceName(langutil::SourceLocation const& _loc)
+{
+    if (!_loc.source) return string_view();
+    return _loc.source->name();
+}
+
+}
+
+// -------------------------------------------------------------------------- //
+
+Reporter::Reporter(ostream & _out, SourceIndex & _index)
+    : m_out(_out)
+    , m_index(_index)
+{
+    m_buffer.reserve(CAPACITY);
+}
+
+void Reporter::begin(Rule const& _rule)
+{
+    // A complete report is a fragment framed by its header and footer.
+    beginFragment(_rule);
+    m_fragment = false;
+    writeHeader();
+}
+
+void Reporter::beginFragment(Rule const& _rule)
+{
+    m_rule = _rule;
+    m_fragment = true;
+}
+
+void Reporter::report(Finding const& _finding)
+{
+    if (m_count > 0) writeSeparator();
+    writeFinding(_finding);
+    ++m_count;
+    spill();
+}
+
+void Reporter::splice(string_view _fragment, size_t _count)
+{
+    if (_fragment.empty()) return;
+    if (m_count > 0) writeSeparator();
+    m_buffer.append(_fragment.data(), _fragment.size());
+    m_count += _count;
+    spill();
+}
+
+void Reporter::endContract()
+{
+    write();
+    m_out.flush();
+}
+
+void Reporter::end()
+{
+    if (!m_fragment) writeFooter();
+    endContract();
+}
+
+size_t Reporter::count() const
+{
+    return m_count;
+}
+
+void Reporter::writeHeader()
+{
+}
+
+void Reporter::writeSeparator()
+{
+}
+
+void Reporter::writeFooter()
+{
+}
+
+Reporter::Rule const& Reporter::rule() const
+{
+    return m_rule;
+}
+
+string & Reporter::buffer()
+{
+    return m_buffer;
+}
+
+void Reporter::spill()
+{
+    if (m_buffer.size() >= CAPACITY) write();
+}
+
+LineIndex::Position Reporter::resolveStart(langutil::SourceLocation const& _loc)
+{
+    return m_index.resolve(_loc);
+}
+
+LineIndex::Position Reporter::resolveEnd(langutil::SourceLocation const& _loc)
+{
+    return m_index.resolveEnd(_loc);
+}
+
+void Reporter::appendJson(string_view _str)
+{
+    m_buffer.push_back('"');
+    escapeJson(m_buffer, _str);
+    m_buffer.push_back('"');
+}
+
+void Reporter::appendJsonSnippet(langutil::SourceLocation const& _loc)
+{
+    // Snippets are collapsed in place. The tail is only copied out and escaped
+    // in the rare case that it contains quotes or control characters.
+    m_buffer.push_back('"');
+    size_t const START = m_buffer.size();
+    appendSrcloc(m_buffer, _loc);
+
+    bool const NEEDS_ESCAPE = any_of(
+        m_buffer.begin() + START, m_buffer.end(), [](unsigned char _c) {
+            return _c < 0x20 || _c == '"' || _c == '\\';
+        }
+    );
+    if (NEEDS_ESCAPE)
+    {
+        string const RAW = m_buffer.substr(START);
+        m_buffer.resize(START);
+        escapeJson(m_buffer, RAW);
+    }
+    m_buffer.push_back('"');
+}
+
+void Reporter::write()
+{
+    if (m_buffer.empty()) return;
+    m_out.write(m_buffer.data(), m_buffer.size());
+    m_buffer.clear();
+}
+
+// -------------------------------------------------------------------------- //
+
+void TextReporter::writeFinding(Finding const& _finding)
+{
+    auto const& LOC = _finding.suspect.node->location();
+    auto const POS = resolveStart(LOC);
+
+    auto & out = buffer();
+    out.append("[").append(to_string(LOC.start));
+    out.append(":").append(to_string(LOC.end)).append("] ");
+    if (POS.line > 0)
+    {
+        out.append(to_string(POS.line)).append(":");
+        out.append(to_string(POS.column)).append(" ");
+    }
+    appendSrcloc(out, LOC);
+    out.append("\n");
+
+    if (_finding.bound.has_value())
+    {
+        out.append("    Proposed array bound: ");
+        out.append(to_string(_finding.bound.value())).append("\n");
+    }
+}
+
+void TextReporter::writeFooter()
+{
+    buffer().append(to_string(count())).append(" suspects detected.\n");
+}
+
+// -------------------------------------------------------------------------- //
+
+void JsonLinesReporter::writeFinding(Finding const& _finding)
+{
+    auto const& LOC = _finding.suspect.node->location();
+    auto const POS = resolveStart(LOC);
+
+    auto & out = buffer();
+    out.append("{\"rule\":");
+    appendJson(rule().name);
+    out.append(",\"contract\":");
+    if (_finding.suspect.contract)
+    {
+        appendJson(_finding.suspect.contract->name());
+    }
+    else
+    {
+        out.append("null");
+    }
+    out.append(",\"source\":");
+    appendJson(sourceName(LOC));
+    out.append(",\"start\":").append(to_string(LOC.start));
+    out.append(",\"end\":").append(to_string(LOC.end));
+    if (POS.line > 0)
+    {
+        out.append(",\"line\":").append(to_string(POS.line));
+        out.append(",\"column\":").append(to_string(POS.column));
+    }
+    out.append(",\"snippet\":");
+    appendJsonSnippet(LOC);
+    out.append(",\"bound\":");
+    if (_finding.bound.has_value())
+    {
+        out.append(to_string(_finding.bound.value()));
+    }
+    else
+    {
+        out.append("null");
+    }
+    out.append("}\n");
+}
+
+// -------------------------------------------------------------------------- //
+
+void SarifReporter::writeHeader()
+{
+    auto & out = buffer();
+    out.append("{\"version\":\"2.1.0\",");
+    out.append("\"$schema\":\"https://json.schemastore.org/sarif-2.1.0.json\",");
+    out.append("\"runs\":[{\"tool\":{\"driver\":{\"name\":\"solintent\",");
+    out.append("\"rules\":[{\"id\":");
+    appendJson(rule().name);
+    out.append(",\"shortDescription\":{\"text\":");
+    appendJson(rule().desc);
+    out.append("}}]}},\"results\":[");
+}
+
+void SarifReporter::writeFinding(Finding const& _finding)
+{
+    auto const& LOC = _finding.suspect.node->location();
+    auto const START = resolveStart(LOC);
+    auto const END = resolveEnd(LOC);
+
+    auto & out = buffer();
+    out.append("{\"ruleId\":");
+    appendJson(rule().name);
+    out.append(",\"level\":\"warning\",\"message\":{\"text\":");
+    if (_finding.bound.has_value())
+    {
+        appendJson("Proposed array bound: " + to_string(_finding.bound.value()));
+    }
+    else
+    {
+        appendJson("No precondition was found.");
+    }
+    out.append("},\"locations\":[{\"physicalLocation\":{");
+    out.append("\"artifactLocation\":{\"uri\":");
+    appendJson(sourceName(LOC));
+    out.append("},\"region\":{");
+    out.append("\"charOffset\":").append(to_string(LOC.start));
+    out.append(",\"charLength\":").append(to_string(LOC.end - LOC.start));
+    if (START.line > 0)
+    {
+        out.append(",\"startLine\":").append(to_string(START.line));
+        out.append(",\"startColumn\":").append(to_string(START.column));
+    }
+    if (START.line > 0 && END.line > 0)
+    {
+        out.append(",\"endLine\":").append(to_string(END.line));
+        out.append(",\"endColumn\":").append(to_string(END.column));
+    }
+    out.append(",\"snippet\":{\"text\":");
+    appendJsonSnippet(LOC);
+    out.append("}}}");
+    if (_finding.suspect.contract)
+    {
+        out.append(",\"logicalLocations\":[{\"kind\":\"type\",\"name\":");
+        appendJson(_finding.suspect.contract->name());
+        out.append("}]");
+    }
+    out.append("}]}");
+}
+
+void SarifReporter::writeSeparator()
+{
+    buffer().append(",");
+}
+
+void SarifReporter::writeFooter()
+{
+    buffer().append("]}]}\n");
+}
+
+// -------------------------------------------------------------------------- //
+
+unique_ptr<Reporter> makeReporter(
+    string const& _format, ostream & _out, SourceIndex & _index
+)
+{
+    if (_format == "text") return make_unique<TextReporter>(_out, _index);
+    if (_format == "jsonl") return make_unique<JsonLinesReporter>(_out, _index);
+    if (_format == "sarif") return make_unique<SarifReporter>(_out, _index);
+    return nullptr;
+}
+
+// -------------------------------------------------------------------------- //
+
+}
+}
@@ -0,0 +1,253 @@
+/**
+ * Findings are consumed both by people, and by downstream tooling. This module
+ * provides a reporter for each audience. A reporter accumulates its output in
+ * memory, and then writes it out once per contract. This way, results appear as
+ * soon as each contract is inspected, without a system call per line.
+ */
+
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Buffered reporters for human-readable and machine-readable output.
+ */
+
+#pragma once
+
+#include <libsolintent/static/ImplicitObligation.h>
+#include <libsolintent/util/SourceIndex.h>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace dev
+{
+namespace solintent
+{
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * The base class for all reporters. Concrete reporters format each finding into
+ * the buffer, and the base class decides when the buffer is written.
+ *
+ * Expected usage:
+ * 1. begin is called once, before any findings.
+ * 2. report is called for each finding of a contract, followed by endContract.
+ * 3. end is called once, after all contracts.
+ *
+ * A reporter may instead produce a fragment, by calling beginFragment in place
+ * of begin. The fragment omits all headers and footers, and may be spliced into
+ * another reporter of the same format. This allows findings to be formatted in
+ * one process, and merged in another.
+ */
+class Reporter
+{
+public:
+    /**
+     * Describes the obligation which raised the findings.
+     */
+    struct Rule
+    {
+        std::string name;
+        std::string desc;
+    };
+
+    /**
+     * A suspect, along with the precondition abducted for it, if any.
+     */
+    struct Finding
+    {
+        ImplicitObligation::Suspect suspect;
+        std::optional<int64_t> bound;
+    };
+
+    /**
+     * _out: the stream to which all output is written.
+     * _index: used to resolve the line and column of each finding.
+     */
+    Reporter(std::ostream & _out, SourceIndex & _index);
+
+    virtual ~Reporter() = default;
+
+    /**
+     * Called before any finding is reported.
+     *
+     * _rule: the obligation behind all findings.
+     */
+    void begin(Rule const& _rule);
+
+    /**
+     * Called in place of begin, if the output is a fragment.
+     *
+     * _rule: the obligation behind all findings.
+     */
+    void beginFragment(Rule const& _rule);
+
+    /**
+     * Formats a single finding. The output may be held until endContract.
+     *
+     * _finding: the finding to report.
+     */
+    void report(Finding const& _finding);
+
+    /**
+     * Appends a fragment produced by a reporter of the same format.
+     *
+     * _fragment: the output of the other reporter.
+     * _count: the number of findings within the fragment.
+     */
+    void splice(std::string_view _fragment, size_t _count);
+
+    /**
+     * Called once all findings of a contract have been reported. All output up
+     * to this point is written and flushed.
+     */
+    void endContract();
+
+    /**
+     * Called after all contracts have been inspected. All remaining output is
+     * written and flushed.
+     */
+    void end();
+
+    /**
+     * Returns the number of findings reported, including those spliced in.
+     */
+    size_t count() const;
+
+protected:
+    /**
+     * Formatting hooks. The header and footer are omitted from fragments. The
+     * separator is written between consecutive findings.
+     */
+    virtual void writeHeader();
+    virtual void writeFinding(Finding const& _finding) = 0;
+    virtual void writeSeparator();
+    virtual void writeFooter();
+
+    /**
+     * Returns the rule given to begin.
+     */
+    Rule const& rule() const;
+
+    /**
+     * Returns the buffer into which output is formatted.
+     */
+    std::string & buffer();
+
+    /**
+     * Resolves the line and column of a location's start and end. If either
+     * cannot be resolved, then its line is 0 and it should be omitted.
+     */
+    LineIndex::Position resolveStart(langutil::SourceLocation const& _loc);
+    LineIndex::Position resolveEnd(langutil::SourceLocation const& _loc);
+
+    /**
+     * Appends _str to the buffer as a quoted JSON string.
+     */
+    void appendJson(std::string_view _str);
+
+    /**
+     * Appends the collapsed source snippet at _loc as a quoted JSON string.
+     */
+    void appendJsonSnippet(langutil::SourceLocation const& _loc);
+
+private:
+    // The buffer is written once it holds at least this many bytes.
+    static constexpr size_t CAPACITY = 1 << 16;
+
+    /**
+     * Writes the buffer if it has grown beyond its capacity. The stream is not
+     * flushed.
+     */
+    void spill();
+
+    /**
+     * Writes the buffer to the output stream, and then clears the buffer.
+     */
+    void write();
+
+    // The destination of all output.
+    std::ostream & m_out;
+    // The index used to resolve locations.
+    SourceIndex & m_index;
+    // Output which has yet to be written.
+    std::string m_buffer;
+    // The obligation behind all findings.
+    Rule m_rule;
+    // True if this reporter produces a fragment.
+    bool m_fragment = false;
+    // The number of findings so far.
+    size_t m_count = 0;
+};
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * Reports findings as human-readable text. Each suspect is given by its source
+ * range, its line and column, and its source text.
+ */
+class TextReporter: public Reporter
+{
+public:
+    using Reporter::Reporter;
+
+protected:
+    void writeFinding(Finding const& _finding) override;
+
+    void writeFooter() override;
+};
+
+/**
+ * Reports findings in JSON Lines. Each finding is a standalone JSON object on
+ * its own line, so that findings may be consumed incrementally.
+ */
+class JsonLinesReporter: public Reporter
+{
+public:
+    using Reporter::Reporter;
+
+protected:
+    void writeFinding(Finding const& _finding) override;
+};
+
+/**
+ * Reports findings as a SARIF 2.1.0 log with a single run. The log is streamed,
+ * so each result is written as soon as its contract has been inspected.
+ */
+class SarifReporter: public Reporter
+{
+public:
+    using Reporter::Reporter;
+
+protected:
+    void writeHeader() override;
+
+    void writeFinding(Finding const& _finding) override;
+
+    void writeSeparator() override;
+
+    void writeFooter() override;
+};
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * Constructs a reporter by format name. The supported formats are "text",
+ * "jsonl" and "sarif". If the format is unknown, then nullptr is returned.
+ *
+ * _format: the name of the format.
+ * _out: the stream to which all output is written.
+ * _index: used to resolve the line and column of each finding.
+ */
+std::unique_ptr<Reporter> makeReporter(
+    std::string const& _format, std::ostream & _out, SourceIndex & _index
+);
+
+// -------------------------------------------------------------------------- //
+
+}
+}
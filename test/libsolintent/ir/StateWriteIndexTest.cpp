@@ -0,0 +1,162 @@
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Tests for libsolintent/ir/StateWriteIndex.cpp.
+ */
+
+#include <libsolintent/ir/StateWriteIndex.h>
+
+#include <libsolidity/ast/AST.h>
+#include <test/CompilerFramework.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+namespace test
+{
+
+BOOST_FIXTURE_TEST_SUITE(StateWriteIndexTest, CompilerFramework);
+
+using Kind = StateWriteIndex::Kind;
+
+// -------------------------------------------------------------------------- //
+
+BOOST_AUTO_TEST_CASE(kinds)
+{
+    char const* sourceCode = R"(
+        contract A {
+            uint[] a;
+            uint n;
+            function f() public {
+                a.push(1);
+                a.pop();
+                a[0] = 2;
+                a.length--;
+                a.length = 3;
+                delete a;
+                n += 1;
+                n++;
+            }
+            function g() public view returns (uint) { return a.length + n; }
+        }
+    )";
+
+    parse(sourceCode);
+    auto const* CONTRACT = fetch("A");
+    auto const VARS = CONTRACT->stateVariables();
+    BOOST_REQUIRE_EQUAL(VARS.size(), 2);
+
+    StateWriteIndex const INDEX(*CONTRACT);
+
+    auto const& A_SITES = INDEX.sitesOf(*VARS[0]);
+    BOOST_REQUIRE_EQUAL(A_SITES.size(), 6);
+    BOOST_CHECK(A_SITES[0].kind == Kind::Push);
+    BOOST_CHECK(A_SITES[1].kind == Kind::Pop);
+    BOOST_CHECK(A_SITES[2].kind == Kind::Assign);
+    BOOST_CHECK(A_SITES[3].kind == Kind::Length);
+    BOOST_CHECK(A_SITES[4].kind == Kind::Length);
+    BOOST_CHECK(A_SITES[5].kind == Kind::Delete);
+
+    // The target of a push is the array, while an assignment targets an element.
+    BOOST_CHECK(dynamic_cast<solidity::Identifier const*>(A_SITES[0].target));
+    BOOST_CHECK(dynamic_cast<solidity::IndexAccess const*>(A_SITES[2].target));
+
+    auto const& N_SITES = INDEX.sitesOf(*VARS[1]);
+    BOOST_REQUIRE_EQUAL(N_SITES.size(), 2);
+    BOOST_CHECK(N_SITES[0].kind == Kind::Assign);
+    BOOST_CHECK(N_SITES[1].kind == Kind::Increment);
+
+    // Reads are not writes.
+    BOOST_CHECK((INDEX.writersOf(*VARS[0]) == vector<size_t>{ 0 }));
+    BOOST_CHECK((INDEX.writersOf(*VARS[1]) == vector<size_t>{ 0 }));
+}
+
+BOOST_AUTO_TEST_CASE(nesting)
+{
+    char const* sourceCode = R"(
+        contract A {
+            uint[] a;
+            uint[] b;
+            function f() public { a.push(1); }
+            function g() public {
+                for (uint i = 0; i < 10; ++i) {
+                    while (true) { a.push(i); }
+                    a.push(i);
+                }
+            }
+            function h() public { uint[] memory c; c[0] = 1; }
+        }
+    )";
+
+    parse(sourceCode);
+    auto const* CONTRACT = fetch("A");
+    auto const VARS = CONTRACT->stateVariables();
+    BOOST_REQUIRE_EQUAL(VARS.size(), 2);
+
+    StateWriteIndex const INDEX(*CONTRACT);
+
+    auto const& SITES = INDEX.sitesOf(*VARS[0]);
+    BOOST_REQUIRE_EQUAL(SITES.size(), 3);
+    BOOST_CHECK_EQUAL(SITES[0].function, 0);
+    BOOST_CHECK_EQUAL(SITES[0].loops.size(), 0);
+    BOOST_CHECK_EQUAL(SITES[1].function, 1);
+    BOOST_CHECK_EQUAL(SITES[1].loops.size(), 2);
+    BOOST_CHECK_EQUAL(SITES[2].function, 1);
+    BOOST_CHECK_EQUAL(SITES[2].loops.size(), 1);
+    BOOST_CHECK_EQUAL(SITES[1].loops[0], SITES[2].loops[0]);
+
+    // Each writer is listed once, and local variables are not indexed.
+    BOOST_CHECK((INDEX.writersOf(*VARS[0]) == vector<size_t>{ 0, 1 }));
+    BOOST_CHECK(INDEX.sitesOf(*VARS[1]).empty());
+    BOOST_CHECK(INDEX.writersOf(*VARS[1]).empty());
+}
+
+BOOST_AUTO_TEST_CASE(modifiers)
+{
+    char const* sourceCode = R"(
+        contract A {
+            uint[] a;
+            modifier grows() {
+                for (uint i = 0; i < 2; ++i) { a.push(i); }
+                _;
+            }
+            function f() public grows { }
+            function g() public view returns (uint) { return a.length; }
+            function h() public grows { a.pop(); }
+        }
+    )";
+
+    parse(sourceCode);
+    auto const* CONTRACT = fetch("A");
+    auto const VARS = CONTRACT->stateVariables();
+    BOOST_REQUIRE_EQUAL(VARS.size(), 1);
+
+    StateWriteIndex const INDEX(*CONTRACT);
+
+    // The push is indexed once under each function which invokes the modifier,
+    // after the writes of the function body.
+    auto const& SITES = INDEX.sitesOf(*VARS[0]);
+    BOOST_REQUIRE_EQUAL(SITES.size(), 3);
+    BOOST_CHECK(SITES[0].kind == Kind::Push);
+    BOOST_CHECK_EQUAL(SITES[0].function, 0);
+    BOOST_CHECK_EQUAL(SITES[0].loops.size(), 1);
+    BOOST_CHECK(SITES[1].kind == Kind::Pop);
+    BOOST_CHECK_EQUAL(SITES[1].function, 2);
+    BOOST_CHECK(SITES[2].kind == Kind::Push);
+    BOOST_CHECK_EQUAL(SITES[2].function, 2);
+    BOOST_CHECK_EQUAL(SITES[0].expr, SITES[2].expr);
+
+    BOOST_CHECK((INDEX.writersOf(*VARS[0]) == vector<size_t>{ 0, 2 }));
+}
+
+// -------------------------------------------------------------------------- //
+
+BOOST_AUTO_TEST_SUITE_END();
+
+}
+}
+}
@@ -0,0 +1,194 @@
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Tests for libsolintent/ir/StructuralSummary.h.
+ */
+
+#include <libsolintent/ir/StructuralSummary.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolintent/ir/StatementSummary.h>
+#include <test/CompilerFramework.h>
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+namespace test
+{
+
+namespace
+{
+
+/**
+ * Returns a loader which summarizes each function as an empty block, and counts
+ * the number of functions it has summarized.
+ */
+ContractSummary::FunctionLoader countingLoader(atomic<size_t> & _loads)
+{
+    return [&_loads](solidity::FunctionDefinition const& _func) {
+        ++_loads;
+        auto body = make_shared<TreeBlockSummary>(
+            _func.body(), vector<SummaryPointer<StatementSummary>>{}
+        );
+        return make_shared<FunctionSummary>(
+            _func, move(body), vector<SummaryPointer<ModifierSummary const>>{}
+        );
+    };
+}
+
+}
+
+BOOST_FIXTURE_TEST_SUITE(StructuralSummaries, CompilerFramework);
+
+// -------------------------------------------------------------------------- //
+
+BOOST_AUTO_TEST_CASE(lazy_functions)
+{
+    char const* sourceCode = R"(
+        contract A {
+            function f() public pure { }
+            function g() public pure { }
+            function h() public pure { }
+        }
+    )";
+
+    parse(sourceCode);
+    auto const* CONTRACT = fetch("A");
+
+    atomic<size_t> loads(0);
+    ContractSummary summary(*CONTRACT, countingLoader(loads));
+    BOOST_CHECK_EQUAL(summary.summaryLength(), 3);
+    BOOST_CHECK_EQUAL(loads.load(), 0);
+
+    // Each function is loaded once, on first access.
+    auto const& G = summary.get(1);
+    BOOST_CHECK_EQUAL(G.id(), CONTRACT->definedFunctions()[1]->id());
+    BOOST_CHECK_EQUAL(loads.load(), 1);
+    BOOST_CHECK_EQUAL(&summary.get(1), &G);
+    BOOST_CHECK_EQUAL(loads.load(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_access)
+{
+    char const* sourceCode = R"(
+        contract A {
+            function f() public pure { }
+            function g() public pure { }
+        }
+    )";
+
+    parse(sourceCode);
+    auto const* CONTRACT = fetch("A");
+
+    atomic<size_t> loads(0);
+    ContractSummary summary(*CONTRACT, countingLoader(loads));
+
+    vector<thread> readers;
+    for (size_t i = 0; i < 8; ++i)
+    {
+        readers.emplace_back([&summary, i] { summary.get(i % 2); });
+    }
+    for (auto & reader : readers) reader.join();
+
+    BOOST_CHECK_EQUAL(loads.load(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(writers)
+{
+    char const* sourceCode = R"(
+        contract A {
+            struct S { uint[] arr; }
+            uint[] a;
+            uint[] b;
+            S s;
+            uint n;
+            function pushes() public { a.push(1); }
+            function pops() public { b.pop(); }
+            function assigns() public { a[0] = 1; }
+            function deletes() public { delete b; }
+            function nested() public { s.arr.push(n); }
+            function counts() public { n++; }
+            function reads() public view returns (uint) { return a.length; }
+            function locals() public pure { uint[] memory c; c[0] = 1; }
+        }
+    )";
+
+    parse(sourceCode);
+    auto const* CONTRACT = fetch("A");
+    auto const VARS = CONTRACT->stateVariables();
+    BOOST_REQUIRE_EQUAL(VARS.size(), 4);
+
+    atomic<size_t> loads(0);
+    ContractSummary summary(*CONTRACT, countingLoader(loads));
+
+    BOOST_CHECK((summary.writersOf(*VARS[0]) == vector<size_t>{ 0, 2 }));
+    BOOST_CHECK((summary.writersOf(*VARS[1]) == vector<size_t>{ 1, 3 }));
+    BOOST_CHECK((summary.writersOf(*VARS[2]) == vector<size_t>{ 4 }));
+    BOOST_CHECK((summary.writersOf(*VARS[3]) == vector<size_t>{ 5 }));
+
+    // Writers are found without summarizing any function.
+    BOOST_CHECK_EQUAL(loads.load(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(inherited_locality)
+{
+    char const* sourceCode = R"(
+        contract A {
+            uint[] a;
+            constructor() public { }
+            function f() public { a.push(1); }
+            function g(uint x) public pure returns (uint) { return x; }
+            function h() public pure virtual { }
+            fallback() external { }
+        }
+        contract B is A {
+            constructor() public { }
+            function h() public pure override { }
+            function g(bool x) public pure returns (bool) { return x; }
+        }
+    )";
+
+    parse(sourceCode);
+    auto const* BASE = fetch("A");
+    auto const* DERIVED = fetch("B");
+    auto const BASE_FUNCS = BASE->definedFunctions();
+    auto const DERIVED_FUNCS = DERIVED->definedFunctions();
+
+    // Defined functions come first, followed by those which are inherited. The
+    // overloaded g is inherited, whereas the overridden h is not. Constructors
+    // and the fallback function are unnamed, but never collide.
+    auto const LOCALITY = ContractSummary::localityOf(*DERIVED);
+    BOOST_REQUIRE_EQUAL(LOCALITY.size(), 7);
+    BOOST_CHECK_EQUAL(LOCALITY[0], DERIVED_FUNCS[0]);
+    BOOST_CHECK_EQUAL(LOCALITY[1], DERIVED_FUNCS[1]);
+    BOOST_CHECK_EQUAL(LOCALITY[2], DERIVED_FUNCS[2]);
+    BOOST_CHECK_EQUAL(LOCALITY[3], BASE_FUNCS[0]);
+    BOOST_CHECK_EQUAL(LOCALITY[4], BASE_FUNCS[1]);
+    BOOST_CHECK_EQUAL(LOCALITY[5], BASE_FUNCS[2]);
+    BOOST_CHECK_EQUAL(LOCALITY[6], BASE_FUNCS[4]);
+
+    // Writers are indexed against the locality.
+    atomic<size_t> loads(0);
+    ContractSummary summary(*DERIVED, countingLoader(loads));
+    BOOST_CHECK_EQUAL(summary.summaryLength(), 7);
+    auto const VARS = BASE->stateVariables();
+    BOOST_REQUIRE_EQUAL(VARS.size(), 1);
+    BOOST_CHECK((summary.writersOf(*VARS[0]) == vector<size_t>{ 4 }));
+    BOOST_CHECK_EQUAL(summary.get(4).id(), BASE_FUNCS[1]->id());
+    BOOST_CHECK_EQUAL(loads.load(), 1);
+}
+
+// -------------------------------------------------------------------------- //
+
+BOOST_AUTO_TEST_SUITE_END();
+
+}
+}
+}
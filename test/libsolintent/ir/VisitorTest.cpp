@@ -62,6 +62,21 @@ public:
         los = true;
     }
 
+    void acceptIR(BranchSummary const&) override
+    {
+        brs = true;
+    }
+
+    void acceptIR(JumpSummary const&) override
+    {
+        jms = true;
+    }
+
+    void acceptIR(PlaceholderSummary const&) override
+    {
+        phs = true;
+    }
+
     void acceptIR(BooleanExprStatement const&) override
     {
         bes = true;
@@ -84,6 +99,9 @@ public:
 
     bool tbs{false};
     bool los{false};
+    bool brs{false};
+    bool jms{false};
+    bool phs{false};
     bool bes{false};
     bool nes{false};
     bool fvs{false};
@@ -139,11 +157,14 @@ BOOST_AUTO_TEST_CASE(visit)
     NumericVariable nv(*id);
     auto bc = make_shared<BooleanConstant>(*id, false);
     auto bv = make_shared<BooleanVariable>(*id);
-    Comparison cp(*id, Comparison::Condition::LessThan, nc, nc);
+    Comparison cp(*id, Comparison::Condition::LessThan, true, nc, nc);
     auto tbs = make_shared<TreeBlockSummary>(
         *block, std::vector<SummaryPointer<StatementSummary>>{}
     );
-    LoopSummary los(forloop, bv, tbs, {});
+    LoopSummary los(forloop, bv, tbs, nullptr, nullptr, {}, TripCount());
+    BranchSummary brs(forloop, bv, tbs, nullptr);
+    JumpSummary jms(forloop, JumpSummary::Kind::Break);
+    PlaceholderSummary phs(forloop);
     NumericExprStatement nes(*exprstmt, nc);
     BooleanExprStatement bes(*exprstmt, bc);
     FreshVarSummary fvs(forloop);
@@ -166,6 +187,12 @@ BOOST_AUTO_TEST_CASE(visit)
     BOOST_CHECK(v.tbs);
     los.acceptIR(v);
     BOOST_CHECK(v.los);
+    brs.acceptIR(v);
+    BOOST_CHECK(v.brs);
+    jms.acceptIR(v);
+    BOOST_CHECK(v.jms);
+    phs.acceptIR(v);
+    BOOST_CHECK(v.phs);
     fvs.acceptIR(v);
     BOOST_CHECK(v.fvs);
 }
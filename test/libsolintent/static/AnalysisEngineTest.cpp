@@ -7,6 +7,8 @@
 #include <libsolintent/static/AnalysisEngine.h>
 
 #include <test/CompilerFramework.h>
+#include <libsolintent/static/ContractChecker.h>
+#include <libsolintent/static/FunctionChecker.h>
 #include <libsolintent/static/StatementChecker.h>
 #include <libsolintent/static/BoundChecker.h>
 #include <libsolintent/static/CondChecker.h>
@@ -64,6 +66,41 @@ BOOST_AUTO_TEST_CASE(literals)
     BOOST_CHECK_NE(full, nullptr);
 }
 
+BOOST_AUTO_TEST_CASE(shared_base_summaries)
+{
+    char const* sourceCode = R"(
+        contract A {
+            function f() public pure { }
+        }
+        contract B is A {
+            function g() public pure { }
+        }
+        contract C is A {
+            function h() public pure { }
+        }
+    )";
+
+    AnalysisEngine<
+        ContractChecker,
+        FunctionChecker,
+        StatementChecker,
+        BoundChecker,
+        CondChecker
+    > engine;
+
+    parse(sourceCode);
+    auto const B = engine.checkContract(*fetch("B"));
+    auto const C = engine.checkContract(*fetch("C"));
+    BOOST_REQUIRE_EQUAL(B->summaryLength(), 2);
+    BOOST_REQUIRE_EQUAL(C->summaryLength(), 2);
+
+    // The inherited function is summarized once, for both derived contracts.
+    auto const* F = fetch("A")->definedFunctions()[0];
+    BOOST_CHECK_EQUAL(B->get(1).id(), F->id());
+    BOOST_CHECK_EQUAL(&B->get(1), &C->get(1));
+    BOOST_CHECK_NE(&B->get(0), &C->get(0));
+}
+
 BOOST_AUTO_TEST_SUITE_END();
 
 }
@@ -287,6 +287,146 @@ BOOST_AUTO_TEST_CASE(var_incr)
     }
 }
 
+BOOST_AUTO_TEST_CASE(const_folding)
+{
+    char const* sourceCode = R"(
+        contract A {
+            uint constant a = 10 ** 18;
+            uint constant b = a * 3 - 7;
+            function f() public view {
+                b;
+                -5;
+                7 / 2;
+                b / 2;
+            }
+        }
+    )";
+
+    auto const* AST = parse(sourceCode);
+    
+    auto const* CONTRACT = fetch("A");
+    BOOST_CHECK(!CONTRACT->definedFunctions().empty());
+
+    auto const* FUNC = CONTRACT->definedFunctions()[0];
+    BOOST_CHECK_EQUAL(FUNC->body().statements().size(), 4);
+
+    vector<solidity::rational> const EXPECTED = {
+        solidity::rational(bigint("2999999999999999993")),
+        solidity::rational(-5),
+        solidity::rational(7, 2),
+        solidity::rational(bigint("1499999999999999996"))
+    };
+
+    BoundChecker c;
+    for (size_t i = 0; i < EXPECTED.size(); ++i)
+    {
+        auto const* EXPR = (FUNC->body().statements()[i]).get();
+        auto stmt = dynamic_cast<solidity::ExpressionStatement const*>(EXPR);
+        auto res = c.check(stmt->expression());
+
+        BOOST_CHECK(!res->tags().has_value());
+        BOOST_CHECK(res->exact().has_value());
+        if (res->exact().has_value())
+        {
+            BOOST_CHECK_EQUAL(*res->exact(), EXPECTED[i]);
+        }
+
+        // Only the fractional literal requires a rational.
+        BOOST_CHECK_EQUAL(res->exactInt().has_value(), i != 2);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(typed_wrapping)
+{
+    char const* sourceCode = R"(
+        contract A {
+            uint8 constant a = 250;
+            uint constant b = 0;
+            int8 constant c = 127;
+            function f() public view {
+                a + 10;
+                b - 1;
+                c + 1;
+                a - 5;
+            }
+        }
+    )";
+
+    auto const* AST = parse(sourceCode);
+    
+    auto const* CONTRACT = fetch("A");
+    BOOST_CHECK(!CONTRACT->definedFunctions().empty());
+
+    auto const* FUNC = CONTRACT->definedFunctions()[0];
+    BOOST_CHECK_EQUAL(FUNC->body().statements().size(), 4);
+
+    // Typed arithmetic wraps within the width of its type.
+    vector<solidity::rational> const EXPECTED = {
+        solidity::rational(4),
+        solidity::rational((bigint(1) << 256) - 1),
+        solidity::rational(-128),
+        solidity::rational(245)
+    };
+
+    BoundChecker c;
+    for (size_t i = 0; i < EXPECTED.size(); ++i)
+    {
+        auto const* EXPR = (FUNC->body().statements()[i]).get();
+        auto stmt = dynamic_cast<solidity::ExpressionStatement const*>(EXPR);
+        auto res = c.check(stmt->expression());
+
+        BOOST_CHECK(res->exact().has_value());
+        if (res->exact().has_value())
+        {
+            BOOST_CHECK_EQUAL(*res->exact(), EXPECTED[i]);
+        }
+        BOOST_CHECK(res->exactInt().has_value());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(wide_folding)
+{
+    char const* sourceCode = R"(
+        contract A {
+            uint constant MAX = 2**256 - 1;
+            function f() public view {
+                MAX;
+                2**300 % 7;
+                -(2**255);
+            }
+        }
+    )";
+
+    auto const* AST = parse(sourceCode);
+    
+    auto const* CONTRACT = fetch("A");
+    BOOST_CHECK(!CONTRACT->definedFunctions().empty());
+
+    auto const* FUNC = CONTRACT->definedFunctions()[0];
+    BOOST_CHECK_EQUAL(FUNC->body().statements().size(), 3);
+
+    // Powers past the range of FixedInt fold over the rationals.
+    vector<solidity::rational> const EXPECTED = {
+        solidity::rational((bigint(1) << 256) - 1),
+        solidity::rational(1),
+        solidity::rational(-(bigint(1) << 255))
+    };
+
+    BoundChecker c;
+    for (size_t i = 0; i < EXPECTED.size(); ++i)
+    {
+        auto const* EXPR = (FUNC->body().statements()[i]).get();
+        auto stmt = dynamic_cast<solidity::ExpressionStatement const*>(EXPR);
+        auto res = c.check(stmt->expression());
+
+        BOOST_CHECK(res->exact().has_value());
+        if (res->exact().has_value())
+        {
+            BOOST_CHECK_EQUAL(*res->exact(), EXPECTED[i]);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END();
 
 }
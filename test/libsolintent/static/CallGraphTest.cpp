@@ -0,0 +1,198 @@
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Tests for libsolintent/static/CallGraph.cpp.
+ */
+
+#include <libsolintent/static/CallGraph.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolintent/ir/StructuralSummary.h>
+#include <libsolintent/static/CallSummaries.h>
+#include <libsolintent/util/WorkStealingPool.h>
+#include <test/CompilerFramework.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+namespace test
+{
+
+BOOST_FIXTURE_TEST_SUITE(CallGraphTest, CompilerFramework);
+
+// -------------------------------------------------------------------------- //
+
+char const* const CALLS = R"(
+    library L {
+        function inc(uint x) internal pure returns (uint) { return x + 1; }
+    }
+    contract A {
+        uint[] a;
+        uint n;
+        modifier guarded() { require(n > 0); _; }
+        function f() public { g(); }
+        function g() internal { if (n > 0) { n--; h(); } }
+        function h() internal { g(); }
+        function k() public guarded {
+            for (uint i = 0; i < 3; i++) { a.push(L.inc(i)); }
+        }
+        function p() public { msg.sender.transfer(1); }
+    }
+)";
+
+BOOST_AUTO_TEST_CASE(components)
+{
+    parse(CALLS);
+    CallGraph const GRAPH(*fetch("A"));
+
+    // The five functions and the modifier of A, and then the library call.
+    auto const& NODES = GRAPH.nodes();
+    BOOST_REQUIRE_EQUAL(NODES.size(), 7);
+    BOOST_CHECK_EQUAL(NODES[0]->name(), "f");
+    BOOST_CHECK_EQUAL(NODES[5]->name(), "guarded");
+    BOOST_CHECK_EQUAL(NODES[6]->name(), "inc");
+    BOOST_CHECK(GRAPH.indexOf(*NODES[6]) == 6);
+
+    BOOST_CHECK_EQUAL(GRAPH.callees(0).size(), 1);
+    BOOST_CHECK_EQUAL(GRAPH.callees(3).size(), 2);
+    BOOST_CHECK(GRAPH.callees(4).empty());
+
+    // Only g and h call each other.
+    BOOST_CHECK_EQUAL(GRAPH.components().size(), 6);
+    BOOST_CHECK_EQUAL(GRAPH.componentOf(1), GRAPH.componentOf(2));
+    BOOST_CHECK(GRAPH.recursive(1));
+    BOOST_CHECK(GRAPH.recursive(2));
+    BOOST_CHECK(!GRAPH.recursive(0));
+    BOOST_CHECK(!GRAPH.recursive(3));
+
+    // Each component follows its callees.
+    for (size_t i = 0; i < NODES.size(); ++i)
+    {
+        for (auto const CALLEE : GRAPH.callees(i))
+        {
+            BOOST_CHECK_LE(GRAPH.componentOf(CALLEE), GRAPH.componentOf(i));
+        }
+    }
+
+    // Only f and k call into other components.
+    auto const& WAVES = GRAPH.waves();
+    BOOST_REQUIRE_EQUAL(WAVES.size(), 2);
+    BOOST_CHECK_EQUAL(WAVES[0].size(), 4);
+    BOOST_CHECK_EQUAL(WAVES[1].size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(bottom_up_effects)
+{
+    parse(CALLS);
+    CallGraph const GRAPH(*fetch("A"));
+    WorkStealingPool pool(2);
+    CallSummaries const SUMMARIES(GRAPH, pool);
+
+    // f inherits its effects from the cycle through g and h.
+    auto const& F = SUMMARIES.of(0);
+    BOOST_CHECK(F.recursive);
+    BOOST_CHECK(!F.loops);
+    BOOST_CHECK(!F.external);
+    BOOST_CHECK_EQUAL(F.writes.size(), 1);
+    BOOST_CHECK_EQUAL(&SUMMARIES.of(1), &SUMMARIES.of(2));
+
+    auto const& K = SUMMARIES.of(3);
+    BOOST_CHECK(K.loops);
+    BOOST_CHECK(!K.recursive);
+    BOOST_REQUIRE_EQUAL(K.writes.size(), 1);
+    BOOST_CHECK_EQUAL((*K.writes.begin())->name(), "a");
+
+    BOOST_CHECK(SUMMARIES.of(4).external);
+    BOOST_CHECK(!SUMMARIES.of(5).external);
+
+    // Calls resolve to the shared summary of their callee.
+    auto const* F_DEF = dynamic_cast<solidity::FunctionDefinition const*>(
+        GRAPH.nodes()[0]
+    );
+    BOOST_REQUIRE(F_DEF);
+    auto const& STMT = dynamic_cast<solidity::ExpressionStatement const&>(
+        *F_DEF->body().statements()[0]
+    );
+    auto const& CALL = dynamic_cast<solidity::FunctionCall const&>(
+        STMT.expression()
+    );
+    BOOST_CHECK_EQUAL(SUMMARIES.atCall(CALL), &SUMMARIES.of(1));
+}
+
+BOOST_AUTO_TEST_CASE(inherited_roots)
+{
+    char const* sourceCode = R"(
+        contract A {
+            uint n;
+            function f() public virtual { n++; }
+            function g() public { for (uint i = 0; i < n; i++) { } }
+        }
+        contract B is A {
+            function f() public override { }
+        }
+    )";
+
+    parse(sourceCode);
+    auto const* DERIVED = fetch("B");
+    CallGraph const GRAPH(*DERIVED);
+
+    // The graph is rooted at the locality, so the inherited g is a node, and
+    // the overridden f is not.
+    auto const LOCALITY = ContractSummary::localityOf(*DERIVED);
+    auto const& NODES = GRAPH.nodes();
+    BOOST_REQUIRE_EQUAL(LOCALITY.size(), 2);
+    BOOST_REQUIRE_EQUAL(NODES.size(), 2);
+    BOOST_CHECK_EQUAL(NODES[0], LOCALITY[0]);
+    BOOST_CHECK_EQUAL(NODES[1], LOCALITY[1]);
+
+    WorkStealingPool pool(2);
+    CallSummaries const SUMMARIES(GRAPH, pool);
+    BOOST_CHECK(SUMMARIES.of(0).writes.empty());
+    BOOST_CHECK(SUMMARIES.of(1).loops);
+}
+
+BOOST_AUTO_TEST_CASE(virtual_dispatch)
+{
+    char const* sourceCode = R"(
+        contract A {
+            uint n;
+            uint[] a;
+            function f() public { g(); }
+            function g() internal virtual { n++; }
+        }
+        contract B is A {
+            function g() internal override {
+                for (uint i = 0; i < 2; i++) { a.push(i); }
+            }
+        }
+    )";
+
+    parse(sourceCode);
+    CallGraph const GRAPH(*fetch("B"));
+
+    // The base f calls the override of g, so the base g is never reached.
+    auto const& NODES = GRAPH.nodes();
+    BOOST_REQUIRE_EQUAL(NODES.size(), 2);
+    BOOST_CHECK_EQUAL(NODES[0]->name(), "g");
+    BOOST_CHECK_EQUAL(NODES[1]->name(), "f");
+    BOOST_CHECK((GRAPH.callees(1) == vector<size_t>{ 0 }));
+
+    WorkStealingPool pool(2);
+    CallSummaries const SUMMARIES(GRAPH, pool);
+    auto const& F = SUMMARIES.of(1);
+    BOOST_CHECK(F.loops);
+    BOOST_REQUIRE_EQUAL(F.writes.size(), 1);
+    BOOST_CHECK_EQUAL((*F.writes.begin())->name(), "a");
+}
+
+// -------------------------------------------------------------------------- //
+
+BOOST_AUTO_TEST_SUITE_END();
+
+}
+}
+}
@@ -0,0 +1,125 @@
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Tests for libsolintent/static/ConstantTable.cpp.
+ */
+
+#include <libsolintent/static/ConstantTable.h>
+
+#include <test/CompilerFramework.h>
+#include <libsolintent/static/AnalysisEngine.h>
+#include <libsolintent/static/BoundChecker.h>
+#include <libsolintent/static/CondChecker.h>
+#include <libsolintent/static/ContractChecker.h>
+#include <libsolintent/static/FunctionChecker.h>
+#include <libsolintent/static/StatementChecker.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+namespace test
+{
+
+using TestEngine = AnalysisEngine<
+    ContractChecker, FunctionChecker, StatementChecker, BoundChecker, CondChecker
+>;
+
+BOOST_FIXTURE_TEST_SUITE(ConstantTableTest, CompilerFramework);
+
+BOOST_AUTO_TEST_CASE(dependency_order)
+{
+    char const* sourceCode = R"(
+        contract A {
+            uint constant c = b * 2;
+            uint constant b = a + 1;
+            uint constant a = 5;
+            bool constant t = true;
+            function f() public view {
+                c;
+                c;
+                t;
+            }
+        }
+    )";
+
+    auto const* AST = parse(sourceCode);
+    
+    auto const* CONTRACT = fetch("A");
+    BOOST_CHECK(!CONTRACT->definedFunctions().empty());
+
+    auto const* FUNC = CONTRACT->definedFunctions()[0];
+    BOOST_CHECK_EQUAL(FUNC->body().statements().size(), 3);
+
+    TestEngine engine;
+    auto const& TABLE = engine.foldConstants({ AST });
+    BOOST_CHECK(TABLE.failures().empty());
+
+    vector<SummaryPointer<NumericSummary>> uses;
+    for (size_t i = 0; i < 2; ++i)
+    {
+        auto const* EXPR = (FUNC->body().statements()[i]).get();
+        auto stmt = dynamic_cast<solidity::ExpressionStatement const*>(EXPR);
+        uses.push_back(engine.checkNumeric(stmt->expression()));
+
+        BOOST_CHECK(uses.back()->exactInt().has_value());
+        if (uses.back()->exactInt().has_value())
+        {
+            BOOST_CHECK(*uses.back()->exactInt() == FixedInt(12));
+        }
+    }
+
+    // Each use shares the folded value.
+    BOOST_CHECK_EQUAL(uses[0].get(), uses[1].get());
+
+    auto const* EXPR = (FUNC->body().statements()[2]).get();
+    auto stmt = dynamic_cast<solidity::ExpressionStatement const*>(EXPR);
+    auto res = engine.checkBoolean(stmt->expression());
+    BOOST_CHECK(res->exact().has_value());
+    if (res->exact().has_value())
+    {
+        BOOST_CHECK(*res->exact());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(failures_reported_once)
+{
+    char const* sourceCode = R"(
+        contract A {
+            uint constant a = uint(5);
+            function f() public view {
+                a;
+                a;
+            }
+        }
+    )";
+
+    auto const* AST = parse(sourceCode);
+    
+    auto const* CONTRACT = fetch("A");
+    BOOST_CHECK(!CONTRACT->definedFunctions().empty());
+
+    auto const* FUNC = CONTRACT->definedFunctions()[0];
+    BOOST_CHECK_EQUAL(FUNC->body().statements().size(), 2);
+
+    TestEngine engine;
+    auto const& TABLE = engine.foldConstants({ AST });
+    BOOST_CHECK_EQUAL(TABLE.failures().size(), 1);
+
+    for (auto s : FUNC->body().statements())
+    {
+        auto stmt = dynamic_cast<solidity::ExpressionStatement const*>(s.get());
+        auto res = engine.checkNumeric(stmt->expression());
+        BOOST_CHECK(!res->exact().has_value());
+    }
+    BOOST_CHECK_EQUAL(TABLE.failures().size(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
+
+}
+}
+}
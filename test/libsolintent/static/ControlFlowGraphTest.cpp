@@ -0,0 +1,177 @@
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Tests for libsolintent/static/ControlFlowGraph.cpp.
+ */
+
+#include <libsolintent/static/ControlFlowGraph.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolintent/ir/StatementSummary.h>
+#include <libsolintent/ir/StructuralSummary.h>
+#include <libsolintent/static/AnalysisEngine.h>
+#include <libsolintent/static/BoundChecker.h>
+#include <libsolintent/static/CondChecker.h>
+#include <libsolintent/static/ContractChecker.h>
+#include <libsolintent/static/FunctionChecker.h>
+#include <libsolintent/static/StatementChecker.h>
+#include <test/CompilerFramework.h>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+namespace test
+{
+
+BOOST_FIXTURE_TEST_SUITE(ControlFlowGraphTest, CompilerFramework);
+
+// -------------------------------------------------------------------------- //
+
+BOOST_AUTO_TEST_CASE(branches_and_jumps)
+{
+    char const* sourceCode = R"(
+        contract A {
+            function f(uint n) public pure {
+                uint k = 0;
+                for (uint i = 0; i < n; ++i) {
+                    if (i == 5) { continue; }
+                    if (i == 7) { break; } else { k++; }
+                }
+                return;
+            }
+        }
+    )";
+
+    parse(sourceCode);
+    auto const* FUNC = fetch("A")->definedFunctions()[0];
+
+    AnalysisEngine<StatementChecker, BoundChecker, CondChecker> engine;
+    auto const BODY = engine.checkStatement(FUNC->body());
+    ControlFlowGraph const CFG(*BODY);
+
+    auto const& BLOCKS = CFG.blocks();
+    auto const& RPO = CFG.reversePostOrder();
+
+    // The entry holds both declarations, and falls into the loop header.
+    auto const& ENTRY = BLOCKS[CFG.entry()];
+    BOOST_CHECK_EQUAL(ENTRY.statements.size(), 2);
+    BOOST_REQUIRE_EQUAL(ENTRY.succs.size(), 1);
+    BOOST_CHECK_EQUAL(RPO.front(), CFG.entry());
+
+    BOOST_REQUIRE_EQUAL(CFG.loops().size(), 1);
+    auto const& LOOP = CFG.loops()[0];
+    auto const& HEADER = BLOCKS[LOOP.header];
+    BOOST_CHECK_EQUAL(ENTRY.succs[0], LOOP.header);
+    BOOST_CHECK(HEADER.loop != nullptr);
+    BOOST_CHECK(HEADER.condition != nullptr);
+    BOOST_CHECK_EQUAL(HEADER.succs.size(), 2);
+
+    // The header is entered from the entry, and from the latch, which is also
+    // the continue target.
+    BOOST_CHECK_EQUAL(HEADER.preds.size(), 2);
+    size_t const LATCH = HEADER.preds[1];
+    BOOST_CHECK_EQUAL(BLOCKS[LATCH].statements.size(), 1);
+    BOOST_CHECK_EQUAL(BLOCKS[LATCH].preds.size(), 2);
+
+    // The exit is reached by the return, and by the unreachable block after it.
+    auto const& EXIT = BLOCKS[CFG.exit()];
+    BOOST_CHECK_EQUAL(EXIT.preds.size(), 2);
+
+    // Blocks after jumps are unreachable, and are left out of the order.
+    size_t unreachable = 0;
+    for (size_t i = 0; i < BLOCKS.size(); ++i)
+    {
+        if (i != CFG.entry() && BLOCKS[i].preds.empty()) ++unreachable;
+    }
+    BOOST_CHECK_EQUAL(unreachable, 3);
+    BOOST_CHECK_EQUAL(RPO.size(), BLOCKS.size() - unreachable);
+
+    // Each reachable block precedes its successors, other than the header.
+    vector<size_t> rank(BLOCKS.size(), BLOCKS.size());
+    for (size_t i = 0; i < RPO.size(); ++i) rank[RPO[i]] = i;
+    for (auto const B : RPO)
+    {
+        for (auto const S : BLOCKS[B].succs)
+        {
+            if (S != LOOP.header) BOOST_CHECK_LT(rank[B], rank[S]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(modifiers_are_spliced)
+{
+    char const* sourceCode = R"(
+        contract A {
+            uint n;
+            modifier guarded() { if (n == 0) { return; } _; n++; }
+            function f(uint k) public guarded { if (k == 1) { return; } n++; }
+            function g() public guarded { n++; }
+        }
+    )";
+
+    parse(sourceCode);
+    auto const FUNCS = fetch("A")->definedFunctions();
+
+    AnalysisEngine<
+        ContractChecker,
+        FunctionChecker,
+        StatementChecker,
+        BoundChecker,
+        CondChecker
+    > engine;
+    auto const F = engine.checkFunction(*FUNCS[0]);
+    auto const G = engine.checkFunction(*FUNCS[1]);
+
+    // The modifier is summarized once, and shared by both functions.
+    BOOST_REQUIRE_EQUAL(F->modifiers().size(), 1);
+    BOOST_REQUIRE_EQUAL(G->modifiers().size(), 1);
+    BOOST_CHECK_EQUAL(F->modifiers()[0], G->modifiers()[0]);
+
+    // Each function runs at the placeholder, so both returns and the final
+    // statement of the modifier are reachable.
+    ControlFlowGraph const CFG(*F);
+    auto const& BLOCKS = CFG.blocks();
+    size_t statements = 0;
+    for (auto const B : CFG.reversePostOrder())
+    {
+        statements += BLOCKS[B].statements.size();
+    }
+    BOOST_CHECK_EQUAL(statements, 4);
+
+    // The modifier returns to the exit, whereas the function returns to the
+    // statement after the placeholder.
+    vector<size_t> targets;
+    for (auto const B : CFG.reversePostOrder())
+    {
+        // TODO: remove cast.
+        auto const& STMTS = BLOCKS[B].statements;
+        if (STMTS.empty()) continue;
+        if (dynamic_cast<JumpSummary const*>(STMTS.back()))
+        {
+            targets.push_back(BLOCKS[B].succs[0]);
+        }
+    }
+    sort(targets.begin(), targets.end());
+    BOOST_REQUIRE_EQUAL(targets.size(), 2);
+    BOOST_CHECK_EQUAL(targets[0], CFG.exit());
+
+    auto const& RESUME = BLOCKS[targets[1]];
+    BOOST_CHECK_EQUAL(RESUME.statements.size(), 1);
+    BOOST_REQUIRE_EQUAL(RESUME.succs.size(), 1);
+    BOOST_CHECK_EQUAL(RESUME.succs[0], CFG.exit());
+    BOOST_CHECK_EQUAL(BLOCKS[CFG.exit()].preds.size(), 2);
+    BOOST_CHECK_EQUAL(CFG.reversePostOrder().size(), BLOCKS.size() - 2);
+}
+
+// -------------------------------------------------------------------------- //
+
+BOOST_AUTO_TEST_SUITE_END();
+
+}
+}
+}
@@ -0,0 +1,179 @@
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Tests for libsolintent/static/ExpressionTable.cpp.
+ */
+
+#include <libsolintent/static/ExpressionTable.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolintent/ir/ExpressionSummary.h>
+#include <libsolintent/static/AnalysisEngine.h>
+#include <libsolintent/static/BoundChecker.h>
+#include <libsolintent/static/CondChecker.h>
+#include <libsolintent/static/ContractChecker.h>
+#include <libsolintent/static/FunctionChecker.h>
+#include <libsolintent/static/StatementChecker.h>
+#include <test/CompilerFramework.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+namespace test
+{
+
+using TestEngine = AnalysisEngine<
+    ContractChecker, FunctionChecker, StatementChecker, BoundChecker, CondChecker
+>;
+
+BOOST_FIXTURE_TEST_SUITE(ExpressionTableTest, CompilerFramework);
+
+// -------------------------------------------------------------------------- //
+
+BOOST_AUTO_TEST_CASE(interns_constants)
+{
+    char const* sourceCode = R"(
+        contract A {
+            function f() public pure returns (uint) { return 7; }
+            function g() public pure returns (uint) { return 7; }
+            function h() public pure returns (uint) { return 8; }
+        }
+    )";
+
+    parse(sourceCode);
+    auto const FUNCS = fetch("A")->definedFunctions();
+
+    vector<int> const VALUES{ 7, 7, 8 };
+    vector<shared_ptr<NumericConstant>> summaries;
+    for (size_t i = 0; i < FUNCS.size(); ++i)
+    {
+        // TODO: remove cast.
+        auto const& RETURN = dynamic_cast<solidity::Return const&>(
+            *FUNCS[i]->body().statements()[0]
+        );
+        summaries.push_back(make_shared<NumericConstant>(
+            *RETURN.expression(), solidity::rational(VALUES[i])
+        ));
+    }
+
+    ExpressionTable table;
+    auto const F = table.intern(summaries[0]);
+    auto const G = table.intern(summaries[1]);
+    auto const H = table.intern(summaries[2]);
+
+    BOOST_CHECK_EQUAL(F.get(), summaries[0].get());
+    BOOST_CHECK_EQUAL(G.get(), F.get());
+    BOOST_CHECK_NE(H.get(), F.get());
+    BOOST_CHECK_EQUAL(table.size(), 2);
+    BOOST_CHECK_EQUAL(table.hits(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(shares_conditions)
+{
+    char const* sourceCode = R"(
+        contract A {
+            uint[] a;
+            uint[] b;
+            uint n;
+            function f() public view {
+                for (; n < a.length; ) { }
+            }
+            function g() public view {
+                for (; n < a.length; ) { }
+            }
+            function h() public view {
+                for (; n < b.length; ) { }
+            }
+        }
+    )";
+
+    parse(sourceCode);
+    auto const FUNCS = fetch("A")->definedFunctions();
+
+    vector<SummaryPointer<BooleanSummary>> conds;
+    TestEngine engine;
+    for (auto const* func : FUNCS)
+    {
+        // TODO: remove cast.
+        auto const& LOOP = dynamic_cast<solidity::ForStatement const&>(
+            *func->body().statements()[0]
+        );
+        conds.push_back(engine.checkBoolean(*LOOP.condition()));
+    }
+
+    BOOST_CHECK_EQUAL(conds[0].get(), conds[1].get());
+    BOOST_CHECK_NE(conds[0].get(), conds[2].get());
+}
+
+BOOST_AUTO_TEST_CASE(distinct_counters)
+{
+    char const* sourceCode = R"(
+        contract A {
+            uint[] a;
+            function f() public view {
+                for (uint i = 0; i < a.length; i++) { }
+                for (uint i = 0; i < a.length; i++) { }
+            }
+        }
+    )";
+
+    parse(sourceCode);
+    auto const& STMTS = fetch("A")->definedFunctions()[0]->body().statements();
+
+    vector<SummaryPointer<Comparison>> conds;
+    TestEngine engine;
+    for (auto const& stmt : STMTS)
+    {
+        // TODO: remove casts.
+        auto const& LOOP = dynamic_cast<solidity::ForStatement const&>(*stmt);
+        conds.push_back(dynamic_pointer_cast<Comparison const>(
+            engine.checkBoolean(*LOOP.condition())
+        ));
+        BOOST_REQUIRE(conds.back());
+    }
+
+    // The counters share a name, but not a declaration. The bound is shared.
+    BOOST_CHECK_NE(conds[0].get(), conds[1].get());
+    BOOST_CHECK_NE(conds[0]->lhs().get(), conds[1]->lhs().get());
+    BOOST_CHECK_EQUAL(conds[0]->rhs().get(), conds[1]->rhs().get());
+}
+
+BOOST_AUTO_TEST_CASE(push_not_shared)
+{
+    char const* sourceCode = R"(
+        contract A {
+            uint[] a;
+            function f() public { a.push(1); }
+            function g() public { a.push(1); }
+        }
+    )";
+
+    parse(sourceCode);
+    auto const FUNCS = fetch("A")->definedFunctions();
+
+    vector<SummaryPointer<NumericSummary>> calls;
+    TestEngine engine;
+    for (auto const* func : FUNCS)
+    {
+        // TODO: remove cast.
+        auto const& STMT = dynamic_cast<solidity::ExpressionStatement const&>(
+            *func->body().statements()[0]
+        );
+        calls.push_back(engine.checkNumeric(STMT.expression()));
+    }
+
+    BOOST_CHECK(dynamic_pointer_cast<PushCall const>(calls[0]));
+    BOOST_CHECK_NE(calls[0].get(), calls[1].get());
+}
+
+// -------------------------------------------------------------------------- //
+
+BOOST_AUTO_TEST_SUITE_END();
+
+}
+}
+}
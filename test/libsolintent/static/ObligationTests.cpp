@@ -9,9 +9,14 @@
 #include <libsolintent/ir/StatementSummary.h>
 #include <libsolintent/static/BoundChecker.h>
 #include <libsolintent/static/CondChecker.h>
+#include <libsolintent/static/ContractChecker.h>
+#include <libsolintent/static/FunctionChecker.h>
 #include <libsolintent/static/StatementChecker.h>
+#include <libsolintent/util/WorkStealingPool.h>
 #include <test/CompilerFramework.h>
 #include <boost/test/unit_test.hpp>
+#include <optional>
+#include <vector>
 
 using namespace std;
 
@@ -27,53 +32,52 @@ class TestTemplate: public AssertionTemplate
 public:
     TestTemplate(AssertionTemplate::Type _t): AssertionTemplate(_t) {}
 
-    void acceptIR(TreeBlockSummary const& _ir) override
+protected:
+    void inspect(TreeBlockSummary const& _ir, Context & _ctx) const override
     {
-        for (size_t i = 0; i < _ir.summaryLength(); ++i)
+        for (size_t i = 0; i < _ir.summaryLength() && !_ctx.isRaised(); ++i)
         {
-           if (!done)
-           {
-               _ir.get(i)->acceptIR(*this);
-           }
+            _ir.get(i)->acceptIR(_ctx);
         }
     }
 
-    void acceptIR(NumericExprStatement const& _ir) override
+    void inspect(NumericExprStatement const&, Context & _ctx) const override
     {
-        done = true;
-        raiseAlarm();
+        _ctx.raiseAlarm();
     }
-
-
-    void acceptIR(LoopSummary const& _ir) override {}
-    void acceptIR(BooleanExprStatement const& _ir) override {}
-    void acceptIR(FreshVarSummary const& _ir) override {}
-    void acceptIR(PushCall const& _ir) override {}
-
-    void acceptIR(NumericConstant const& _ir) override {}
-    void acceptIR(NumericVariable const& _ir) override {}
-    void acceptIR(BooleanConstant const& _ir) override {}
-    void acceptIR(BooleanVariable const& _ir) override {}
-    void acceptIR(Comparison const& _ir) override {}
-
-    bool done = false;
 };
 
 class TestPattern: public ContractPattern
 {
-public:
-    void aggregate() override
+protected:
+    struct Scratch: State
+    {
+        int64_t count = 0;
+        int64_t functions = 0;
+    };
+
+    unique_ptr<State> makeState() const override
+    {
+        return make_unique<Scratch>();
+    }
+
+    void aggregate(Context & _ctx) const override
     {
-        setSolution(count);
+        _ctx.setSolution(_ctx.state<Scratch>().count);
     }
 
-    bool visit(solidity::Literal const&)
+    void clearObligation(Context &) const override {}
+
+    void setObligation(ContractSummary const& _ir, Context & _ctx) const override
     {
-        count += activeObligation().definedFunctions().size();
-        return false;
+        _ctx.state<Scratch>().functions = _ir.summaryLength();
     }
 
-    int64_t count{0};
+    void abductFrom(NumericExprStatement const&, Context & _ctx) const override
+    {
+        auto & scratch = _ctx.state<Scratch>();
+        scratch.count += scratch.functions;
+    }
 };
 
 BOOST_FIXTURE_TEST_SUITE(ObligationTests, CompilerFramework);
@@ -147,13 +151,69 @@ BOOST_AUTO_TEST_CASE(program_pattern)
     auto const* CONTRACT = fetch("A");
     BOOST_CHECK_EQUAL(CONTRACT->definedFunctions().size(), 2);
 
-    TestPattern tester;
-    auto result = tester.abductExplanation(*CONTRACT, *CONTRACT);
+    AnalysisEngine<
+        ContractChecker,
+        FunctionChecker,
+        StatementChecker,
+        BoundChecker,
+        CondChecker
+    > engine;
+    auto const SUMMARY = engine.checkContract(*CONTRACT);
+
+    // Repeated queries against one instance must not share state.
+    TestPattern const tester{};
+    for (size_t i = 0; i < 2; ++i)
+    {
+        auto result = tester.abductExplanation(*SUMMARY, *SUMMARY);
 
-    BOOST_CHECK(result.has_value());
-    if (result.has_value())
+        BOOST_CHECK(result.has_value());
+        if (result.has_value())
+        {
+            BOOST_CHECK_EQUAL(*result, 10);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(shared_pattern)
+{
+    char const* sourceCode = R"(
+        contract A {
+            function f() public view {
+                1; 2; 3;
+            }
+            function g() public view {
+                4; 5;
+            }
+        }
+    )";
+
+    auto const* AST = parse(sourceCode);
+
+    AnalysisEngine<
+        ContractChecker,
+        FunctionChecker,
+        StatementChecker,
+        BoundChecker,
+        CondChecker
+    > engine;
+    auto const SUMMARY = engine.checkContract(*fetch("A"));
+
+    // One instance serves every worker at once.
+    size_t const JOBS = 64;
+    TestPattern const tester{};
+    vector<optional<int64_t>> results(JOBS);
+    WorkStealingPool pool(4);
+    pool.parallelFor(JOBS, [&](size_t, size_t _job) {
+        results[_job] = tester.abductExplanation(*SUMMARY, *SUMMARY);
+    });
+
+    for (auto const& result : results)
     {
-        BOOST_CHECK_EQUAL(*result, 10);
+        BOOST_CHECK(result.has_value());
+        if (result.has_value())
+        {
+            BOOST_CHECK_EQUAL(*result, 10);
+        }
     }
 }
 
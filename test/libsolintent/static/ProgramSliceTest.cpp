@@ -0,0 +1,235 @@
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Tests for libsolintent/static/ProgramSlice.cpp.
+ */
+
+#include <libsolintent/static/ProgramSlice.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolintent/ir/StatementSummary.h>
+#include <libsolintent/ir/StructuralSummary.h>
+#include <libsolintent/static/AnalysisEngine.h>
+#include <libsolintent/static/BoundChecker.h>
+#include <libsolintent/static/CondChecker.h>
+#include <libsolintent/static/ContractChecker.h>
+#include <libsolintent/static/FunctionChecker.h>
+#include <libsolintent/static/StatementChecker.h>
+#include <test/CompilerFramework.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+namespace test
+{
+
+BOOST_FIXTURE_TEST_SUITE(ProgramSliceTest, CompilerFramework);
+
+// -------------------------------------------------------------------------- //
+
+BOOST_AUTO_TEST_CASE(transitive_slice)
+{
+    char const* sourceCode = R"(
+        contract A {
+            uint[] a;
+            uint[] unrelated;
+            uint n;
+            bool open;
+            function loop() public view {
+                for (uint i = 0; i < a.length; ++i) { }
+            }
+            function grow() public {
+                if (open) { a.push(n); }
+                unrelated.push(1);
+            }
+            function count() public { n++; }
+            function other() public { unrelated.push(2); }
+            function toggle() public { open = !open; }
+        }
+    )";
+
+    parse(sourceCode);
+    auto const* CONTRACT = fetch("A");
+    auto const FUNCS = CONTRACT->definedFunctions();
+    auto const VARS = CONTRACT->stateVariables();
+
+    AnalysisEngine<
+        ContractChecker,
+        FunctionChecker,
+        StatementChecker,
+        BoundChecker,
+        CondChecker
+    > engine;
+
+    auto const& LOOP_STMT = *FUNCS[0]->body().statements()[0];
+    auto const LOOP = dynamic_pointer_cast<LoopSummary const>(
+        engine.checkStatement(LOOP_STMT)
+    );
+    BOOST_REQUIRE(LOOP);
+
+    auto const LOCALITY = engine.checkContract(*CONTRACT);
+    ProgramSlice const SLICE(*LOOP, *LOCALITY);
+
+    // a is read by the condition, n is pushed to a, and open controls the push.
+    BOOST_CHECK_EQUAL(SLICE.variables().size(), 3);
+    BOOST_CHECK_EQUAL(SLICE.variables().count(VARS[0]->id()), 1);
+    BOOST_CHECK_EQUAL(SLICE.variables().count(VARS[1]->id()), 0);
+    BOOST_CHECK_EQUAL(SLICE.variables().count(VARS[2]->id()), 1);
+    BOOST_CHECK_EQUAL(SLICE.variables().count(VARS[3]->id()), 1);
+
+    BOOST_CHECK((SLICE.functions() == vector<size_t>{ 1, 2, 4 }));
+
+    // The push, and the branch around it, are kept. The unrelated push is not.
+    auto const& GROW = FUNCS[1]->body();
+    BOOST_CHECK(SLICE.contains(GROW.id()));
+    BOOST_CHECK(SLICE.contains(GROW.statements()[0]->id()));
+    BOOST_CHECK(!SLICE.contains(GROW.statements()[1]->id()));
+    BOOST_CHECK(!SLICE.contains(FUNCS[3]->body().id()));
+}
+
+BOOST_AUTO_TEST_CASE(internal_calls)
+{
+    char const* sourceCode = R"(
+        contract A {
+            uint[] a;
+            bool open;
+            uint unrelated;
+            function loop() public view {
+                for (uint i = 0; i < a.length; ++i) { }
+            }
+            function isOpen() internal view returns (bool) { return open; }
+            function grow() public { if (isOpen()) { a.push(1); } }
+            function toggle() public { open = !open; }
+            function other() public { unrelated++; }
+        }
+    )";
+
+    parse(sourceCode);
+    auto const* CONTRACT = fetch("A");
+    auto const FUNCS = CONTRACT->definedFunctions();
+    auto const VARS = CONTRACT->stateVariables();
+
+    AnalysisEngine<
+        ContractChecker,
+        FunctionChecker,
+        StatementChecker,
+        BoundChecker,
+        CondChecker
+    > engine;
+
+    auto const& LOOP_STMT = *FUNCS[0]->body().statements()[0];
+    auto const LOOP = dynamic_pointer_cast<LoopSummary const>(
+        engine.checkStatement(LOOP_STMT)
+    );
+    BOOST_REQUIRE(LOOP);
+
+    auto const LOCALITY = engine.checkContract(*CONTRACT);
+    ProgramSlice const SLICE(*LOOP, *LOCALITY);
+
+    // The push is controlled by open, which is read through the helper.
+    BOOST_CHECK_EQUAL(SLICE.variables().size(), 2);
+    BOOST_CHECK_EQUAL(SLICE.variables().count(VARS[1]->id()), 1);
+    BOOST_CHECK((SLICE.functions() == vector<size_t>{ 2, 3 }));
+    BOOST_CHECK(!SLICE.contains(FUNCS[4]->body().id()));
+}
+
+BOOST_AUTO_TEST_CASE(virtual_calls)
+{
+    char const* sourceCode = R"(
+        contract A {
+            uint[] a;
+            function loop() public view {
+                for (uint i = 0; i < a.length; ++i) { }
+            }
+            function isOpen() internal view virtual returns (bool) {
+                return true;
+            }
+            function grow() public { if (isOpen()) { a.push(1); } }
+        }
+        contract B is A {
+            bool open;
+            function isOpen() internal view override returns (bool) {
+                return open;
+            }
+            function toggle() public { open = !open; }
+        }
+    )";
+
+    parse(sourceCode);
+    auto const* CONTRACT = fetch("B");
+    auto const BASE_FUNCS = fetch("A")->definedFunctions();
+
+    AnalysisEngine<
+        ContractChecker,
+        FunctionChecker,
+        StatementChecker,
+        BoundChecker,
+        CondChecker
+    > engine;
+
+    auto const& LOOP_STMT = *BASE_FUNCS[0]->body().statements()[0];
+    auto const LOOP = dynamic_pointer_cast<LoopSummary const>(
+        engine.checkStatement(LOOP_STMT)
+    );
+    BOOST_REQUIRE(LOOP);
+
+    // The locality of B is isOpen and toggle, followed by loop and grow. The
+    // push is controlled by open, which is only read through the override.
+    auto const LOCALITY = engine.checkContract(*CONTRACT);
+    ProgramSlice const SLICE(*LOOP, *LOCALITY);
+    BOOST_CHECK_EQUAL(SLICE.variables().size(), 2);
+    BOOST_CHECK((SLICE.functions() == vector<size_t>{ 1, 3 }));
+}
+
+BOOST_AUTO_TEST_CASE(opaque_calls)
+{
+    char const* sourceCode = R"(
+        contract A {
+            uint[] a;
+            uint unrelated;
+            function loop() public view {
+                for (uint i = 0; i < a.length; ++i) { }
+            }
+            function isOpen() public pure returns (bool) { return true; }
+            function grow() public { if (this.isOpen()) { a.push(1); } }
+            function other() public { unrelated++; }
+        }
+    )";
+
+    parse(sourceCode);
+    auto const* CONTRACT = fetch("A");
+    auto const FUNCS = CONTRACT->definedFunctions();
+
+    AnalysisEngine<
+        ContractChecker,
+        FunctionChecker,
+        StatementChecker,
+        BoundChecker,
+        CondChecker
+    > engine;
+
+    auto const& LOOP_STMT = *FUNCS[0]->body().statements()[0];
+    auto const LOOP = dynamic_pointer_cast<LoopSummary const>(
+        engine.checkStatement(LOOP_STMT)
+    );
+    BOOST_REQUIRE(LOOP);
+
+    auto const LOCALITY = engine.checkContract(*CONTRACT);
+    ProgramSlice const SLICE(*LOOP, *LOCALITY);
+
+    // An external call may read any state, so nothing is sliced away.
+    BOOST_CHECK((SLICE.functions() == vector<size_t>{ 0, 1, 2, 3 }));
+    BOOST_CHECK(SLICE.contains(FUNCS[3]->body().id()));
+}
+
+// -------------------------------------------------------------------------- //
+
+BOOST_AUTO_TEST_SUITE_END();
+
+}
+}
+}
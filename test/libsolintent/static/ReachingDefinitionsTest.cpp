@@ -0,0 +1,104 @@
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Tests for libsolintent/static/ReachingDefinitions.cpp.
+ */
+
+#include <libsolintent/static/ReachingDefinitions.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolintent/static/AnalysisEngine.h>
+#include <libsolintent/static/BoundChecker.h>
+#include <libsolintent/static/CondChecker.h>
+#include <libsolintent/static/StatementChecker.h>
+#include <test/CompilerFramework.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+namespace test
+{
+
+BOOST_FIXTURE_TEST_SUITE(ReachingDefinitionsTest, CompilerFramework);
+
+// -------------------------------------------------------------------------- //
+
+BOOST_AUTO_TEST_CASE(loop_variants)
+{
+    char const* sourceCode = R"(
+        contract A {
+            function f(uint n) public pure {
+                uint k = 0;
+                uint m = 1;
+                for (uint i = 0; i < n; ++i) {
+                    if (i == 7) { break; } else { k++; }
+                }
+                m++;
+            }
+        }
+    )";
+
+    parse(sourceCode);
+    auto const* FUNC = fetch("A")->definedFunctions()[0];
+    auto const& STMTS = FUNC->body().statements();
+
+    // TODO: remove casts.
+    using DeclStatement = solidity::VariableDeclarationStatement;
+    auto const* K = dynamic_cast<DeclStatement const&>(*STMTS[0])
+        .declarations()[0].get();
+    auto const* M = dynamic_cast<DeclStatement const&>(*STMTS[1])
+        .declarations()[0].get();
+    auto const& LOOP_AST = dynamic_cast<solidity::ForStatement const&>(
+        *STMTS[2]
+    );
+    auto const* I = dynamic_cast<DeclStatement const&>(
+        *LOOP_AST.initializationExpression()
+    ).declarations()[0].get();
+
+    AnalysisEngine<StatementChecker, BoundChecker, CondChecker> engine;
+    auto const BODY = engine.checkStatement(FUNC->body());
+    ControlFlowGraph const CFG(*BODY);
+    ReachingDefinitions const DEFS(CFG);
+
+    // Declarations of k, m and i, the increments of k and i, and m++.
+    BOOST_CHECK_EQUAL(DEFS.definitions().size(), 6);
+
+    // Both definitions of k and i reach the header, but only one of m.
+    auto const& LOOP = CFG.loops()[0];
+    map<solidity::VariableDeclaration const*, size_t> counts;
+    auto const& REACHING = DEFS.reachingIn(LOOP.header);
+    for (size_t i = 0; i < DEFS.definitions().size(); ++i)
+    {
+        if (REACHING.test(i)) ++counts[DEFS.definitions()[i].var];
+    }
+    BOOST_CHECK_EQUAL(counts[K], 2);
+    BOOST_CHECK_EQUAL(counts[I], 2);
+    BOOST_CHECK_EQUAL(counts[M], 1);
+
+    auto const VARIANTS = DEFS.variantsOf(LOOP);
+    BOOST_CHECK_EQUAL(VARIANTS.size(), 2);
+    BOOST_CHECK_EQUAL(VARIANTS.count(K), 1);
+    BOOST_CHECK_EQUAL(VARIANTS.count(I), 1);
+
+    // At the exit, the increment of m has replaced its declaration.
+    counts.clear();
+    auto const& AT_EXIT = DEFS.reachingIn(CFG.exit());
+    for (size_t i = 0; i < DEFS.definitions().size(); ++i)
+    {
+        if (AT_EXIT.test(i)) ++counts[DEFS.definitions()[i].var];
+    }
+    BOOST_CHECK_EQUAL(counts[M], 1);
+    BOOST_CHECK_EQUAL(counts[K], 2);
+}
+
+// -------------------------------------------------------------------------- //
+
+BOOST_AUTO_TEST_SUITE_END();
+
+}
+}
+}
@@ -0,0 +1,184 @@
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Tests for libsolintent/static/SsaForm.cpp.
+ */
+
+#include <libsolintent/static/SsaForm.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolintent/ir/StatementSummary.h>
+#include <libsolintent/static/AnalysisEngine.h>
+#include <libsolintent/static/BoundChecker.h>
+#include <libsolintent/static/CondChecker.h>
+#include <libsolintent/static/DominatorTree.h>
+#include <libsolintent/static/StatementChecker.h>
+#include <test/CompilerFramework.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+namespace test
+{
+
+BOOST_FIXTURE_TEST_SUITE(SsaFormTest, CompilerFramework);
+
+// -------------------------------------------------------------------------- //
+
+BOOST_AUTO_TEST_CASE(induction_variables)
+{
+    char const* sourceCode = R"(
+        contract A {
+            function f(uint n) public pure {
+                uint k = 0;
+                uint m = 1;
+                for (uint i = 0; i < n; ++i) {
+                    if (i == 7) { break; } else { k++; }
+                }
+                m++;
+            }
+        }
+    )";
+
+    parse(sourceCode);
+    auto const* FUNC = fetch("A")->definedFunctions()[0];
+    auto const& STMTS = FUNC->body().statements();
+
+    // TODO: remove casts.
+    auto const& LOOP_AST = dynamic_cast<solidity::ForStatement const&>(
+        *STMTS[2]
+    );
+    auto const& COND_AST = dynamic_cast<solidity::BinaryOperation const&>(
+        *LOOP_AST.condition()
+    );
+    auto const& I_READ = dynamic_cast<solidity::Identifier const&>(
+        COND_AST.leftExpression()
+    );
+    auto const& N_READ = dynamic_cast<solidity::Identifier const&>(
+        COND_AST.rightExpression()
+    );
+    auto const& M_INC = dynamic_cast<solidity::UnaryOperation const&>(
+        dynamic_cast<solidity::ExpressionStatement const&>(
+            *STMTS[3]
+        ).expression()
+    );
+    auto const& M_READ = dynamic_cast<solidity::Identifier const&>(
+        M_INC.subExpression()
+    );
+
+    AnalysisEngine<StatementChecker, BoundChecker, CondChecker> engine;
+    auto const BODY = engine.checkStatement(FUNC->body());
+    ControlFlowGraph const CFG(*BODY);
+    SsaForm const SSA(CFG);
+
+    auto const& LOOP = CFG.loops()[0];
+    auto const DEFS = SSA.definedBy(*LOOP.summary->initializer());
+    auto const STEPS = SSA.definedBy(*LOOP.summary->update());
+    BOOST_REQUIRE_EQUAL(DEFS.size(), 1);
+    BOOST_REQUIRE_EQUAL(STEPS.size(), 1);
+
+    // The condition reads a phi node, which merges the initial value with the
+    // value after each step.
+    auto const* PHI = SSA.valueOf(I_READ);
+    BOOST_REQUIRE(PHI != nullptr);
+    BOOST_CHECK(PHI->kind == SsaForm::Value::Kind::Phi);
+    BOOST_CHECK_EQUAL(PHI->block, LOOP.header);
+    BOOST_REQUIRE_EQUAL(PHI->operands.size(), 2);
+    BOOST_CHECK_EQUAL(PHI->operands[0], DEFS[0]);
+    BOOST_CHECK_EQUAL(PHI->operands[1], STEPS[0]);
+
+    // Each step reads the phi node, closing the cycle.
+    BOOST_CHECK(STEPS[0]->kind == SsaForm::Value::Kind::Def);
+    BOOST_REQUIRE_EQUAL(STEPS[0]->operands.size(), 1);
+    BOOST_CHECK_EQUAL(STEPS[0]->operands[0], PHI);
+    BOOST_CHECK_EQUAL(STEPS[0]->uses.size(), 1);
+    BOOST_CHECK_EQUAL(STEPS[0]->uses[0].phi, PHI);
+
+    // Parameters are never written, so they only hold their entry value.
+    auto const* N = SSA.valueOf(N_READ);
+    BOOST_REQUIRE(N != nullptr);
+    BOOST_CHECK(N->kind == SsaForm::Value::Kind::Entry);
+    BOOST_CHECK_EQUAL(N->version, 0);
+    BOOST_CHECK_EQUAL(N->uses.size(), 1);
+
+    // Variables written only outside of the loop need no phi node.
+    auto const* M = SSA.valueOf(M_READ);
+    BOOST_REQUIRE(M != nullptr);
+    BOOST_CHECK(M->kind == SsaForm::Value::Kind::Def);
+    BOOST_CHECK_EQUAL(M->block, CFG.entry());
+    BOOST_CHECK_EQUAL(M->version, 1);
+
+    auto const VARIANTS = SSA.variantsOf(LOOP);
+    BOOST_CHECK_EQUAL(VARIANTS.size(), 2);
+    BOOST_CHECK_EQUAL(VARIANTS.count(PHI->var), 1);
+    BOOST_CHECK_EQUAL(VARIANTS.count(M->var), 0);
+    BOOST_CHECK_EQUAL(SSA.phisAt(LOOP.header).size(), 2);
+
+    DominatorTree const TREE(CFG);
+    BOOST_CHECK(TREE.dominates(CFG.entry(), LOOP.header));
+    BOOST_CHECK(TREE.dominates(LOOP.header, CFG.exit()));
+    BOOST_CHECK(!TREE.dominates(CFG.exit(), LOOP.header));
+    BOOST_CHECK_EQUAL(TREE.frontier(LOOP.header).count(LOOP.header), 1);
+}
+
+BOOST_AUTO_TEST_CASE(identical_loops)
+{
+    char const* sourceCode = R"(
+        contract A {
+            function f(uint n) public pure {
+                uint k = 0;
+                while (k < n) { k++; }
+                while (k < n) { k++; }
+            }
+        }
+    )";
+
+    parse(sourceCode);
+    auto const* FUNC = fetch("A")->definedFunctions()[0];
+    auto const& STMTS = FUNC->body().statements();
+
+    // TODO: remove casts.
+    vector<solidity::Identifier const*> reads;
+    for (size_t i = 1; i < STMTS.size(); ++i)
+    {
+        auto const& LOOP_AST = dynamic_cast<solidity::WhileStatement const&>(
+            *STMTS[i]
+        );
+        auto const& COND_AST = dynamic_cast<solidity::BinaryOperation const&>(
+            LOOP_AST.condition()
+        );
+        reads.push_back(&dynamic_cast<solidity::Identifier const&>(
+            COND_AST.leftExpression()
+        ));
+    }
+
+    AnalysisEngine<StatementChecker, BoundChecker, CondChecker> engine;
+    auto const BODY = engine.checkStatement(FUNC->body());
+    ControlFlowGraph const CFG(*BODY);
+    SsaForm const SSA(CFG);
+
+    // Each condition is scanned within its own loop, even if the two loops
+    // share a condition summary.
+    auto const& LOOPS = CFG.loops();
+    BOOST_REQUIRE_EQUAL(LOOPS.size(), 2);
+    for (size_t i = 0; i < LOOPS.size(); ++i)
+    {
+        auto const* PHI = SSA.valueOf(*reads[i]);
+        BOOST_REQUIRE(PHI != nullptr);
+        BOOST_CHECK(PHI->kind == SsaForm::Value::Kind::Phi);
+        BOOST_CHECK_EQUAL(PHI->block, LOOPS[i].header);
+        BOOST_CHECK_EQUAL(PHI->uses[0].read, reads[i]);
+    }
+}
+
+// -------------------------------------------------------------------------- //
+
+BOOST_AUTO_TEST_SUITE_END();
+
+}
+}
+}
@@ -0,0 +1,92 @@
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Tests for libsolintent/static/SyntacticFeatures.cpp.
+ */
+
+#include <libsolintent/static/SyntacticFeatures.h>
+
+#include <libsolidity/ast/AST.h>
+#include <test/CompilerFramework.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+namespace test
+{
+
+BOOST_FIXTURE_TEST_SUITE(SyntacticFeaturesTest, CompilerFramework);
+
+using Feature = SyntacticFeatures::Feature;
+
+// -------------------------------------------------------------------------- //
+
+BOOST_AUTO_TEST_CASE(covers)
+{
+    SyntacticFeatures const NONE;
+    SyntacticFeatures const LOOP{ Feature::Loop };
+    SyntacticFeatures const LOOP_LENGTH{ Feature::Loop, Feature::Length };
+
+    BOOST_CHECK(NONE.covers(NONE));
+    BOOST_CHECK(LOOP.covers(NONE));
+    BOOST_CHECK(!NONE.covers(LOOP));
+    BOOST_CHECK(LOOP_LENGTH.covers(LOOP));
+    BOOST_CHECK(!LOOP.covers(LOOP_LENGTH));
+}
+
+BOOST_AUTO_TEST_CASE(scan)
+{
+    char const* sourceCode = R"(
+        contract A {
+            uint[] a;
+            function empty() public pure { }
+            function forLoop() public pure { for (;;) { } }
+            function whileLoop() public pure { while (true) { } }
+            function doLoop() public pure { do { } while (true); }
+            function pushes() public { a.push(1); }
+            function reads() public view returns (uint) { return a.length; }
+            function inlined() public pure { assembly { } }
+            function nested() public {
+                for (uint i = 0; i < a.length; ++i) { a.push(i); }
+            }
+        }
+    )";
+
+    parse(sourceCode);
+    auto const FUNCS = fetch("A")->definedFunctions();
+    BOOST_REQUIRE_EQUAL(FUNCS.size(), 8);
+
+    vector<SyntacticFeatures> features;
+    for (auto const* func : FUNCS)
+    {
+        features.push_back(SyntacticFeatures::of(*func));
+    }
+
+    BOOST_CHECK(SyntacticFeatures().covers(features[0]));
+    BOOST_CHECK(features[1].has(Feature::Loop));
+    BOOST_CHECK(features[2].has(Feature::Loop));
+    BOOST_CHECK(features[3].has(Feature::Loop));
+    BOOST_CHECK(features[4].has(Feature::Push));
+    BOOST_CHECK(!features[4].has(Feature::Loop));
+    BOOST_CHECK(features[5].has(Feature::Length));
+    BOOST_CHECK(!features[5].has(Feature::Push));
+    BOOST_CHECK(features[6].has(Feature::InlineAssembly));
+
+    SyntacticFeatures const ALL{
+        Feature::Loop, Feature::Push, Feature::Length
+    };
+    BOOST_CHECK(features[7].covers(ALL));
+    BOOST_CHECK(!features[7].has(Feature::InlineAssembly));
+}
+
+// -------------------------------------------------------------------------- //
+
+BOOST_AUTO_TEST_SUITE_END();
+
+}
+}
+}
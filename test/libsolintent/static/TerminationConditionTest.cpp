@@ -0,0 +1,173 @@
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Tests for libsolintent/static/TerminationCondition.cpp.
+ */
+
+#include <libsolintent/static/TerminationCondition.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolintent/static/AnalysisEngine.h>
+#include <libsolintent/static/BoundChecker.h>
+#include <libsolintent/static/CondChecker.h>
+#include <libsolintent/static/StatementChecker.h>
+#include <test/CompilerFramework.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+namespace test
+{
+
+BOOST_FIXTURE_TEST_SUITE(TerminationConditionTest, CompilerFramework);
+
+// -------------------------------------------------------------------------- //
+
+BOOST_AUTO_TEST_CASE(canonical_forms)
+{
+    char const* sourceCode = R"(
+        contract A {
+            function f(uint i, uint n) public pure {
+                require(i < n);
+                require(n > i);
+                require(i <= n);
+                require(i == n);
+                require(n == i);
+                require(i < 100);
+                require(100 > i);
+                require(i <= 99);
+                require(100 < i);
+            }
+        }
+    )";
+
+    parse(sourceCode);
+    auto const* FUNC = fetch("A")->definedFunctions()[0];
+
+    AnalysisEngine<StatementChecker, BoundChecker, CondChecker> engine;
+    vector<CanonicalCondition> conds;
+    for (auto const& stmt : FUNC->body().statements())
+    {
+        // TODO: remove cast.
+        auto const& EXPR = dynamic_cast<solidity::ExpressionStatement const&>(
+            *stmt
+        ).expression();
+        auto const& CALL = dynamic_cast<solidity::FunctionCall const&>(EXPR);
+
+        auto const COND = CanonicalCondition::of(
+            *engine.checkBoolean(*CALL.arguments()[0])
+        );
+        BOOST_REQUIRE(COND.has_value());
+        conds.push_back(*COND);
+    }
+
+    // Orientation and strictness.
+    BOOST_CHECK_EQUAL(conds[0].key(), conds[1].key());
+    BOOST_CHECK_NE(conds[0].key(), conds[2].key());
+    BOOST_CHECK(conds[0].strict());
+    BOOST_CHECK(!conds[2].strict());
+    BOOST_CHECK_EQUAL(conds[0].lhs().symb(), "i");
+
+    // Operand ordering for equalities.
+    BOOST_CHECK_EQUAL(conds[3].key(), conds[4].key());
+
+    // Constants are moved to the offset.
+    BOOST_CHECK_EQUAL(conds[5].key(), conds[6].key());
+    BOOST_CHECK(conds[5].rhs() == nullptr);
+    BOOST_CHECK(conds[5].offset() == solidity::rational(100));
+    BOOST_CHECK(conds[8].cond() == Comparison::Condition::GreaterThan);
+
+    // Strictness is kept, though the bounds agree.
+    BOOST_CHECK_NE(conds[5].key(), conds[7].key());
+    BOOST_CHECK(TerminationCache::boundOf(conds[5]) == solidity::rational(100));
+    BOOST_CHECK(TerminationCache::boundOf(conds[7]) == solidity::rational(100));
+    BOOST_CHECK(!TerminationCache::boundOf(conds[8]).has_value());
+}
+
+BOOST_AUTO_TEST_CASE(memoizes_verdicts)
+{
+    TerminationCache cache;
+    BOOST_CHECK(!cache.find("shape").has_value());
+
+    cache.insert("shape", TerminationCache::Verdict{ true, nullopt });
+    cache.insert("shape", TerminationCache::Verdict{ false, nullopt });
+
+    auto const VERDICT = cache.find("shape");
+    BOOST_REQUIRE(VERDICT.has_value());
+    BOOST_CHECK(VERDICT->suspect);
+    BOOST_CHECK_EQUAL(cache.size(), 1);
+    BOOST_CHECK_EQUAL(cache.hits(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(variable_paths)
+{
+    char const* sourceCode = R"(
+        contract A {
+            uint i;
+            uint[] a;
+            function f() public {
+                i++;
+                i;
+                a.length;
+                { uint k = 1; k; }
+                { uint k = 2; k; }
+            }
+        }
+    )";
+
+    parse(sourceCode);
+    auto const* FUNC = fetch("A")->definedFunctions()[0];
+    auto const& STMTS = FUNC->body().statements();
+
+    // TODO: remove casts.
+    auto const exprOf = [](solidity::Statement const& _stmt) {
+        if (auto const* BLOCK = dynamic_cast<solidity::Block const*>(&_stmt))
+        {
+            return &dynamic_cast<solidity::ExpressionStatement const&>(
+                *BLOCK->statements()[1]
+            ).expression();
+        }
+        return &dynamic_cast<solidity::ExpressionStatement const&>(
+            _stmt
+        ).expression();
+    };
+
+    AnalysisEngine<StatementChecker, BoundChecker, CondChecker> engine;
+    vector<optional<string>> paths;
+    vector<string> symbs;
+    for (auto const& stmt : STMTS)
+    {
+        auto const SUMMARY = engine.checkNumeric(*exprOf(*stmt));
+        auto const* VAR = dynamic_cast<NumericVariable const*>(SUMMARY.get());
+        BOOST_REQUIRE(VAR);
+        paths.push_back(pathOf(*VAR));
+        symbs.push_back(VAR->symb());
+    }
+
+    // A stepped counter is the variable it steps.
+    BOOST_REQUIRE(paths[0].has_value());
+    BOOST_CHECK(paths[0] == paths[1]);
+
+    // Members extend the path of their base.
+    BOOST_REQUIRE(paths[2].has_value());
+    BOOST_CHECK(paths[2] != paths[1]);
+    BOOST_CHECK_EQUAL(paths[2]->substr(paths[2]->find('.')), ".length");
+
+    // Shadowed names share a symbol, but not a declaration.
+    BOOST_CHECK_EQUAL(symbs[3], symbs[4]);
+    BOOST_REQUIRE(paths[3].has_value());
+    BOOST_REQUIRE(paths[4].has_value());
+    BOOST_CHECK(paths[3] != paths[4]);
+}
+
+// -------------------------------------------------------------------------- //
+
+BOOST_AUTO_TEST_SUITE_END();
+
+}
+}
+}
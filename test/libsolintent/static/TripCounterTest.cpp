@@ -0,0 +1,151 @@
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Tests for libsolintent/static/TripCounter.cpp.
+ */
+
+#include <libsolintent/static/TripCounter.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolintent/static/AnalysisEngine.h>
+#include <libsolintent/static/BoundChecker.h>
+#include <libsolintent/static/CondChecker.h>
+#include <libsolintent/static/StatementChecker.h>
+#include <test/CompilerFramework.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+namespace test
+{
+
+BOOST_FIXTURE_TEST_SUITE(TripCounterTest, CompilerFramework);
+
+// -------------------------------------------------------------------------- //
+
+BOOST_AUTO_TEST_CASE(loop_trip_counts)
+{
+    char const* sourceCode = R"(
+        contract A {
+            uint[] a;
+            function f() public view {
+                for (uint i = 0; i < 10; i++) { }
+                for (uint i = 0; i <= 10; i++) { }
+                for (uint i = 3; 10 > i; i++) { }
+                for (uint i = 10; i > 0; i--) { }
+                for (uint i = 0; i != 10; i++) { }
+                for (uint i = 20; i < 10; i++) { }
+                for (uint i = 1; i < a.length; i++) { }
+                for (uint i = 0; i != 10; i--) { }
+                for (uint i; i < 10; i++) { }
+                for (uint i = 10; i >= 0; i--) { }
+                for (uint8 i = 0; i < 300; i++) { }
+            }
+        }
+    )";
+
+    parse(sourceCode);
+    auto const& STMTS = fetch("A")->definedFunctions()[0]->body().statements();
+
+    AnalysisEngine<StatementChecker, BoundChecker, CondChecker> engine;
+    vector<TripCount> trips;
+    for (auto const& stmt : STMTS)
+    {
+        auto const LOOP = dynamic_pointer_cast<LoopSummary const>(
+            engine.checkStatement(*stmt)
+        );
+        BOOST_REQUIRE(LOOP);
+        trips.push_back(LOOP->tripCount());
+    }
+
+    vector<int> const EXACT{ 10, 11, 7, 10, 10, 0 };
+    for (size_t i = 0; i < EXACT.size(); ++i)
+    {
+        BOOST_CHECK(trips[i].kind() == TripCount::Kind::Exact);
+        BOOST_CHECK(trips[i].count() == solidity::rational(EXACT[i]));
+    }
+
+    BOOST_CHECK(trips[6].kind() == TripCount::Kind::Bounded);
+    BOOST_CHECK_EQUAL(trips[6].limit()->symb(), "State#a#length");
+    BOOST_CHECK(trips[6].origin() == solidity::rational(1));
+    BOOST_CHECK(trips[6].step() == solidity::rational(1));
+
+    // Diverges, and lacks an initial value, respectively.
+    BOOST_CHECK(trips[7].kind() == TripCount::Kind::Unknown);
+    BOOST_CHECK(trips[8].kind() == TripCount::Kind::Unknown);
+
+    // Each condition only fails outside the range of the counter, which wraps.
+    BOOST_CHECK(trips[9].kind() == TripCount::Kind::Unknown);
+    BOOST_CHECK(trips[10].kind() == TripCount::Kind::Unknown);
+}
+
+BOOST_AUTO_TEST_CASE(loop_bodies)
+{
+    char const* sourceCode = R"(
+        contract A {
+            uint[] a;
+            uint[] b;
+            uint n;
+            function grow() internal { a.push(0); }
+            function peek() internal view returns (uint) { return a.length; }
+            function f() public {
+                for (uint i = 0; i < 10; i++) { i++; }
+                for (uint i = 0; i < 10; i++) { if (n > 0) { break; } }
+                for (uint i = 0; i < 10; i++) {
+                    for (uint j = 0; j < 2; j++) { break; }
+                }
+                for (uint i = 0; i < a.length; i++) { a.push(i); }
+                for (uint i = 0; i < a.length; i++) { b.push(i); }
+                for (uint i = 0; i < a.length; i++) { grow(); }
+                for (uint i = 0; i < a.length; i++) { peek(); }
+                for (uint i = 0; i < a.length; i++) { return; }
+            }
+        }
+    )";
+
+    parse(sourceCode);
+    auto const FUNCS = fetch("A")->definedFunctions();
+    auto const& STMTS = FUNCS[2]->body().statements();
+
+    AnalysisEngine<StatementChecker, BoundChecker, CondChecker> engine;
+    vector<TripCount> trips;
+    for (auto const& stmt : STMTS)
+    {
+        auto const LOOP = dynamic_pointer_cast<LoopSummary const>(
+            engine.checkStatement(*stmt)
+        );
+        BOOST_REQUIRE(LOOP);
+        trips.push_back(LOOP->tripCount());
+    }
+    BOOST_REQUIRE_EQUAL(trips.size(), 8);
+
+    // The body moves the counter.
+    BOOST_CHECK(trips[0].kind() == TripCount::Kind::Unknown);
+
+    // An early exit leaves an upper bound, unless it ends a nested loop.
+    BOOST_CHECK(trips[1].kind() == TripCount::Kind::AtMost);
+    BOOST_CHECK(trips[1].count() == solidity::rational(10));
+    BOOST_CHECK(trips[2].kind() == TripCount::Kind::Exact);
+    BOOST_CHECK(trips[2].count() == solidity::rational(10));
+
+    // The limit may grow directly, or through a call which modifies state.
+    BOOST_CHECK(trips[3].kind() == TripCount::Kind::Unknown);
+    BOOST_CHECK(trips[4].kind() == TripCount::Kind::Bounded);
+    BOOST_CHECK(trips[5].kind() == TripCount::Kind::Unknown);
+    BOOST_CHECK(trips[6].kind() == TripCount::Kind::Bounded);
+
+    BOOST_CHECK(trips[7].kind() == TripCount::Kind::AtMost);
+    BOOST_CHECK(trips[7].limit() != nullptr);
+}
+
+// -------------------------------------------------------------------------- //
+
+BOOST_AUTO_TEST_SUITE_END();
+
+}
+}
+}
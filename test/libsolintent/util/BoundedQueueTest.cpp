@@ -0,0 +1,99 @@
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Tests for libsolintent/util/BoundedQueue.h.
+ */
+
+#include <libsolintent/util/BoundedQueue.h>
+
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+namespace test
+{
+
+BOOST_AUTO_TEST_SUITE(BoundedQueueTest);
+
+// -------------------------------------------------------------------------- //
+
+BOOST_AUTO_TEST_CASE(fifo)
+{
+    BoundedQueue<unique_ptr<int>> queue(4);
+    BOOST_CHECK(queue.push(make_unique<int>(1)));
+    BOOST_CHECK(queue.push(make_unique<int>(2)));
+    queue.close();
+
+    // Closed queues reject new elements, but drain old elements.
+    BOOST_CHECK(!queue.push(make_unique<int>(3)));
+    BOOST_CHECK_EQUAL(*queue.pop().value(), 1);
+    BOOST_CHECK_EQUAL(*queue.pop().value(), 2);
+    BOOST_CHECK(!queue.pop().has_value());
+}
+
+BOOST_AUTO_TEST_CASE(zero_capacity)
+{
+    BoundedQueue<int> queue(0);
+    BOOST_CHECK_EQUAL(queue.capacity(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(backpressure)
+{
+    size_t const COUNT = 1000;
+    BoundedQueue<size_t> queue(2);
+
+    // The producer may run at most the capacity ahead of the consumer, plus the
+    // element in flight on each side.
+    atomic<size_t> pushed(0);
+    atomic<size_t> popped(0);
+    atomic<size_t> worst(0);
+
+    thread producer([&] {
+        for (size_t i = 0; i < COUNT; ++i)
+        {
+            queue.push(i);
+            ++pushed;
+        }
+        queue.close();
+    });
+
+    vector<size_t> received;
+    while (auto next = queue.pop())
+    {
+        size_t const AHEAD = pushed - popped;
+        if (AHEAD > worst) worst = AHEAD;
+        received.push_back(next.value());
+        ++popped;
+    }
+    producer.join();
+
+    BOOST_REQUIRE_EQUAL(received.size(), COUNT);
+    for (size_t i = 0; i < COUNT; ++i) BOOST_CHECK_EQUAL(received[i], i);
+    BOOST_CHECK_LE(worst.load(), queue.capacity() + 2);
+}
+
+BOOST_AUTO_TEST_CASE(close_wakes_consumers)
+{
+    BoundedQueue<int> queue(1);
+    bool drained = false;
+    thread consumer([&] { drained = !queue.pop().has_value(); });
+    queue.close();
+    consumer.join();
+    BOOST_CHECK(drained);
+}
+
+// -------------------------------------------------------------------------- //
+
+BOOST_AUTO_TEST_SUITE_END();
+
+}
+}
+}
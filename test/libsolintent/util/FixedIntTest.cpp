@@ -0,0 +1,93 @@
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Tests for libsolintent/util/FixedInt.cpp.
+ */
+
+#include <libsolintent/util/FixedInt.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+namespace test
+{
+
+BOOST_AUTO_TEST_SUITE(FixedIntTest)
+
+BOOST_AUTO_TEST_CASE(rational_round_trip)
+{
+    bigint const WORD = bigint(1) << 256;
+    vector<bigint> const VALUES = {
+        0, 1, -1, 42, -42, WORD - 1, -(WORD - 1), WORD / 2, -(WORD / 2)
+    };
+
+    for (auto const& val : VALUES)
+    {
+        auto const FIXED = FixedInt::fromRational(solidity::rational(val));
+        BOOST_CHECK(FIXED.has_value());
+        if (FIXED.has_value())
+        {
+            BOOST_CHECK_EQUAL(FIXED->toRational(), solidity::rational(val));
+            BOOST_CHECK_EQUAL(FIXED->isNegative(), val < 0);
+        }
+    }
+
+    BOOST_CHECK(!FixedInt::fromRational(solidity::rational(1, 2)));
+    BOOST_CHECK(!FixedInt::fromRational(solidity::rational(WORD)));
+    BOOST_CHECK(!FixedInt::fromRational(solidity::rational(-WORD)));
+}
+
+BOOST_AUTO_TEST_CASE(domains)
+{
+    bigint const WORD = bigint(1) << 256;
+    auto const UMAX = *FixedInt::fromRational(solidity::rational(WORD - 1));
+    auto const SMAX = *FixedInt::fromRational(solidity::rational(WORD / 2 - 1));
+    auto const SMIN = *FixedInt::fromRational(solidity::rational(-WORD / 2));
+
+    BOOST_CHECK(UMAX.fitsUnsigned());
+    BOOST_CHECK(!UMAX.fitsSigned());
+    BOOST_CHECK(SMAX.fitsUnsigned());
+    BOOST_CHECK(SMAX.fitsSigned());
+    BOOST_CHECK(!SMIN.fitsUnsigned());
+    BOOST_CHECK(SMIN.fitsSigned());
+    BOOST_CHECK(!SMIN.sub(FixedInt(1))->fitsSigned());
+
+    BOOST_CHECK_EQUAL(*FixedInt(-7).toInt64(), -7);
+    BOOST_CHECK(!UMAX.toInt64().has_value());
+}
+
+BOOST_AUTO_TEST_CASE(arithmetic)
+{
+    bigint const WORD = bigint(1) << 256;
+    auto const UMAX = *FixedInt::fromRational(solidity::rational(WORD - 1));
+
+    BOOST_CHECK(*FixedInt(5).add(FixedInt(-7)) == FixedInt(-2));
+    BOOST_CHECK(*FixedInt(5).sub(FixedInt(7)) == FixedInt(-2));
+    BOOST_CHECK(*FixedInt(-6).mul(FixedInt(7)) == FixedInt(-42));
+    BOOST_CHECK(*FixedInt(-7).div(FixedInt(2)) == FixedInt(-3));
+    BOOST_CHECK(*FixedInt(-7).mod(FixedInt(2)) == FixedInt(-1));
+    BOOST_CHECK(*UMAX.div(UMAX) == FixedInt(1));
+    BOOST_CHECK(*UMAX.sub(FixedInt(1))->add(FixedInt(1)) == UMAX);
+
+    BOOST_CHECK(!UMAX.add(FixedInt(1)).has_value());
+    BOOST_CHECK(!UMAX.negate().sub(FixedInt(1)).has_value());
+    BOOST_CHECK(!UMAX.mul(FixedInt(2)).has_value());
+    BOOST_CHECK(!FixedInt(1).div(FixedInt()).has_value());
+    BOOST_CHECK(!FixedInt(1).mod(FixedInt()).has_value());
+
+    BOOST_CHECK(FixedInt(-1) < FixedInt(0));
+    BOOST_CHECK(FixedInt(0) < UMAX);
+    BOOST_CHECK(UMAX.negate() < FixedInt(-1));
+    BOOST_CHECK_EQUAL(FixedInt(3).hash(), FixedInt(3).hash());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+}
@@ -0,0 +1,144 @@
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Tests for libsolintent/util/ImportGraph.cpp.
+ */
+
+#include <libsolintent/util/ImportGraph.h>
+
+#include <boost/test/unit_test.hpp>
+#include <map>
+#include <optional>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+namespace test
+{
+
+BOOST_AUTO_TEST_SUITE(ImportGraphTest);
+
+// -------------------------------------------------------------------------- //
+
+BOOST_AUTO_TEST_CASE(scan_imports)
+{
+    char const* sourceCode = R"(
+        pragma solidity >=0.0;
+        import "./A.sol";
+        import './B.sol' as B;
+        import * as C from "lib/C.sol";
+        import {D, E as F} from "../D.sol";
+        // import "commented.sol";
+        /* import "blocked.sol"; */
+        contract G {
+            string s = "import";
+            string t = "x.sol";
+            function reimport() public {}
+        }
+    )";
+
+    vector<string> const EXPECTED = {
+        "./A.sol", "./B.sol", "lib/C.sol", "../D.sol"
+    };
+    auto const ACTUAL = ImportGraph::scanImports(sourceCode);
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        ACTUAL.begin(), ACTUAL.end(), EXPECTED.begin(), EXPECTED.end()
+    );
+}
+
+BOOST_AUTO_TEST_CASE(resolve)
+{
+    ImportGraph graph({
+        { "", "lib/", "node_modules/lib/" },
+        { "", "lib/math/", "vendor/math/" },
+        { "a/", "lib/", "a_lib/" }
+    });
+
+    BOOST_CHECK_EQUAL(graph.resolve("./B.sol", "x/y/A.sol"), "x/y/B.sol");
+    BOOST_CHECK_EQUAL(graph.resolve("../B.sol", "x/y/A.sol"), "x/B.sol");
+    BOOST_CHECK_EQUAL(graph.resolve("x/B.sol", "x/y/A.sol"), "x/B.sol");
+
+    // Segments above the reference are kept.
+    BOOST_CHECK_EQUAL(graph.resolve("../B.sol", "A.sol"), "../B.sol");
+    BOOST_CHECK_EQUAL(graph.resolve("../../B.sol", "x/A.sol"), "../B.sol");
+    BOOST_CHECK_EQUAL(graph.resolve("./../../B.sol", "A.sol"), "../../B.sol");
+
+    // Longest prefix, unless a longer context applies.
+    BOOST_CHECK_EQUAL(graph.resolve("lib/B.sol", "A.sol"), "node_modules/lib/B.sol");
+    BOOST_CHECK_EQUAL(graph.resolve("lib/math/B.sol", "A.sol"), "vendor/math/B.sol");
+    BOOST_CHECK_EQUAL(graph.resolve("lib/math/B.sol", "a/A.sol"), "a_lib/math/B.sol");
+}
+
+BOOST_AUTO_TEST_CASE(components)
+{
+    ImportGraph graph;
+    graph.addSource("d.sol", "import './c.sol';");
+    graph.addSource("c.sol", "contract C {}");
+    graph.addSource("a.sol", "import './e.sol'; import 'missing.sol';");
+    graph.addSource("b.sol", "contract B {}");
+    graph.addSource("e.sol", "import './b.sol';");
+
+    vector<vector<string>> const EXPECTED = {
+        { "a.sol", "b.sol", "e.sol" }, { "c.sol", "d.sol" }
+    };
+    auto const ACTUAL = graph.components();
+    BOOST_CHECK_EQUAL(ACTUAL.size(), EXPECTED.size());
+    for (size_t i = 0; i < min(ACTUAL.size(), EXPECTED.size()); ++i)
+    {
+        BOOST_CHECK_EQUAL_COLLECTIONS(
+            ACTUAL[i].begin(), ACTUAL[i].end(),
+            EXPECTED[i].begin(), EXPECTED[i].end()
+        );
+    }
+}
+
+BOOST_AUTO_TEST_CASE(external_imports)
+{
+    // Only the sources outside of the set are read.
+    map<string, string> const EXTERNAL = {
+        { "lib/x.sol", "contract X {}" },
+        { "lib/y.sol", "import './x.sol';" },
+        { "lib/z.sol", "contract Z {}" }
+    };
+    map<string, size_t> reads;
+    ImportGraph graph({}, [&](string const& _name) -> optional<string> {
+        ++reads[_name];
+        auto const ITR = EXTERNAL.find(_name);
+        if (ITR == EXTERNAL.end()) return nullopt;
+        return ITR->second;
+    });
+    graph.addSource("a.sol", "import 'lib/x.sol';");
+    graph.addSource("b.sol", "import 'lib/y.sol'; import 'missing.sol';");
+    graph.addSource("c.sol", "import 'lib/z.sol'; import 'lib/y.sol';");
+    graph.addSource("d.sol", "import 'lib/z.sol'; import 'missing.sol';");
+    graph.addSource("e.sol", "contract E {}");
+
+    // Inputs which share a dependency, even indirectly, are kept together.
+    vector<vector<string>> const EXPECTED = {
+        { "a.sol", "b.sol", "c.sol", "d.sol" }, { "e.sol" }
+    };
+    auto const ACTUAL = graph.components();
+    BOOST_CHECK_EQUAL(ACTUAL.size(), EXPECTED.size());
+    for (size_t i = 0; i < min(ACTUAL.size(), EXPECTED.size()); ++i)
+    {
+        BOOST_CHECK_EQUAL_COLLECTIONS(
+            ACTUAL[i].begin(), ACTUAL[i].end(),
+            EXPECTED[i].begin(), EXPECTED[i].end()
+        );
+    }
+
+    // Each external source is read once, even if it is missing.
+    BOOST_CHECK_EQUAL(reads.size(), 4);
+    for (auto const& entry : reads) BOOST_CHECK_EQUAL(entry.second, 1);
+}
+
+// -------------------------------------------------------------------------- //
+
+BOOST_AUTO_TEST_SUITE_END();
+
+}
+}
+}
@@ -0,0 +1,99 @@
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Tests for libsolintent/util/ImportPaths.cpp.
+ */
+
+#include <libsolintent/util/ImportPaths.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+
+using namespace std;
+namespace fs = boost::filesystem;
+
+namespace dev
+{
+namespace solintent
+{
+namespace test
+{
+
+BOOST_AUTO_TEST_SUITE(ImportPathsTest);
+
+// -------------------------------------------------------------------------- //
+
+BOOST_AUTO_TEST_CASE(trie_prefixes)
+{
+    PathTrie trie;
+    BOOST_CHECK(trie.empty());
+    BOOST_CHECK(!trie.containsPrefixOf("/a/b/c.sol"));
+
+    trie.insert("/a/b");
+    trie.insert("/x/y/./");
+    BOOST_CHECK(!trie.empty());
+
+    BOOST_CHECK(trie.containsPrefixOf("/a/b/c.sol"));
+    BOOST_CHECK(trie.containsPrefixOf("/a/b/c/d.sol"));
+    BOOST_CHECK(trie.containsPrefixOf("/x/y/z.sol"));
+
+    // Prefixes are matched by component, and never by character.
+    BOOST_CHECK(!trie.containsPrefixOf("/a/bc.sol"));
+    BOOST_CHECK(!trie.containsPrefixOf("/a"));
+    BOOST_CHECK(!trie.containsPrefixOf("/a/c/b/d.sol"));
+    BOOST_CHECK(!trie.containsPrefixOf("/x/d.sol"));
+
+    // Nested directories are redundant.
+    trie.insert("/a/b/c");
+    BOOST_CHECK(trie.containsPrefixOf("/a/b/e.sol"));
+}
+
+BOOST_AUTO_TEST_CASE(trie_empty_dir)
+{
+    // An empty directory is a prefix of every path.
+    PathTrie trie;
+    trie.insert("");
+    BOOST_CHECK(trie.containsPrefixOf("/a/b.sol"));
+    BOOST_CHECK(trie.containsPrefixOf("b.sol"));
+}
+
+BOOST_AUTO_TEST_CASE(canonical_cache)
+{
+    auto const ROOT = fs::canonical(fs::temp_directory_path())
+                    / fs::unique_path("solintent-%%%%-%%%%");
+    fs::create_directories(ROOT / "real" / "sub");
+    ofstream((ROOT / "real" / "sub" / "a.sol").string()) << "";
+    fs::create_directory_symlink(ROOT / "real", ROOT / "link");
+    fs::create_symlink(ROOT / "real" / "sub" / "a.sol", ROOT / "alias.sol");
+
+    vector<fs::path> const PATHS = {
+        ROOT / "real" / "sub" / "a.sol",
+        ROOT / "link" / "sub" / "a.sol",
+        ROOT / "link" / "sub" / ".." / "sub" / "a.sol",
+        ROOT / "alias.sol",
+        ROOT / "link" / "missing" / "b.sol",
+        ROOT / "link" / "sub" / ""
+    };
+
+    CanonicalPathCache cache;
+    for (auto const& path : PATHS)
+    {
+        auto const EXPECTED = fs::weakly_canonical(path);
+        BOOST_CHECK_EQUAL(cache.canonical(path), EXPECTED);
+        BOOST_CHECK_EQUAL(&cache.canonical(path), &cache.canonical(path));
+    }
+
+    cache.clear();
+    BOOST_CHECK_EQUAL(cache.size(), 0);
+
+    fs::remove_all(ROOT);
+}
+
+// -------------------------------------------------------------------------- //
+
+BOOST_AUTO_TEST_SUITE_END();
+
+}
+}
+}
@@ -0,0 +1,182 @@
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Tests for libsolintent/util/ResultsLog.cpp.
+ */
+
+#include <libsolintent/util/ResultsLog.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+namespace test
+{
+
+BOOST_AUTO_TEST_SUITE(ResultsLogTest);
+
+// -------------------------------------------------------------------------- //
+
+namespace
+{
+
+/**
+ * Reserves a fresh path, and then removes the file on exit.
+ */
+class TempPath
+{
+public:
+    TempPath()
+        : m_path(
+            boost::filesystem::temp_directory_path()
+            / boost::filesystem::unique_path("solintent-%%%%-%%%%.jsonl")
+        )
+    {
+    }
+
+    ~TempPath()
+    {
+        boost::filesystem::remove(m_path);
+    }
+
+    string path() const { return m_path.string(); }
+
+private:
+    boost::filesystem::path const m_path;
+};
+
+/**
+ * Returns a finding as produced by JsonLinesReporter.
+ */
+Json::Value makeFinding(string const& _rule, Json::Value const& _bound)
+{
+    Json::Value finding(Json::objectValue);
+    finding["rule"] = _rule;
+    finding["source"] = "a.sol";
+    finding["line"] = 3;
+    finding["column"] = 5;
+    finding["bound"] = _bound;
+    return finding;
+}
+
+}
+
+// -------------------------------------------------------------------------- //
+
+BOOST_AUTO_TEST_CASE(resume)
+{
+    TempPath path;
+
+    Json::Value findings(Json::arrayValue);
+    findings.append(makeFinding("Gas", 10));
+    findings.append(makeFinding("Gas", Json::nullValue));
+
+    {
+        ResultsLog log(path.path());
+        BOOST_CHECK(log.entries().empty());
+        log.append({ "p1", "d1", true, findings });
+        log.append({ "p2", "d2", false, Json::Value(Json::arrayValue) });
+    }
+
+    ResultsLog log(path.path());
+    BOOST_CHECK_EQUAL(log.entries().size(), 2);
+    BOOST_CHECK(log.isCurrent("p1", "d1"));
+    BOOST_CHECK(!log.isCurrent("p1", "d0"));
+    BOOST_CHECK(!log.isCurrent("p2", "d2"));
+    BOOST_CHECK(!log.isCurrent("p3", "d3"));
+
+    BOOST_REQUIRE(log.find("p1") != nullptr);
+    BOOST_CHECK_EQUAL(log.find("p1")->findings.size(), 2);
+
+    // Later records supersede earlier records.
+    log.append({ "p2", "d2", true, Json::Value(Json::arrayValue) });
+    BOOST_CHECK(log.isCurrent("p2", "d2"));
+}
+
+BOOST_AUTO_TEST_CASE(torn_tail)
+{
+    TempPath path;
+    {
+        ResultsLog log(path.path());
+        log.append({ "p1", "d1", true, Json::Value(Json::arrayValue) });
+    }
+    {
+        ofstream out(path.path(), ios::binary | ios::app);
+        out << "{\"project\":\"p2\",\"dig";
+    }
+
+    {
+        ResultsLog log(path.path());
+        BOOST_CHECK_EQUAL(log.entries().size(), 1);
+        log.append({ "p3", "d3", true, Json::Value(Json::arrayValue) });
+    }
+
+    // The torn record is cut, so the next record is intact.
+    ResultsLog log(path.path());
+    BOOST_CHECK_EQUAL(log.entries().size(), 2);
+    BOOST_CHECK(log.isCurrent("p1", "d1"));
+    BOOST_CHECK(log.isCurrent("p3", "d3"));
+}
+
+BOOST_AUTO_TEST_CASE(proposed_bounds)
+{
+    TempPath path;
+    ResultsLog log(path.path());
+
+    Json::Value lhs(Json::arrayValue);
+    lhs.append(makeFinding("Gas", 10));
+    lhs.append(makeFinding("Gas", Json::nullValue));
+    lhs.append(makeFinding("Other", 7));
+    log.append({ "b", "d", true, lhs });
+
+    Json::Value rhs(Json::arrayValue);
+    rhs.append(makeFinding("Gas", 4));
+    log.append({ "a", "d", true, rhs });
+
+    auto const BOUNDS = log.proposedBounds();
+    BOOST_REQUIRE_EQUAL(BOUNDS.size(), 2);
+
+    auto const& GAS = BOUNDS.at("Gas");
+    BOOST_REQUIRE_EQUAL(GAS.size(), 2);
+    BOOST_CHECK_EQUAL(GAS[0].project, "a");
+    BOOST_CHECK_EQUAL(GAS[0].bound, 4);
+    BOOST_CHECK_EQUAL(GAS[1].project, "b");
+    BOOST_CHECK_EQUAL(GAS[1].bound, 10);
+    BOOST_CHECK_EQUAL(GAS[1].source, "a.sol");
+    BOOST_CHECK_EQUAL(GAS[1].line, 3);
+    BOOST_CHECK_EQUAL(GAS[1].column, 5);
+
+    BOOST_CHECK_EQUAL(BOUNDS.at("Other").size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(digest)
+{
+    map<string, string_view> const BASE{ { "a.sol", "abc" }, { "b.sol", "d" } };
+    map<string, string_view> const SHIFTED{ { "a.sol", "ab" }, { "b.sol", "cd" } };
+    map<string, string_view> const RENAMED{ { "a.sol", "abc" }, { "c.sol", "d" } };
+
+    BOOST_CHECK_EQUAL(ResultsLog::digest(BASE), ResultsLog::digest(BASE));
+    BOOST_CHECK_EQUAL(ResultsLog::digest(BASE).size(), 16);
+    BOOST_CHECK_NE(ResultsLog::digest(BASE), ResultsLog::digest(SHIFTED));
+    BOOST_CHECK_NE(ResultsLog::digest(BASE), ResultsLog::digest(RENAMED));
+
+    // The options are part of the inputs.
+    auto const OPTIMIZED = ResultsLog::digest(BASE, "optimize");
+    BOOST_CHECK_EQUAL(OPTIMIZED, ResultsLog::digest(BASE, "optimize"));
+    BOOST_CHECK_NE(OPTIMIZED, ResultsLog::digest(BASE));
+    BOOST_CHECK_NE(OPTIMIZED, ResultsLog::digest(BASE, "optimize-runs=1"));
+}
+
+// -------------------------------------------------------------------------- //
+
+BOOST_AUTO_TEST_SUITE_END();
+
+}
+}
+}
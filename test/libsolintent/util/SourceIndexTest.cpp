@@ -0,0 +1,102 @@
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Tests for libsolintent/util/SourceIndex.cpp.
+ */
+
+#include <libsolintent/util/SourceIndex.h>
+
+#include <liblangutil/CharStream.h>
+#include <libsolidity/ast/AST.h>
+#include <test/CompilerFramework.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+namespace test
+{
+
+BOOST_FIXTURE_TEST_SUITE(SourceIndexTest, CompilerFramework);
+
+BOOST_AUTO_TEST_CASE(line_index)
+{
+    string const SRC = "ab\ncd\r\n\nxyz";
+    LineIndex index(SRC);
+
+    BOOST_CHECK_EQUAL(index.lineCount(), 4);
+    BOOST_CHECK_EQUAL(index.line(1), "ab");
+    BOOST_CHECK_EQUAL(index.line(2), "cd");
+    BOOST_CHECK_EQUAL(index.line(3), "");
+    BOOST_CHECK_EQUAL(index.line(4), "xyz");
+    BOOST_CHECK(index.line(5).empty());
+
+    vector<pair<size_t, size_t>> const EXPECTED = {
+        {1, 1}, {1, 2}, {1, 3}, {2, 1}, {2, 2}, {2, 3}, {2, 4}, {3, 1}, {4, 1}
+    };
+    for (size_t i = 0; i < EXPECTED.size(); ++i)
+    {
+        auto const POS = index.resolve(i);
+        BOOST_CHECK_EQUAL(POS.line, EXPECTED[i].first);
+        BOOST_CHECK_EQUAL(POS.column, EXPECTED[i].second);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(source_index)
+{
+    char const* sourceCode = R"(
+contract A {
+    function f() public view {
+        5 + 2;
+    }
+}
+    )";
+
+    auto const* AST = parse(sourceCode);
+
+    auto const& CONTRACT = (*fetch("A"));
+    auto const& FUNCTION = (*CONTRACT.definedFunctions()[0]);
+
+    // The harness prepends a pragma line to each source.
+    SourceIndex index;
+    auto const POS = index.resolve(FUNCTION.location());
+    BOOST_CHECK_EQUAL(POS.line, 4);
+    BOOST_CHECK_EQUAL(POS.column, 5);
+
+    // Each source is indexed once.
+    BOOST_CHECK_EQUAL(index.index(CONTRACT.location()), index.index(FUNCTION.location()));
+    BOOST_CHECK_EQUAL(index.index(langutil::SourceLocation()), nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(missing_source)
+{
+    // An imported AST keeps its offsets, but not its source text.
+    auto const EMPTY = make_shared<langutil::CharStream>("", "A.sol");
+    auto const SHORT = make_shared<langutil::CharStream>("a\nb", "B.sol");
+
+    SourceIndex index;
+    auto const POS_1 = index.resolve(langutil::SourceLocation(10, 20, EMPTY));
+    BOOST_CHECK_EQUAL(POS_1.line, 0);
+    BOOST_CHECK_EQUAL(POS_1.column, 0);
+
+    auto const POS_2 = index.resolve(langutil::SourceLocation(10, 20, SHORT));
+    BOOST_CHECK_EQUAL(POS_2.line, 0);
+    BOOST_CHECK_EQUAL(POS_2.column, 0);
+
+    auto const POS_3 = index.resolve(langutil::SourceLocation(2, 20, SHORT));
+    BOOST_CHECK_EQUAL(POS_3.line, 2);
+    BOOST_CHECK_EQUAL(POS_3.column, 1);
+
+    auto const POS_4 = index.resolveEnd(langutil::SourceLocation(2, 20, SHORT));
+    BOOST_CHECK_EQUAL(POS_4.line, 0);
+    BOOST_CHECK_EQUAL(POS_4.column, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
+
+}
+}
+}
@@ -9,6 +9,7 @@
 #include <libsolidity/ast/AST.h>
 #include <test/CompilerFramework.h>
 #include <boost/test/unit_test.hpp>
+#include <sstream>
 
 using namespace std;
 
@@ -50,6 +51,35 @@ BOOST_AUTO_TEST_CASE(convert_to_str)
     BOOST_CHECK_EQUAL(ACT_3, EXP_3);
 }
 
+BOOST_AUTO_TEST_CASE(convert_without_copies)
+{
+    char const* sourceCode = R"(
+        contract A {
+            function f() public view {
+                5 + 2;
+            }
+        }
+    )";
+
+    auto const* AST = parse(sourceCode);
+
+    auto const& CONTRACT = (*fetch("A"));
+    auto const& FUNCTION = (*CONTRACT.definedFunctions()[0]);
+
+    // The view aliases the source text directly.
+    auto const VIEW = srclocToView(FUNCTION.location());
+    auto const& SRC = FUNCTION.location().source->source();
+    BOOST_CHECK(VIEW.data() == SRC.data() + FUNCTION.location().start);
+    BOOST_CHECK_EQUAL(VIEW.substr(0, 10), "function f");
+
+    // The streamed snippet matches the collapsed string.
+    ostringstream out;
+    writeSrcloc(out, FUNCTION.location());
+    BOOST_CHECK_EQUAL(out.str(), srclocToStr(FUNCTION.location()));
+
+    BOOST_CHECK(srclocToView(langutil::SourceLocation()).empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END();
 
 }
@@ -0,0 +1,142 @@
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Tests for libsolintent/util/SourceStore.cpp.
+ */
+
+#include <libsolintent/util/SourceStore.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+namespace test
+{
+
+BOOST_AUTO_TEST_SUITE(SourceStoreTest);
+
+// -------------------------------------------------------------------------- //
+
+namespace
+{
+
+/**
+ * Writes _contents to a fresh file, and then removes the file on exit.
+ */
+class TempFile
+{
+public:
+    TempFile()
+        : m_path(
+            boost::filesystem::temp_directory_path()
+            / boost::filesystem::unique_path("solintent-%%%%-%%%%.sol")
+        )
+    {
+    }
+
+    ~TempFile()
+    {
+        boost::filesystem::remove(m_path);
+    }
+
+    void write(string const& _contents)
+    {
+        ofstream out(m_path.string(), ios::binary | ios::trunc);
+        out << _contents;
+    }
+
+    string path() const { return m_path.string(); }
+
+private:
+    boost::filesystem::path const m_path;
+};
+
+}
+
+// -------------------------------------------------------------------------- //
+
+BOOST_AUTO_TEST_CASE(load)
+{
+    TempFile file;
+    file.write("contract A {}");
+
+    SourceStore store;
+    auto const VIEW = store.load(file.path());
+    BOOST_CHECK_EQUAL(VIEW, "contract A {}");
+    BOOST_CHECK_EQUAL(store.size(), 1);
+
+    // Unmodified files are not reloaded.
+    auto const AGAIN = store.load(file.path());
+    BOOST_CHECK(AGAIN.data() == VIEW.data());
+    BOOST_CHECK_EQUAL(store.size(), 1);
+
+    // Modified files are reloaded.
+    file.write("contract B { uint x; }");
+    BOOST_CHECK_EQUAL(store.load(file.path()), "contract B { uint x; }");
+
+    store.release(file.path());
+    BOOST_CHECK_EQUAL(store.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(same_size_edit)
+{
+    TempFile file;
+    file.write("contract A {}");
+
+    SourceStore store;
+    auto const VIEW = store.load(file.path());
+
+    // The edit lands well within the same second, but past the granularity of
+    // the file system clock.
+    this_thread::sleep_for(chrono::milliseconds(20));
+    file.write("contract B {}");
+    BOOST_CHECK_EQUAL(store.load(file.path()), "contract B {}");
+    BOOST_CHECK_EQUAL(store.size(), 1);
+
+    // The earlier view remains mapped until release.
+    BOOST_CHECK_EQUAL(VIEW.size(), 13);
+    BOOST_CHECK_EQUAL(VIEW.substr(0, 9), "contract ");
+}
+
+BOOST_AUTO_TEST_CASE(empty_file)
+{
+    TempFile file;
+    file.write("");
+
+    SourceStore store;
+    BOOST_CHECK(store.load(file.path()).empty());
+}
+
+BOOST_AUTO_TEST_CASE(adopt)
+{
+    SourceStore store;
+    BOOST_CHECK_EQUAL(store.adopt("<stdin>", "contract A {}"), "contract A {}");
+    BOOST_CHECK_EQUAL(store.adopt("<stdin>", "contract B {}"), "contract B {}");
+    BOOST_CHECK_EQUAL(store.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(missing_file)
+{
+    TempFile file;
+
+    SourceStore store;
+    BOOST_CHECK_THROW(store.load(file.path()), runtime_error);
+    BOOST_CHECK_EQUAL(store.size(), 0);
+}
+
+// -------------------------------------------------------------------------- //
+
+BOOST_AUTO_TEST_SUITE_END();
+
+}
+}
+}
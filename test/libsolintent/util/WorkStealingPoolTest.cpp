@@ -0,0 +1,110 @@
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Tests for libsolintent/util/WorkStealingPool.cpp.
+ */
+
+#include <libsolintent/util/WorkStealingPool.h>
+
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <chrono>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+namespace test
+{
+
+BOOST_AUTO_TEST_SUITE(WorkStealingPoolTest);
+
+// -------------------------------------------------------------------------- //
+
+BOOST_AUTO_TEST_CASE(each_job_once)
+{
+    WorkStealingPool pool(4);
+    BOOST_CHECK_EQUAL(pool.size(), 4);
+
+    // The pool is reused across calls, with varying counts.
+    for (size_t const COUNT : { 0, 1, 3, 1000 })
+    {
+        vector<atomic<size_t>> runs(COUNT);
+        for (auto & run : runs) run = 0;
+
+        atomic<bool> valid(true);
+        pool.parallelFor(COUNT, [&](size_t _worker, size_t _i) {
+            if (_worker >= 4) valid = false;
+            ++runs[_i];
+        });
+
+        BOOST_CHECK(valid);
+        for (auto const& run : runs) BOOST_CHECK_EQUAL(run.load(), 1);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(inline_pool)
+{
+    // A pool of one runs every job on the calling thread.
+    WorkStealingPool pool(1);
+    auto const CALLER = this_thread::get_id();
+
+    bool inlined = true;
+    pool.parallelFor(10, [&](size_t _worker, size_t) {
+        inlined = inlined && _worker == 0 && this_thread::get_id() == CALLER;
+    });
+    BOOST_CHECK(inlined);
+}
+
+BOOST_AUTO_TEST_CASE(stealing)
+{
+    // Worker 0 owns the first block, and is stalled by its first job. The rest
+    // of its block must be stolen.
+    WorkStealingPool pool(2);
+
+    mutex guard;
+    set<size_t> thieves;
+    pool.parallelFor(8, [&](size_t _worker, size_t _i) {
+        if (_i == 0) this_thread::sleep_for(chrono::milliseconds(200));
+        if (_i > 0 && _i < 4)
+        {
+            lock_guard<mutex> const LOCK(guard);
+            thieves.insert(_worker);
+        }
+    });
+    BOOST_CHECK(thieves.count(1) == 1);
+}
+
+BOOST_AUTO_TEST_CASE(exceptions)
+{
+    WorkStealingPool pool(3);
+
+    atomic<size_t> runs(0);
+    BOOST_CHECK_THROW(
+        pool.parallelFor(100, [&](size_t, size_t _i) {
+            ++runs;
+            if (_i == 50) throw runtime_error("failure");
+        }),
+        runtime_error
+    );
+    BOOST_CHECK_EQUAL(runs.load(), 100);
+
+    // The pool remains usable.
+    runs = 0;
+    pool.parallelFor(10, [&](size_t, size_t) { ++runs; });
+    BOOST_CHECK_EQUAL(runs.load(), 10);
+}
+
+// -------------------------------------------------------------------------- //
+
+BOOST_AUTO_TEST_SUITE_END();
+
+}
+}
+}
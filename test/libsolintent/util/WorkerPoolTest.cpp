@@ -0,0 +1,157 @@
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Tests for libsolintent/util/WorkerPool.cpp.
+ */
+
+#include <libsolintent/util/WorkerPool.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <csignal>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+namespace test
+{
+
+BOOST_AUTO_TEST_SUITE(WorkerPoolTest);
+
+// -------------------------------------------------------------------------- //
+
+namespace
+{
+
+/**
+ * Records each call to the sink.
+ */
+struct Log
+{
+    vector<size_t> order;
+    vector<optional<string>> results;
+
+    WorkerPool::Sink sink()
+    {
+        return [this](size_t _i, optional<string> const& _result) {
+            order.push_back(_i);
+            results.push_back(_result);
+        };
+    }
+};
+
+}
+
+// -------------------------------------------------------------------------- //
+
+BOOST_AUTO_TEST_CASE(in_order)
+{
+    Log log;
+    WorkerPool pool(3);
+    pool.run(50, [](size_t _i) { return string(_i, 'x'); }, log.sink());
+
+    BOOST_REQUIRE_EQUAL(log.order.size(), 50);
+    for (size_t i = 0; i < 50; ++i)
+    {
+        BOOST_CHECK_EQUAL(log.order[i], i);
+        BOOST_REQUIRE(log.results[i].has_value());
+        BOOST_CHECK_EQUAL(log.results[i].value(), string(i, 'x'));
+    }
+    BOOST_CHECK_EQUAL(pool.restarts(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(no_tasks)
+{
+    Log log;
+    WorkerPool pool(4);
+    pool.run(0, [](size_t) { return string(); }, log.sink());
+    BOOST_CHECK(log.order.empty());
+}
+
+BOOST_AUTO_TEST_CASE(large_payloads)
+{
+    // Payloads larger than a pipe buffer arrive across several reads.
+    Log log;
+    WorkerPool pool(2);
+    pool.run(4, [](size_t _i) { return string(1 << 20, 'a' + _i); }, log.sink());
+
+    BOOST_REQUIRE_EQUAL(log.results.size(), 4);
+    for (size_t i = 0; i < 4; ++i)
+    {
+        BOOST_CHECK(log.results[i] == string(1 << 20, 'a' + i));
+    }
+}
+
+#ifndef _WIN32
+
+BOOST_AUTO_TEST_CASE(transient_crash)
+{
+    namespace fs = boost::filesystem;
+    auto const MARKER =
+        fs::temp_directory_path() / fs::unique_path("solintent-%%%%-%%%%");
+
+    // The first attempt at task 5 dies. The marker outlives the worker.
+    Log log;
+    WorkerPool pool(2);
+    pool.run(10, [&MARKER](size_t _i) {
+        if (_i == 5 && !fs::exists(MARKER))
+        {
+            ofstream(MARKER.string()) << "crashed";
+            raise(SIGKILL);
+        }
+        return to_string(_i);
+    }, log.sink());
+    fs::remove(MARKER);
+
+    BOOST_REQUIRE_EQUAL(log.order.size(), 10);
+    for (size_t i = 0; i < 10; ++i)
+    {
+        BOOST_CHECK_EQUAL(log.order[i], i);
+        BOOST_CHECK(log.results[i] == to_string(i));
+    }
+    BOOST_CHECK_EQUAL(pool.restarts(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(persistent_failure)
+{
+    Log log;
+    WorkerPool pool(2, 1);
+    pool.run(10, [](size_t _i) {
+        if (_i == 3) raise(SIGKILL);
+        if (_i == 7) throw runtime_error("failure");
+        return to_string(_i);
+    }, log.sink());
+
+    BOOST_REQUIRE_EQUAL(log.order.size(), 10);
+    for (size_t i = 0; i < 10; ++i)
+    {
+        BOOST_CHECK_EQUAL(log.order[i], i);
+        if (i == 3 || i == 7)
+        {
+            BOOST_CHECK(!log.results[i].has_value());
+        }
+        else
+        {
+            BOOST_CHECK(log.results[i] == to_string(i));
+        }
+    }
+
+    // Each failing task is attempted twice.
+    BOOST_CHECK_EQUAL(pool.restarts(), 4);
+}
+
+#endif
+
+// -------------------------------------------------------------------------- //
+
+BOOST_AUTO_TEST_SUITE_END();
+
+}
+}
+}
@@ -0,0 +1,192 @@
+/**
+ * @author Arthur Scott Wesley <aswesley@uwaterloo.ca>
+ * @date 2019
+ * Tests for solintent/report/Reporter.h.
+ */
+
+#include <solintent/report/Reporter.h>
+
+#include <libsolintent/util/SourceLocation.h>
+#include <libsolidity/ast/AST.h>
+#include <test/CompilerFramework.h>
+#include <boost/test/unit_test.hpp>
+#include <sstream>
+
+using namespace std;
+
+namespace dev
+{
+namespace solintent
+{
+namespace test
+{
+
+BOOST_FIXTURE_TEST_SUITE(ReporterTest, CompilerFramework);
+
+// -------------------------------------------------------------------------- //
+
+namespace
+{
+
+char const* const SOURCE_CODE = R"(
+contract A {
+    function f() public pure {
+        string memory s = "\"";
+        s;
+    }
+}
+)";
+
+Reporter::Rule const RULE{ "Rule", "Some \"rule\"." };
+
+}
+
+// -------------------------------------------------------------------------- //
+
+BOOST_AUTO_TEST_CASE(text)
+{
+    auto const* AST = parse(SOURCE_CODE);
+    auto const* CONTRACT = fetch("A");
+    auto const& BODY = CONTRACT->definedFunctions()[0]->body();
+    auto const* STMT = BODY.statements()[1].get();
+
+    ostringstream out;
+    SourceIndex index;
+    TextReporter reporter(out, index);
+
+    reporter.begin(RULE);
+    reporter.report({ { CONTRACT, STMT }, nullopt });
+    reporter.report({ { CONTRACT, STMT }, 5 });
+
+    // Nothing is written until the contract ends.
+    BOOST_CHECK(out.str().empty());
+    reporter.endContract();
+
+    auto const PREFIX = "[" + to_string(STMT->location().start)
+                      + ":" + to_string(STMT->location().end) + "] 6:9 "
+                      + srclocToStr(STMT->location()) + "\n";
+    BOOST_CHECK_EQUAL(
+        out.str(), PREFIX + PREFIX + "    Proposed array bound: 5\n"
+    );
+
+    reporter.end();
+    BOOST_CHECK(out.str().find("2 suspects detected.\n") != string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(json_lines)
+{
+    auto const* AST = parse(SOURCE_CODE);
+    auto const* CONTRACT = fetch("A");
+    auto const& BODY = CONTRACT->definedFunctions()[0]->body();
+    auto const* STMT = BODY.statements()[0].get();
+
+    ostringstream out;
+    SourceIndex index;
+    JsonLinesReporter reporter(out, index);
+
+    reporter.begin(RULE);
+    reporter.report({ { CONTRACT, STMT }, 10 });
+    reporter.endContract();
+    reporter.end();
+
+    auto const& LOC = STMT->location();
+    string const EXPECTED = "{\"rule\":\"Rule\",\"contract\":\"A\",\"source\":\"\""
+                          ",\"start\":" + to_string(LOC.start)
+                          + ",\"end\":" + to_string(LOC.end)
+                          + ",\"line\":5,\"column\":9"
+                          + ",\"snippet\":\"string memory s = \\\"\\\\\\\"\\\"\""
+                          + ",\"bound\":10}\n";
+    BOOST_CHECK_EQUAL(out.str(), EXPECTED);
+}
+
+BOOST_AUTO_TEST_CASE(sarif)
+{
+    auto const* AST = parse(SOURCE_CODE);
+    auto const* CONTRACT = fetch("A");
+    auto const& BODY = CONTRACT->definedFunctions()[0]->body();
+
+    ostringstream out;
+    SourceIndex index;
+    SarifReporter reporter(out, index);
+
+    reporter.begin(RULE);
+    reporter.report({ { CONTRACT, BODY.statements()[0].get() }, nullopt });
+    reporter.report({ { CONTRACT, BODY.statements()[1].get() }, 3 });
+    reporter.endContract();
+    reporter.end();
+
+    auto const LOG = out.str();
+    BOOST_CHECK_EQUAL(LOG.find("{\"version\":\"2.1.0\""), 0);
+    BOOST_CHECK(LOG.find("\"text\":\"Some \\\"rule\\\".\"") != string::npos);
+    BOOST_CHECK(LOG.find("\"startLine\":5,\"startColumn\":9") != string::npos);
+    BOOST_CHECK(LOG.find("\"startLine\":6,\"startColumn\":9") != string::npos);
+    BOOST_CHECK(LOG.find("\"endLine\":6,") != string::npos);
+    BOOST_CHECK(LOG.find("Proposed array bound: 3") != string::npos);
+    BOOST_CHECK(LOG.find("}]},{\"ruleId\"") != string::npos);
+    BOOST_CHECK_EQUAL(LOG.substr(LOG.size() - 5), "]}]}\n");
+}
+
+BOOST_AUTO_TEST_CASE(splice)
+{
+    auto const* AST = parse(SOURCE_CODE);
+    auto const* CONTRACT = fetch("A");
+    auto const& BODY = CONTRACT->definedFunctions()[0]->body();
+
+    SourceIndex index;
+
+    // Each fragment is formatted independently, as though by a worker.
+    ostringstream lhs_out;
+    SarifReporter lhs(lhs_out, index);
+    lhs.beginFragment(RULE);
+    lhs.report({ { CONTRACT, BODY.statements()[0].get() }, nullopt });
+    lhs.end();
+
+    ostringstream rhs_out;
+    SarifReporter rhs(rhs_out, index);
+    rhs.beginFragment(RULE);
+    rhs.report({ { CONTRACT, BODY.statements()[1].get() }, 3 });
+    rhs.end();
+
+    // Fragments carry no header or footer.
+    BOOST_CHECK_EQUAL(lhs_out.str().find("{\"ruleId\""), 0);
+    BOOST_CHECK_EQUAL(lhs.count(), 1);
+
+    ostringstream merged_out;
+    SarifReporter merged(merged_out, index);
+    merged.begin(RULE);
+    merged.splice(lhs_out.str(), lhs.count());
+    merged.splice("", 0);
+    merged.splice(rhs_out.str(), rhs.count());
+    merged.end();
+
+    ostringstream direct_out;
+    SarifReporter direct(direct_out, index);
+    direct.begin(RULE);
+    direct.report({ { CONTRACT, BODY.statements()[0].get() }, nullopt });
+    direct.report({ { CONTRACT, BODY.statements()[1].get() }, 3 });
+    direct.end();
+
+    BOOST_CHECK_EQUAL(merged_out.str(), direct_out.str());
+    BOOST_CHECK_EQUAL(merged.count(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(factory)
+{
+    ostringstream out;
+    SourceIndex index;
+    auto const TEXT = makeReporter("text", out, index);
+    auto const JSONL = makeReporter("jsonl", out, index);
+    auto const SARIF = makeReporter("sarif", out, index);
+    BOOST_CHECK(dynamic_cast<TextReporter*>(TEXT.get()));
+    BOOST_CHECK(dynamic_cast<JsonLinesReporter*>(JSONL.get()));
+    BOOST_CHECK(dynamic_cast<SarifReporter*>(SARIF.get()));
+    BOOST_CHECK(makeReporter("xml", out, index) == nullptr);
+}
+
+// -------------------------------------------------------------------------- //
+
+BOOST_AUTO_TEST_SUITE_END();
+
+}
+}
+}